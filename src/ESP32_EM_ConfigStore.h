@@ -0,0 +1,551 @@
+/****************************************************************************************************************************
+  ESP32_EM_ConfigStore.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// Persistent store for the Config Portal data: ETH_STA_IPConfig, TZ name and all ESP32_EMParameter values,
+// saved as one binary image protected by CRC32.
+// Two slots (A/B) are written alternately, each image carrying a sequence number. A save only overwrites
+// the older slot, so a power cut during the write leaves the previous image intact.
+// An image identical to the current one is not written again.
+//
+// Include after ESP32_W5500_Manager.h, then
+//
+//  ESP32_EM_FSConfigBackend  configBackend(LittleFS);       // or SPIFFS, FFat
+//  ESP32_EM_NVSConfigBackend configBackend;                 // or NVS, with Preferences
+//  ESP32_EM_ConfigStore      configStore(configBackend);
+//
+//  configStore.load(ESP32_W5500_manager);
+//  configStore.save(ESP32_W5500_manager);
+
+#pragma once
+
+#ifndef ESP32_EM_ConfigStore_H
+#define ESP32_EM_ConfigStore_H
+
+#include <FS.h>
+#include <Preferences.h>
+
+////////////////////////////////////////////////////
+
+// Largest image handled, header included
+#ifndef EM_CONFIG_STORE_MAX_SIZE
+  #define EM_CONFIG_STORE_MAX_SIZE      1024
+#endif
+
+#define EM_CONFIG_STORE_MAGIC           0x31434D45      // "EMC1"
+
+#define EM_CONFIG_STORE_SLOTS           2
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  uint32_t  magic;
+  uint32_t  sequence;
+  uint32_t  length;     // of the payload following the header
+  uint32_t  crc;        // CRC32 of payload, then sequence and length
+}  EM_ConfigHeader;
+
+////////////////////////////////////////////////////
+
+// CRC32 (IEEE 802.3), using a 16-entry table to keep flash use small
+inline uint32_t em_crc32Update(uint32_t crc, const uint8_t* data, size_t len)
+{
+  static const uint32_t crcTable[16] =
+  {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+  };
+
+  crc = ~crc;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    crc = crcTable[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+    crc = crcTable[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+  }
+
+  return ~crc;
+}
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+// Storage of the two slots. read() returns the bytes read, 0 if the slot is empty
+class ESP32_EM_ConfigBackend
+{
+  public:
+
+    virtual ~ESP32_EM_ConfigBackend() {}
+
+    virtual size_t  read(const uint8_t& slot, uint8_t* buffer, const size_t& maxLen) = 0;
+    virtual bool    write(const uint8_t& slot, const uint8_t* data, const size_t& len) = 0;
+};
+
+////////////////////////////////////////////////////
+
+// One file per slot, on LittleFS, SPIFFS or FFat
+class ESP32_EM_FSConfigBackend : public ESP32_EM_ConfigBackend
+{
+  public:
+
+    ESP32_EM_FSConfigBackend(fs::FS& fileSystem, const char* pathA = "/em_cfg_a.dat", const char* pathB = "/em_cfg_b.dat")
+      : _fs(fileSystem)
+    {
+      _path[0] = pathA;
+      _path[1] = pathB;
+    }
+
+    size_t read(const uint8_t& slot, uint8_t* buffer, const size_t& maxLen) override
+    {
+      if (!_fs.exists(_path[slot]))
+        return 0;
+
+      fs::File file = _fs.open(_path[slot], FILE_READ);
+
+      if (!file)
+        return 0;
+
+      size_t len = file.read(buffer, maxLen);
+
+      file.close();
+
+      return len;
+    }
+
+    bool write(const uint8_t& slot, const uint8_t* data, const size_t& len) override
+    {
+      fs::File file = _fs.open(_path[slot], FILE_WRITE);
+
+      if (!file)
+        return false;
+
+      size_t written = file.write(data, len);
+
+      file.close();
+
+      return (written == len);
+    }
+
+  private:
+
+    fs::FS&       _fs;
+    const char*   _path[EM_CONFIG_STORE_SLOTS];
+};
+
+////////////////////////////////////////////////////
+
+// One NVS blob per slot, in its own namespace
+class ESP32_EM_NVSConfigBackend : public ESP32_EM_ConfigBackend
+{
+  public:
+
+    ESP32_EM_NVSConfigBackend(const char* nameSpace = "em_cfg") : _nameSpace(nameSpace) {}
+
+    size_t read(const uint8_t& slot, uint8_t* buffer, const size_t& maxLen) override
+    {
+      if (!_prefs.begin(_nameSpace, true))
+        return 0;
+
+      size_t len = _prefs.getBytesLength(_key[slot]);
+
+      if ( (len > 0) && (len <= maxLen) )
+        len = _prefs.getBytes(_key[slot], buffer, len);
+      else
+        len = 0;
+
+      _prefs.end();
+
+      return len;
+    }
+
+    bool write(const uint8_t& slot, const uint8_t* data, const size_t& len) override
+    {
+      if (!_prefs.begin(_nameSpace, false))
+        return false;
+
+      size_t written = _prefs.putBytes(_key[slot], data, len);
+
+      _prefs.end();
+
+      return (written == len);
+    }
+
+  private:
+
+    const char*   _nameSpace;
+    const char*   _key[EM_CONFIG_STORE_SLOTS] = { "a", "b" };
+
+    Preferences   _prefs;
+};
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+class ESP32_EM_ConfigStore
+{
+  public:
+
+    ESP32_EM_ConfigStore(ESP32_EM_ConfigBackend& backend) : _backend(backend) {}
+
+    // Load the newest valid image. Params are matched by ID, those not in the image are left unchanged
+    bool load(ETH_STA_IPConfig& ipConfig, String& timezoneName, ESP32_EMParameter** params, const int& paramsCount)
+    {
+      uint8_t* buffer = (uint8_t*) em_malloc(EM_ALLOC_COLD, EM_CONFIG_STORE_MAX_SIZE);
+
+      if (buffer == NULL)
+        return false;
+
+      bool result = false;
+
+      scan(buffer);
+
+      if ( (_currentSlot >= 0) && (readSlot(_currentSlot, buffer) != NULL) )
+      {
+        result = decode(buffer + sizeof(EM_ConfigHeader), ((EM_ConfigHeader*) buffer)->length, ipConfig, timezoneName,
+                        params, paramsCount);
+
+        // Param values are written in place, so the pages rendered from them are out of date
+        em_pageGeneration()++;
+      }
+
+      em_free(buffer);
+
+      LOGINFO1(F("ConfigStore: load, slot ="), _currentSlot);
+
+      return result;
+    }
+
+    // Write the image to the older slot, unless identical to the current one
+    bool save(const ETH_STA_IPConfig& ipConfig, const char* timezoneName, ESP32_EMParameter** params, const int& paramsCount)
+    {
+      uint8_t* buffer = (uint8_t*) em_malloc(EM_ALLOC_COLD, EM_CONFIG_STORE_MAX_SIZE);
+
+      if (buffer == NULL)
+        return false;
+
+      if (!_scanned)
+        scan(buffer);
+
+      size_t length = encode(buffer + sizeof(EM_ConfigHeader), EM_CONFIG_STORE_MAX_SIZE - sizeof(EM_ConfigHeader),
+                             ipConfig, timezoneName, params, paramsCount);
+
+      if (length == 0)
+      {
+        LOGERROR(F("ConfigStore: image larger than EM_CONFIG_STORE_MAX_SIZE"));
+
+        em_free(buffer);
+
+        return false;
+      }
+
+      uint32_t payloadCRC = em_crc32Update(0, buffer + sizeof(EM_ConfigHeader), length);
+
+      if ( (_currentSlot >= 0) && (payloadCRC == _payloadCRC) && (length == _payloadLength) )
+      {
+        LOGINFO(F("ConfigStore: unchanged, not written"));
+
+        em_free(buffer);
+
+        return true;
+      }
+
+      uint8_t slot = (_currentSlot == 0) ? 1 : 0;
+
+      EM_ConfigHeader* header = (EM_ConfigHeader*) buffer;
+
+      header->magic     = EM_CONFIG_STORE_MAGIC;
+      header->sequence  = _sequence + 1;
+      header->length    = length;
+      header->crc       = imageCRC(payloadCRC, header);
+
+      bool result = _backend.write(slot, buffer, sizeof(EM_ConfigHeader) + length);
+
+      if (result)
+      {
+        _currentSlot    = slot;
+        _sequence       = header->sequence;
+        _payloadCRC     = payloadCRC;
+        _payloadLength  = length;
+      }
+
+      LOGINFO3(F("ConfigStore: save, slot ="), slot, F(", OK ="), result);
+
+      em_free(buffer);
+
+      return result;
+    }
+
+    ///////////////////////////
+
+    bool load(ESP32_W5500_Manager& manager)
+    {
+      ETH_STA_IPConfig  ipConfig;
+      String            timezoneName;
+
+      manager.getSTAStaticIPConfig(ipConfig);
+
+      if (!load(ipConfig, timezoneName, manager.getParameters(), manager.getParametersCount()))
+        return false;
+
+      manager.setSTAStaticIPConfig(ipConfig);
+#if USE_ESP_ETH_MANAGER_NTP
+      manager.setTimezoneName(timezoneName);
+#endif
+
+      return true;
+    }
+
+    bool save(ESP32_W5500_Manager& manager)
+    {
+      ETH_STA_IPConfig ipConfig;
+
+      manager.getSTAStaticIPConfig(ipConfig);
+
+#if USE_ESP_ETH_MANAGER_NTP
+      return save(ipConfig, manager.getTimezoneName().c_str(), manager.getParameters(), manager.getParametersCount());
+#else
+      return save(ipConfig, "", manager.getParameters(), manager.getParametersCount());
+#endif
+    }
+
+    ///////////////////////////
+
+    // Slot holding the current image, -1 if none
+    inline int getCurrentSlot()
+    {
+      return _currentSlot;
+    }
+
+    inline uint32_t getSequence()
+    {
+      return _sequence;
+    }
+
+  private:
+
+    ESP32_EM_ConfigBackend&   _backend;
+
+    bool      _scanned        = false;
+    int       _currentSlot    = -1;
+    uint32_t  _sequence       = 0;
+    uint32_t  _payloadCRC     = 0;
+    uint32_t  _payloadLength  = 0;
+
+    ///////////////////////////
+
+    static uint32_t imageCRC(const uint32_t& payloadCRC, const EM_ConfigHeader* header)
+    {
+      uint32_t crc = em_crc32Update(payloadCRC, (const uint8_t*) &header->sequence, sizeof(header->sequence));
+
+      return em_crc32Update(crc, (const uint8_t*) &header->length, sizeof(header->length));
+    }
+
+    // Read and check the image of slot. Returns its header, NULL if the slot is empty or corrupted
+    EM_ConfigHeader* readSlot(const uint8_t& slot, uint8_t* buffer)
+    {
+      size_t len = _backend.read(slot, buffer, EM_CONFIG_STORE_MAX_SIZE);
+
+      EM_ConfigHeader* header = (EM_ConfigHeader*) buffer;
+
+      if ( (len < sizeof(EM_ConfigHeader)) || (header->magic != EM_CONFIG_STORE_MAGIC)
+           || (header->length != len - sizeof(EM_ConfigHeader)) )
+      {
+        return NULL;
+      }
+
+      uint32_t payloadCRC = em_crc32Update(0, buffer + sizeof(EM_ConfigHeader), header->length);
+
+      if (imageCRC(payloadCRC, header) != header->crc)
+      {
+        LOGWARN1(F("ConfigStore: CRC error, slot ="), slot);
+
+        return NULL;
+      }
+
+      return header;
+    }
+
+    // Find the slot with the newest valid image
+    void scan(uint8_t* buffer)
+    {
+      _scanned      = true;
+      _currentSlot  = -1;
+
+      for (uint8_t slot = 0; slot < EM_CONFIG_STORE_SLOTS; slot++)
+      {
+        EM_ConfigHeader* header = readSlot(slot, buffer);
+
+        // Sequence compared with wrap-around
+        if ( (header != NULL) && ( (_currentSlot < 0) || ((int32_t) (header->sequence - _sequence) > 0) ) )
+        {
+          _currentSlot    = slot;
+          _sequence       = header->sequence;
+          _payloadLength  = header->length;
+          _payloadCRC     = em_crc32Update(0, buffer + sizeof(EM_ConfigHeader), header->length);
+        }
+      }
+    }
+
+    ///////////////////////////
+
+    // Payload: IPs, then length-prefixed TZ name, then count and length-prefixed ID / value of each param
+    static uint8_t* putString(uint8_t* pos, const uint8_t* end, const char* str, const size_t& maxLen)
+    {
+      size_t len = (str == NULL) ? 0 : strnlen(str, maxLen);
+
+      if ( (pos == NULL) || (pos + 1 + len > end) )
+        return NULL;
+
+      *pos++ = len;
+      memcpy(pos, str, len);
+
+      return pos + len;
+    }
+
+    static size_t encode(uint8_t* payload, const size_t& maxLen, const ETH_STA_IPConfig& ipConfig, const char* timezoneName,
+                         ESP32_EMParameter** params, const int& paramsCount)
+    {
+      uint8_t* pos        = payload;
+      const uint8_t* end  = payload + maxLen;
+
+      const IPAddress* ips[] = { &ipConfig._sta_static_ip, &ipConfig._sta_static_gw, &ipConfig._sta_static_sn,
+                                 &ipConfig._sta_static_dns1, &ipConfig._sta_static_dns2
+                               };
+
+      if (pos + sizeof(ips) / sizeof(ips[0]) * 4 + 1 > end)
+        return 0;
+
+      for (const IPAddress* ip : ips)
+      {
+        for (int i = 0; i < 4; i++)
+          *pos++ = (*ip)[i];
+      }
+
+      pos = putString(pos, end, timezoneName, 255);
+
+      if ( (pos == NULL) || (pos >= end) )
+        return 0;
+
+      uint8_t* countPos = pos++;
+      uint8_t  count    = 0;
+
+      for (int i = 0; (i < paramsCount) && (count < 255); i++)
+      {
+        // Custom HTML-only params have no value
+        if ( (params[i] == NULL) || (params[i]->getID() == NULL) || (params[i]->getValue() == NULL) )
+          continue;
+
+        pos = putString(pos, end, params[i]->getID(), 255);
+        pos = putString(pos, end, params[i]->getValue(), 255);
+
+        if (pos == NULL)
+          return 0;
+
+        count++;
+      }
+
+      *countPos = count;
+
+      return pos - payload;
+    }
+
+    static bool decode(const uint8_t* payload, const size_t& len, ETH_STA_IPConfig& ipConfig, String& timezoneName,
+                       ESP32_EMParameter** params, const int& paramsCount)
+    {
+      const uint8_t* pos  = payload;
+      const uint8_t* end  = payload + len;
+
+      IPAddress* ips[] = { &ipConfig._sta_static_ip, &ipConfig._sta_static_gw, &ipConfig._sta_static_sn,
+                           &ipConfig._sta_static_dns1, &ipConfig._sta_static_dns2
+                         };
+
+      if (pos + sizeof(ips) / sizeof(ips[0]) * 4 + 1 > end)
+        return false;
+
+      for (IPAddress* ip : ips)
+      {
+        *ip = IPAddress(pos[0], pos[1], pos[2], pos[3]);
+        pos += 4;
+      }
+
+      uint8_t tzLen = *pos++;
+
+      if (pos + tzLen + 1 > end)
+        return false;
+
+      char tzName[256];
+
+      memcpy(tzName, pos, tzLen);
+      tzName[tzLen] = 0;
+
+      timezoneName = tzName;
+      pos += tzLen;
+
+      uint8_t count = *pos++;
+
+      for (uint8_t n = 0; n < count; n++)
+      {
+        if (pos >= end)
+          return false;
+
+        const uint8_t* id   = pos + 1;
+        uint8_t        idLen = *pos;
+
+        pos = id + idLen;
+
+        if (pos >= end)
+          return false;
+
+        const uint8_t* value    = pos + 1;
+        uint8_t        valueLen = *pos;
+
+        pos = value + valueLen;
+
+        if (pos > end)
+          return false;
+
+        for (int i = 0; i < paramsCount; i++)
+        {
+          if ( (params[i] == NULL) || (params[i]->getID() == NULL) || (params[i]->getValue() == NULL) )
+            continue;
+
+          if ( (strncmp(params[i]->getID(), (const char*) id, idLen) != 0) || (params[i]->getID()[idLen] != 0) )
+            continue;
+
+          // The value buffer holds getValueLength() chars plus the terminating 0
+          char*   dest    = (char*) params[i]->getValue();
+          size_t  copyLen = std::min((size_t) valueLen, (size_t) params[i]->getValueLength());
+
+          memcpy(dest, value, copyLen);
+          dest[copyLen] = 0;
+
+          break;
+        }
+      }
+
+      return true;
+    }
+};
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_EM_ConfigStore_H
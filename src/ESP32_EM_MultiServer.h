@@ -0,0 +1,1091 @@
+/****************************************************************************************************************************
+  ESP32_EM_MultiServer.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// Config Portal server multiplexing several clients, selected by USE_EM_MULTI_SERVER.
+//
+// WebServer serves one client at a time: it waits for the whole request, then writes the whole response,
+// so a slow or idle client (e.g. a captive probe keeping its connection alive) holds up everyone else.
+// ESP32_EMMultiServer keeps a pool of EM_MULTI_SERVER_CLIENTS non-blocking connections, each with its own
+// request buffer, parse state and output buffer. Each handleClient() accepts new connections, reads what
+// has arrived on each of them, runs the handler of any complete request, and sends what each socket
+// can take without blocking. Handlers run one at a time, as with WebServer.
+//
+// HTTP/1.1 keep-alive is supported. An idle keep-alive connection is closed to make room when the pool
+// is full, and any connection is closed after EM_MULTI_SERVER_TIMEOUT ms without progress.
+//
+// Only the WebServer API used by ESP32_W5500_Manager is implemented, plus the ESP32_EMWebServer
+// extensions (argNameRef(), argRef(), hostHeaderRef(), sendHeaderBlock(), and the response metrics).
+
+#pragma once
+
+#ifndef ESP32_EM_MultiServer_H
+#define ESP32_EM_MultiServer_H
+
+#include <functional>
+
+#include <lwip/sockets.h>
+
+#include <Arduino.h>
+#include <WebServer.h>        // HTTPMethod, CONTENT_LENGTH_UNKNOWN and CONTENT_LENGTH_NOT_SET
+
+#include "ESP32_W5500_Manager_Alloc.h"
+
+////////////////////////////////////////////////////
+
+// Simultaneous connections. Each uses a socket, out of CONFIG_LWIP_MAX_SOCKETS
+#ifndef EM_MULTI_SERVER_CLIENTS
+  #define EM_MULTI_SERVER_CLIENTS         4
+#endif
+
+// Request line, headers and body of one request. Larger requests get a 413
+#ifndef EM_MULTI_SERVER_REQUEST_SIZE
+  #define EM_MULTI_SERVER_REQUEST_SIZE    2048
+#endif
+
+// Query and form arguments of one request. Extra ones are ignored
+#ifndef EM_MULTI_SERVER_MAX_ARGS
+  #define EM_MULTI_SERVER_MAX_ARGS        48
+#endif
+
+#ifndef EM_MULTI_SERVER_MAX_HEADERS
+  #define EM_MULTI_SERVER_MAX_HEADERS     4
+#endif
+
+#ifndef EM_MULTI_SERVER_MAX_ROUTES
+  #define EM_MULTI_SERVER_MAX_ROUTES      24
+#endif
+
+// ms without progress before a connection is closed: request not complete, response not taken, or idle
+#ifndef EM_MULTI_SERVER_TIMEOUT
+  #define EM_MULTI_SERVER_TIMEOUT         5000
+#endif
+
+// Pending output sent while the handler is still writing, so that a page isn't buffered as a whole
+#ifndef EM_MULTI_SERVER_FLUSH_SIZE
+  #define EM_MULTI_SERVER_FLUSH_SIZE      1460
+#endif
+
+// Output buffer kept by a connection between responses. Larger ones are freed once sent
+#ifndef EM_MULTI_SERVER_OUTPUT_KEEP
+  #define EM_MULTI_SERVER_OUTPUT_KEEP     2048
+#endif
+
+////////////////////////////////////////////////////
+
+class ESP32_EMMultiServer
+{
+  public:
+
+    typedef std::function<void(void)> THandlerFunction;
+
+    ESP32_EMMultiServer(int port = 80) : _port(port)
+    {
+      memset(_connections, 0, sizeof(_connections));
+
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        _connections[i].fd = -1;
+      }
+    }
+
+    ~ESP32_EMMultiServer()
+    {
+      stop();
+    }
+
+    ///////////////////////////
+
+    void begin()
+    {
+      struct sockaddr_in addr;
+
+      memset(&addr, 0, sizeof(addr));
+
+      addr.sin_family       = AF_INET;
+      addr.sin_port         = htons(_port);
+      addr.sin_addr.s_addr  = htonl(INADDR_ANY);
+
+      int reuse = 1;
+
+      _listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+      if ( (_listenFd < 0) || (::setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) ||
+           (::bind(_listenFd, (struct sockaddr *) &addr, sizeof(addr)) < 0) || (::listen(_listenFd, EM_MULTI_SERVER_CLIENTS) < 0) )
+      {
+        LOGERROR1(F("MultiServer: can't listen, errno ="), errno);
+
+        stop();
+
+        return;
+      }
+
+      setNonBlocking(_listenFd);
+
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        if (_connections[i].request == NULL)
+          _connections[i].request = (char *) em_malloc(EM_ALLOC_LARGE, EM_MULTI_SERVER_REQUEST_SIZE + 1);
+      }
+
+      LOGINFO1(F("MultiServer: listening, port ="), _port);
+    }
+
+    ///////////////////////////
+
+    void stop()
+    {
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        closeConnection(_connections[i]);
+
+        em_free(_connections[i].request);
+        em_free(_connections[i].output);
+
+        _connections[i].request   = NULL;
+        _connections[i].output    = NULL;
+        _connections[i].outputCap = 0;
+      }
+
+      if (_listenFd >= 0)
+      {
+        ::close(_listenFd);
+        _listenFd = -1;
+      }
+    }
+
+    ///////////////////////////
+
+    // Never blocks: read, handle and send whatever is ready on each connection, then accept new ones
+    void handleClient()
+    {
+      if (_listenFd < 0)
+        return;
+
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        Connection& conn = _connections[i];
+
+        if (conn.state == EM_CONN_READING)
+          readRequest(conn);
+
+        if (conn.state == EM_CONN_WRITING)
+          flush(conn);
+
+        if ( (conn.state != EM_CONN_FREE) && (millis() - conn.lastActivity > EM_MULTI_SERVER_TIMEOUT) )
+        {
+          LOGDEBUG1(F("MultiServer: timeout, state ="), conn.state);
+
+          closeConnection(conn);
+        }
+      }
+
+      // After the reads, so that only connections with nothing pending count as idle
+      acceptConnections();
+    }
+
+    ///////////////////////////
+
+    void on(const String& uri, THandlerFunction handler)
+    {
+      if (_routeCount == EM_MULTI_SERVER_MAX_ROUTES)
+      {
+        LOGERROR1(F("MultiServer: too many routes, not added:"), uri);
+
+        return;
+      }
+
+      _routeUris[_routeCount]     = uri;
+      _routeHandlers[_routeCount] = handler;
+      _routeCount++;
+    }
+
+    void onNotFound(THandlerFunction handler)
+    {
+      _notFoundHandler = handler;
+    }
+
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount)
+    {
+      _headerKeysCount = (headerKeysCount < EM_MULTI_SERVER_MAX_HEADERS) ? headerKeysCount : EM_MULTI_SERVER_MAX_HEADERS;
+
+      for (int i = 0; i < _headerKeysCount; i++)
+      {
+        _headerKeys[i] = headerKeys[i];
+      }
+    }
+
+    ///////////////////////////
+    // The request being handled
+
+    inline String uri()
+    {
+      return _uri;
+    }
+
+    inline HTTPMethod method()
+    {
+      return _method;
+    }
+
+    inline int args()
+    {
+      return _argCount;
+    }
+
+    inline String arg(int i)
+    {
+      return (i < _argCount) ? _argValues[i] : String();
+    }
+
+    inline String argName(int i)
+    {
+      return (i < _argCount) ? _argNames[i] : String();
+    }
+
+    String arg(const String& name)
+    {
+      for (int i = 0; i < _argCount; i++)
+      {
+        if (_argNames[i] == name)
+          return _argValues[i];
+      }
+
+      return String();
+    }
+
+    bool hasArg(const String& name)
+    {
+      for (int i = 0; i < _argCount; i++)
+      {
+        if (_argNames[i] == name)
+          return true;
+      }
+
+      return false;
+    }
+
+    inline const String& argNameRef(const int& i)
+    {
+      return _argNames[i];
+    }
+
+    inline const String& argRef(const int& i)
+    {
+      return _argValues[i];
+    }
+
+    inline const String& hostHeaderRef()
+    {
+      return _hostHeader;
+    }
+
+    // Of the headers registered with collectHeaders()
+    String header(const String& name)
+    {
+      for (int i = 0; i < _headerKeysCount; i++)
+      {
+        if (_headerKeys[i].equalsIgnoreCase(name))
+          return _headerValues[i];
+      }
+
+      return String();
+    }
+
+    bool hasHeader(const String& name)
+    {
+      return (header(name).length() > 0);
+    }
+
+    // Local address of the current connection, as used by the client
+    IPAddress localIP()
+    {
+      struct sockaddr_in addr;
+      socklen_t          len = sizeof(addr);
+
+      if ( (_current == NULL) || (::getsockname(_current->fd, (struct sockaddr *) &addr, &len) < 0) )
+        return IPAddress();
+
+      return IPAddress((uint32_t) addr.sin_addr.s_addr);
+    }
+
+    ///////////////////////////
+    // The response to the request being handled
+
+    inline void setContentLength(const size_t& contentLength)
+    {
+      _contentLength = contentLength;
+    }
+
+    void sendHeader(const String& name, const String& value, bool first = false)
+    {
+      (void) first;
+
+      _responseHeaders += name;
+      _responseHeaders += F(": ");
+      _responseHeaders += value;
+      _responseHeaders += F("\r\n");
+    }
+
+    // Append ready-made "Name: value\r\n" lines to the response headers, with no temporary Strings
+    inline void sendHeaderBlock(const char* block)
+    {
+      _responseHeaders += block;
+    }
+
+    void send(int code, const char* content_type = NULL, const String& content = String(""))
+    {
+      countResponse(code, 0);
+      sendHead(code, content_type, content.length());
+
+      if (content.length() > 0)
+        sendContent(content.c_str(), content.length());
+    }
+
+    void send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength)
+    {
+      countResponse(code, 0);
+      sendHead(code, content_type, contentLength);
+      sendContent(content, contentLength);
+    }
+
+    void sendContent(const String& content)
+    {
+      sendContent(content.c_str(), content.length());
+    }
+
+    // A zero length terminates a chunked body
+    void sendContent(const char* content, size_t contentLength)
+    {
+      if ( (_current == NULL) || _headOnly )
+        return;
+
+      _responseLength += contentLength;
+
+      if (!_chunked)
+      {
+        append(*_current, content, contentLength);
+
+        return;
+      }
+
+      char size[12];
+
+      append(*_current, size, snprintf(size, sizeof(size), "%X\r\n", (unsigned int) contentLength));
+      append(*_current, content, contentLength);
+      append(*_current, "\r\n", 2);
+
+      if (contentLength == 0)
+        _chunked = false;
+    }
+
+    // A complete response, status line and headers included. The connection is closed once it's sent
+    void sendRawResponse(const uint8_t* data, const size_t& len)
+    {
+      if (_current == NULL)
+        return;
+
+      append(*_current, (const char *) data, len);
+
+      _current->keepAlive = false;
+      _headSent           = true;
+    }
+
+    ///////////////////////////
+    // Status and body bytes of the current response, for the route metrics
+
+    inline void countResponse(const int& code, const size_t& len)
+    {
+      _responseCode    = code;
+      _responseLength += len;
+    }
+
+    inline void resetResponse()
+    {
+      _responseCode   = 0;
+      _responseLength = 0;
+    }
+
+    inline int getResponseCode()
+    {
+      return _responseCode;
+    }
+
+    inline size_t getResponseLength()
+    {
+      return _responseLength;
+    }
+
+    ///////////////////////////
+
+    uint8_t getConnectionCount()
+    {
+      uint8_t count = 0;
+
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        if (_connections[i].state != EM_CONN_FREE)
+          count++;
+      }
+
+      return count;
+    }
+
+  private:
+
+    typedef enum
+    {
+      EM_CONN_FREE = 0,
+      EM_CONN_READING,          // Waiting for a complete request, or idle between keep-alive requests
+      EM_CONN_WRITING           // Response complete, sending what is left of it
+    } EM_ConnState;
+
+    typedef struct
+    {
+      int           fd;
+      EM_ConnState  state;
+      uint32_t      lastActivity;
+      bool          keepAlive;
+
+      char*         request;
+      size_t        requestLen;
+      size_t        headerLen;      // 0 until the end of the headers is found
+      size_t        contentLength;
+
+      char*         output;
+      size_t        outputLen;
+      size_t        outputSent;
+      size_t        outputCap;
+    } Connection;
+
+    ///////////////////////////
+
+    static void setNonBlocking(const int& fd)
+    {
+      ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    ///////////////////////////
+
+    Connection* freeConnection(const bool& evictIdle)
+    {
+      Connection* idle = NULL;
+
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        Connection& conn = _connections[i];
+
+        if (conn.state == EM_CONN_FREE)
+          return &conn;
+
+        if ( isIdle(conn) && ( (idle == NULL) || ((int32_t) (conn.lastActivity - idle->lastActivity) < 0) ) )
+        {
+          idle = &conn;
+        }
+      }
+
+      if (evictIdle && idle)
+      {
+        LOGDEBUG(F("MultiServer: closing idle connection for a new one"));
+
+        closeConnection(*idle);
+
+        return idle;
+      }
+
+      return NULL;
+    }
+
+    ///////////////////////////
+
+    // When the pool is full, connections wait in the listen backlog, unless an idle one can be closed
+    void acceptConnections()
+    {
+      while (true)
+      {
+        Connection* conn = freeConnection(false);
+
+        if ( (conn == NULL) && !hasIdleConnection() )
+          return;
+
+        int fd = ::accept(_listenFd, NULL, NULL);
+
+        if (fd < 0)
+          return;
+
+        if (conn == NULL)
+          conn = freeConnection(true);
+
+        if (conn->request == NULL)
+        {
+          ::close(fd);
+
+          return;
+        }
+
+        int noDelay = 1;
+
+        setNonBlocking(fd);
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        conn->fd            = fd;
+        conn->state         = EM_CONN_READING;
+        conn->lastActivity  = millis();
+        conn->keepAlive     = false;
+
+        resetRequest(*conn);
+
+        LOGDEBUG1(F("MultiServer: new connection, fd ="), fd);
+      }
+    }
+
+    bool hasIdleConnection()
+    {
+      for (int i = 0; i < EM_MULTI_SERVER_CLIENTS; i++)
+      {
+        if (isIdle(_connections[i]))
+          return true;
+      }
+
+      return false;
+    }
+
+    // Keep-alive connection between requests. keepAlive is only set by a request, so that a connection just
+    // accepted, with its first request still on the way, isn't taken for an idle one
+    static bool isIdle(const Connection& conn)
+    {
+      return (conn.state == EM_CONN_READING) && conn.keepAlive && (conn.requestLen == 0);
+    }
+
+    ///////////////////////////
+
+    void closeConnection(Connection& conn)
+    {
+      if (conn.fd >= 0)
+        ::close(conn.fd);
+
+      conn.fd         = -1;
+      conn.state      = EM_CONN_FREE;
+      conn.outputLen  = 0;
+      conn.outputSent = 0;
+
+      resetRequest(conn);
+    }
+
+    static void resetRequest(Connection& conn)
+    {
+      conn.requestLen     = 0;
+      conn.headerLen      = 0;
+      conn.contentLength  = 0;
+    }
+
+    ///////////////////////////
+
+    void readRequest(Connection& conn)
+    {
+      while (conn.requestLen < EM_MULTI_SERVER_REQUEST_SIZE)
+      {
+        int len = ::recv(conn.fd, conn.request + conn.requestLen, EM_MULTI_SERVER_REQUEST_SIZE - conn.requestLen, MSG_DONTWAIT);
+
+        if (len == 0)
+        {
+          closeConnection(conn);
+
+          return;
+        }
+
+        if (len < 0)
+        {
+          if ( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+            break;
+
+          closeConnection(conn);
+
+          return;
+        }
+
+        conn.requestLen  += len;
+        conn.lastActivity = millis();
+      }
+
+      // Also bytes left from a pipelined request
+      if (conn.requestLen == 0)
+        return;
+
+      conn.request[conn.requestLen] = 0;
+
+      if (conn.headerLen == 0)
+      {
+        char* end = strstr(conn.request, "\r\n\r\n");
+
+        if (end)
+        {
+          conn.headerLen      = end + 4 - conn.request;
+          conn.contentLength  = parseContentLength(conn.request, conn.headerLen);
+
+          // A body which can't fit is refused now, rather than waited for. This also keeps
+          // headerLen + contentLength from wrapping around
+          if (conn.contentLength > EM_MULTI_SERVER_REQUEST_SIZE - conn.headerLen)
+          {
+            sendTooLarge(conn);
+
+            return;
+          }
+        }
+      }
+
+      if ( (conn.headerLen > 0) && (conn.requestLen >= conn.headerLen + conn.contentLength) )
+      {
+        handleRequest(conn);
+      }
+      else if (conn.requestLen == EM_MULTI_SERVER_REQUEST_SIZE)
+      {
+        sendTooLarge(conn);
+      }
+    }
+
+    void sendTooLarge(Connection& conn)
+    {
+      LOGWARN(F("MultiServer: request too large"));
+
+      static const char tooLarge[] = "HTTP/1.1 413 Payload Too Large\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+      append(conn, tooLarge, sizeof(tooLarge) - 1);
+
+      conn.keepAlive  = false;
+      conn.state      = EM_CONN_WRITING;
+    }
+
+    ///////////////////////////
+
+    static size_t parseContentLength(const char* headers, const size_t& len)
+    {
+      for (const char* line = strstr(headers, "\r\n"); line && (line < headers + len); line = strstr(line + 2, "\r\n"))
+      {
+        if (strncasecmp(line + 2, "Content-Length:", 15) == 0)
+          return strtoul(line + 17, NULL, 10);
+      }
+
+      return 0;
+    }
+
+    ///////////////////////////
+
+    // Decode %XX and '+' in place, and terminate the result
+    static void urlDecode(char* str, const char* end)
+    {
+      char* out = str;
+
+      while (str < end)
+      {
+        if ( (*str == '%') && (str + 2 < end) && isxdigit(str[1]) && isxdigit(str[2]) )
+        {
+          char hex[3] = { str[1], str[2], 0 };
+
+          *out++  = (char) strtoul(hex, NULL, 16);
+          str    += 3;
+        }
+        else
+        {
+          *out++ = (*str == '+') ? ' ' : *str;
+          str++;
+        }
+      }
+
+      *out = 0;
+    }
+
+    void parseArgs(char* str, char* end)
+    {
+      while ( (str < end) && (_argCount < EM_MULTI_SERVER_MAX_ARGS) )
+      {
+        char* next  = (char *) memchr(str, '&', end - str);
+        char* last  = next ? next : end;
+        char* equal = (char *) memchr(str, '=', last - str);
+
+        if (last > str)
+        {
+          char* valueStart = equal ? (equal + 1) : last;
+
+          urlDecode(valueStart, last);
+          urlDecode(str, equal ? equal : last);
+
+          _argNames[_argCount]  = str;
+          _argValues[_argCount] = equal ? valueStart : "";
+          _argCount++;
+        }
+
+        str = last + 1;
+      }
+    }
+
+    ///////////////////////////
+
+    static HTTPMethod parseMethod(const char* method)
+    {
+      static const struct
+      {
+        const char* name;
+        HTTPMethod  method;
+      } methods[] = { { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "HEAD", HTTP_HEAD }, { "PUT", HTTP_PUT },
+        { "DELETE", HTTP_DELETE }, { "OPTIONS", HTTP_OPTIONS }, { "PATCH", HTTP_PATCH }
+      };
+
+      for (const auto& m : methods)
+      {
+        if (strcmp(method, m.name) == 0)
+          return m.method;
+      }
+
+      return HTTP_ANY;
+    }
+
+    ///////////////////////////
+
+    // Parse the complete request in conn.request, in place, and run its handler
+    void handleRequest(Connection& conn)
+    {
+      char* request = conn.request;
+      char* body    = request + conn.headerLen;
+      char* lineEnd = strstr(request, "\r\n");
+
+      *lineEnd = 0;
+
+      // "METHOD target HTTP/1.x"
+      char* target  = strchr(request, ' ');
+      char* version = target ? strchr(target + 1, ' ') : NULL;
+
+      _argCount   = 0;
+      _hostHeader = "";
+
+      for (int i = 0; i < _headerKeysCount; i++)
+      {
+        _headerValues[i] = "";
+      }
+
+      if (version == NULL)
+      {
+        static const char badRequest[] = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+        append(conn, badRequest, sizeof(badRequest) - 1);
+
+        conn.keepAlive  = false;
+        conn.state      = EM_CONN_WRITING;
+
+        return;
+      }
+
+      *target++   = 0;
+      *version++  = 0;
+
+      _method     = parseMethod(request);
+      _http11     = (strcmp(version, "HTTP/1.1") == 0);
+      _headOnly   = (_method == HTTP_HEAD);
+
+      conn.keepAlive = _http11;
+
+      bool  form  = false;
+      char* query = strchr(target, '?');
+
+      if (query)
+        *query++ = 0;
+
+      _uri = target;
+
+      // Headers, up to the empty line
+      for (char* line = lineEnd + 2; line < body - 2; )
+      {
+        char* end   = strstr(line, "\r\n");
+        char* colon = (char *) memchr(line, ':', end - line);
+
+        *end = 0;
+
+        if (colon)
+        {
+          char* value = colon + 1;
+
+          *colon = 0;
+
+          while (*value == ' ')
+            value++;
+
+          if (strcasecmp(line, "Host") == 0)
+            _hostHeader = value;
+          else if (strcasecmp(line, "Connection") == 0)
+            conn.keepAlive = (strcasecmp(value, "close") != 0) && (_http11 || (strcasecmp(value, "keep-alive") == 0));
+          else if (strcasecmp(line, "Content-Type") == 0)
+            form = (strncasecmp(value, "application/x-www-form-urlencoded", 33) == 0);
+
+          for (int i = 0; i < _headerKeysCount; i++)
+          {
+            if (_headerKeys[i].equalsIgnoreCase(line))
+              _headerValues[i] = value;
+          }
+        }
+
+        line = end + 2;
+      }
+
+      if (query)
+        parseArgs(query, query + strlen(query));
+
+      char saved = body[conn.contentLength];
+
+      if (form)
+        parseArgs(body, body + conn.contentLength);
+
+      // Request for the handler
+      _current        = &conn;
+      _headSent       = false;
+      _chunked        = false;
+      _contentLength  = CONTENT_LENGTH_NOT_SET;
+      _responseHeaders = "";
+
+      THandlerFunction* handler = &_notFoundHandler;
+
+      for (int i = 0; i < _routeCount; i++)
+      {
+        if (_uri == _routeUris[i])
+        {
+          handler = &_routeHandlers[i];
+          break;
+        }
+      }
+
+      if (*handler)
+      {
+        (*handler)();
+      }
+      else
+      {
+        send(404, "text/plain", "Not found");
+      }
+
+      if (!_headSent)
+        send(500, "text/plain", "No response");
+
+      // Unterminated chunked body
+      if (_chunked)
+        sendContent("", 0);
+
+      _current = NULL;
+
+      // Keep a pipelined request for the next round
+      size_t used = conn.headerLen + conn.contentLength;
+
+      body[conn.contentLength] = saved;
+
+      memmove(conn.request, conn.request + used, conn.requestLen - used);
+
+      conn.requestLen    -= used;
+      conn.headerLen      = 0;
+      conn.contentLength  = 0;
+      conn.state          = EM_CONN_WRITING;
+
+      flush(conn);
+    }
+
+    ///////////////////////////
+
+    static const char* reasonPhrase(const int& code)
+    {
+      switch (code)
+      {
+        case 200: return "OK";
+        case 204: return "No Content";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        case 500: return "Internal Server Error";
+        default:  return "";
+      }
+    }
+
+    // Status line and headers. A body of unknown length is chunked, or ends the connection for HTTP/1.0
+    void sendHead(const int& code, const char* contentType, const size_t& contentLength)
+    {
+      if (_current == NULL)
+        return;
+
+      char    line[64];
+      size_t  length = (_contentLength == CONTENT_LENGTH_NOT_SET) ? contentLength : _contentLength;
+
+      append(*_current, line, snprintf(line, sizeof(line), "HTTP/1.1 %d %s\r\nContent-Type: ", code, reasonPhrase(code)));
+
+      const char* type = contentType ? contentType : "text/html";
+
+      append(*_current, type, strlen(type));
+
+      if (length == CONTENT_LENGTH_UNKNOWN)
+      {
+        if (_http11)
+        {
+          static const char chunked[] = "\r\nTransfer-Encoding: chunked";
+
+          append(*_current, chunked, sizeof(chunked) - 1);
+
+          _chunked = true;
+        }
+        else
+        {
+          _current->keepAlive = false;
+        }
+      }
+      else
+      {
+        append(*_current, line, snprintf(line, sizeof(line), "\r\nContent-Length: %u", (unsigned int) length));
+      }
+
+      const char* connection = _current->keepAlive ? "\r\nConnection: keep-alive\r\n" : "\r\nConnection: close\r\n";
+
+      append(*_current, connection, strlen(connection));
+      append(*_current, _responseHeaders.c_str(), _responseHeaders.length());
+      append(*_current, "\r\n", 2);
+
+      _responseHeaders  = "";
+      _contentLength    = CONTENT_LENGTH_NOT_SET;
+      _headSent         = true;
+    }
+
+    ///////////////////////////
+
+    void append(Connection& conn, const char* data, const size_t& len)
+    {
+      if ( (len == 0) || (conn.fd < 0) )
+        return;
+
+      if (conn.outputLen + len > conn.outputCap)
+      {
+        size_t capacity = conn.outputCap ? conn.outputCap : EM_MULTI_SERVER_FLUSH_SIZE;
+
+        while (capacity < conn.outputLen + len)
+          capacity *= 2;
+
+        char* output = (char *) em_realloc(EM_ALLOC_LARGE, conn.output, capacity);
+
+        if (output == NULL)
+        {
+          LOGERROR1(F("MultiServer: no memory for output, size ="), capacity);
+
+          // Rather than a truncated response
+          closeConnection(conn);
+
+          return;
+        }
+
+        conn.output     = output;
+        conn.outputCap  = capacity;
+      }
+
+      memcpy(conn.output + conn.outputLen, data, len);
+
+      conn.outputLen += len;
+
+      if (conn.outputLen - conn.outputSent >= EM_MULTI_SERVER_FLUSH_SIZE)
+        flush(conn);
+    }
+
+    ///////////////////////////
+
+    // Send what the socket takes without blocking. Once a complete response is sent, wait for the next
+    // request, or close
+    void flush(Connection& conn)
+    {
+      while (conn.outputSent < conn.outputLen)
+      {
+        int len = ::send(conn.fd, conn.output + conn.outputSent, conn.outputLen - conn.outputSent, MSG_DONTWAIT);
+
+        if (len < 0)
+        {
+          if ( (errno == EAGAIN) || (errno == EWOULDBLOCK) )
+            return;
+
+          closeConnection(conn);
+
+          return;
+        }
+
+        conn.outputSent  += len;
+        conn.lastActivity = millis();
+      }
+
+      conn.outputLen  = 0;
+      conn.outputSent = 0;
+
+      if (conn.outputCap > EM_MULTI_SERVER_OUTPUT_KEEP)
+      {
+        em_free(conn.output);
+
+        conn.output     = NULL;
+        conn.outputCap  = 0;
+      }
+
+      if (conn.state != EM_CONN_WRITING)
+        return;
+
+      if (conn.keepAlive)
+        conn.state = EM_CONN_READING;
+      else
+        closeConnection(conn);
+    }
+
+    ///////////////////////////
+
+    int           _port;
+    int           _listenFd       = -1;
+
+    Connection    _connections[EM_MULTI_SERVER_CLIENTS];
+    Connection*   _current        = NULL;
+
+    String            _routeUris[EM_MULTI_SERVER_MAX_ROUTES];
+    THandlerFunction  _routeHandlers[EM_MULTI_SERVER_MAX_ROUTES];
+    int               _routeCount   = 0;
+    THandlerFunction  _notFoundHandler;
+
+    // Current request
+    HTTPMethod    _method         = HTTP_GET;
+    bool          _http11         = true;
+    bool          _headOnly       = false;
+    String        _uri;
+    String        _hostHeader;
+    String        _argNames[EM_MULTI_SERVER_MAX_ARGS];
+    String        _argValues[EM_MULTI_SERVER_MAX_ARGS];
+    int           _argCount       = 0;
+
+    String        _headerKeys[EM_MULTI_SERVER_MAX_HEADERS];
+    String        _headerValues[EM_MULTI_SERVER_MAX_HEADERS];
+    int           _headerKeysCount  = 0;
+
+    // Current response
+    String        _responseHeaders;
+    size_t        _contentLength  = CONTENT_LENGTH_NOT_SET;
+    bool          _chunked        = false;
+    bool          _headSent       = false;
+
+    int           _responseCode   = 0;
+    size_t        _responseLength = 0;
+};
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_EM_MultiServer_H
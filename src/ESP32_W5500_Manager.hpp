@@ -102,6 +102,23 @@
 
 #include <DNSServer.h>
 
+// Use the library's captive DNS responder, answering all pending queries at each Config Portal iteration.
+// Set to false to use DNSServer, answering one query per iteration
+#ifndef USE_EM_CAPTIVE_DNS
+  #define USE_EM_CAPTIVE_DNS        true
+#endif
+
+#if USE_EM_CAPTIVE_DNS
+  #include "ESP32_W5500_Manager_DNS.h"
+
+  typedef ESP32_EMCaptiveDNS    EM_DNSServer;
+#else
+  typedef DNSServer             EM_DNSServer;
+#endif
+
+#include "ESP32_W5500_Manager_IP.h"
+#include "ESP32_W5500_Manager_Alloc.h"
+
 #include <memory>
 #undef min
 #undef max
@@ -161,15 +178,62 @@ typedef struct
 
 ////////////////////////////////////////////////////
 
+// Compile-time HTML templates.
+// Each template string with {x} placeholders is also kept pre-split into literal segments, each one followed by
+// a typed slot, so that a page is rendered in one linear pass of appends, without searching or String::replace().
+// The split tables are checked against the template strings at compile time by em_templateMatches()
+
+typedef struct
+{
+  const char* literal;
+  char        slot;         // 'i', 'n', 'p', 'l', 'v', 'c' or 0 after the last literal
+} EM_TemplateSegment;
+
+typedef struct
+{
+  const char* id;           // {i} and {n}
+  const char* placeholder;  // {p}
+  int         length;       // {l}
+  const char* value;        // {v}
+  const char* custom;       // {c}
+} EM_TemplateArgs;
+
+constexpr bool em_templateMatches(const char* str, const EM_TemplateSegment* seg, const size_t count, const char* lit)
+{
+  return (*lit != 0) ? ( (*str == *lit) && em_templateMatches(str + 1, seg, count, lit + 1) ) :
+         (seg->slot == 0) ? ( (count == 1) && (*str == 0) ) :
+         ( (count > 1) && (str[0] == '{') && (str[1] == seg->slot) && (str[2] == '}') &&
+           em_templateMatches(str + 3, seg + 1, count - 1, seg[1].literal) );
+}
+
+template <size_t N>
+constexpr bool em_templateMatches(const char* str, const EM_TemplateSegment (&seg)[N])
+{
+  return em_templateMatches(str, seg, N, seg[0].literal);
+}
+
+////////////////////////////////////////////////////
+
 //KH
 // Mofidy HTTP_HEAD to EM_HTTP_HEAD_START to avoid conflict in Arduino esp8266 core 2.6.0+
 const char EM_HTTP_200[] PROGMEM            = "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\n\r\n";
-const char EM_HTTP_HEAD_START[] PROGMEM     = "<!DOCTYPE html><html lang='en'><head><meta name='viewport' content='width=device-width, initial-scale=1, user-scalable=no'/><title>{v}</title>";
+constexpr char EM_HTTP_HEAD_START[] PROGMEM     = "<!DOCTYPE html><html lang='en'><head><meta name='viewport' content='width=device-width, initial-scale=1, user-scalable=no'/><title>{v}</title>";
+
+constexpr EM_TemplateSegment EM_TPL_HEAD_START[] =
+{
+  { "<!DOCTYPE html><html lang='en'><head><meta name='viewport' content='width=device-width, initial-scale=1, user-scalable=no'/><title>", 'v' },
+  { "</title>", 0 }
+};
+
+static_assert(em_templateMatches(EM_HTTP_HEAD_START, EM_TPL_HEAD_START), "EM_TPL_HEAD_START out of sync");
 
 ////////////////////////////////////////////////////
 
+// Served gzip-compressed as /em.css (see utils/gen_portal_assets.py). Pages link to it with EM_HTTP_STYLE_LINK
 const char EM_HTTP_STYLE[] PROGMEM = "<style>div{padding:2px;font-size:1em;}body,textarea,input,select{background: 0;border-radius: 0;font: 16px sans-serif;margin: 0}textarea,input,select{outline: 0;font-size: 14px;border: 1px solid #ccc;padding: 8px;width: 90%}.btn a{text-decoration: none}.container{margin: auto;width: 90%}@media(min-width:1200px){.container{margin: auto;width: 30%}}@media(min-width:768px) and (max-width:1200px){.container{margin: auto;width: 50%}}.btn,h2{font-size: 2em}h1{font-size: 3em}.btn{background: #0ae;border-radius: 4px;border: 0;color: #fff;cursor: pointer;display: inline-block;margin: 2px 0;padding: 10px 14px 11px;width: 100%}.btn:hover{background: #09d}.btn:active,.btn:focus{background: #08b}label>*{display: inline}form>*{display: block;margin-bottom: 10px}textarea:focus,input:focus,select:focus{border-color: #5ab}.msg{background: #def;border-left: 5px solid #59d;padding: 1.5em}.q{float: right;width: 64px;text-align: right}.l{background: url('data:image/png;base64,iVBORw0KGgoAAAANSUhEUgAAACAAAAAgCAMAAABEpIrGAAAALVBMVEX///8EBwfBwsLw8PAzNjaCg4NTVVUjJiZDRUUUFxdiZGSho6OSk5Pg4eFydHTCjaf3AAAAZElEQVQ4je2NSw7AIAhEBamKn97/uMXEGBvozkWb9C2Zx4xzWykBhFAeYp9gkLyZE0zIMno9n4g19hmdY39scwqVkOXaxph0ZCXQcqxSpgQpONa59wkRDOL93eAXvimwlbPbwwVAegLS1HGfZAAAAABJRU5ErkJggg==') no-repeat left center;background-size: 1em}input[type='checkbox']{float: left;width: 20px}.table td{padding:.5em;text-align:left}.table tbody>:nth-child(2n-1){background:#ddd}fieldset{border-radius:0.5rem;margin:0px;}</style>";
 
+const char EM_HTTP_STYLE_LINK[] PROGMEM = "<link rel='stylesheet' href='/em.css'>";
+
 ////////////////////////////////////////////////////
 
 const char EM_HTTP_SCRIPT[] PROGMEM = "<script>function c(l){document.getElementById('s').value=l.innerText||l.textContent;document.getElementById('p').focus();document.getElementById('s1').value=l.innerText||l.textContent;document.getElementById('p1').focus();document.getElementById('timezone').value=timezone.name();}</script>";
@@ -188,6 +252,7 @@ const char EM_HTTP_SCRIPT[] PROGMEM = "<script>function c(l){document.getElement
 #if USE_ESP_ETH_MANAGER_NTP
 
 #include "utils/TZ.h"
+#include "utils/TZ_Pool.h"
 
 const char EM_HTTP_SCRIPT_NTP_MSG[] PROGMEM = "<p>Your Timezone is : <b><label id='timezone' name='timezone'></b><script>document.getElementById('timezone').innerHTML=timezone.name();document.getElementById('timezone').value=timezone.name();</script></p>";
 const char EM_HTTP_SCRIPT_NTP_HIDDEN[] PROGMEM = "<p><input type='hidden' id='timezone' name='timezone'><script>document.getElementById('timezone').innerHTML=timezone.name();document.getElementById('timezone').value=timezone.name();</script></p>";
@@ -203,7 +268,14 @@ const char EM_HTTP_SCRIPT_NTP_HIDDEN[] PROGMEM = "<p><input type='hidden' id='ti
 
 #if USE_CLOUDFLARE_NTP
 const char EM_HTTP_SCRIPT_NTP[] PROGMEM = "<script src='https://cdnjs.cloudflare.com/ajax/libs/jstimezonedetect/1.0.7/jstz.min.js'></script><script>var timezone=jstz.determine();console.log('Your CloudFlare timezone is:' + timezone.name());document.getElementById('timezone').innerHTML = timezone.name();</script>";
+
+// jstz is already loaded from cloudflare CDN
+#define EM_HTTP_SCRIPT_NTP_LINK       EM_HTTP_SCRIPT_NTP
 #else
+// Served gzip-compressed as /tz.js (see utils/gen_portal_assets.py). Pages link to it with EM_HTTP_SCRIPT_NTP_LINK
+#define USING_EM_TZ_JS_ASSET          true
+
+const char EM_HTTP_SCRIPT_NTP_LINK[] PROGMEM = "<script src='/tz.js'></script>";
 const char EM_HTTP_SCRIPT_NTP[] PROGMEM = "<script>(function(e){var t=function(){'use strict';var e='s',n=function(e){var t=-e.getTimezoneOffset();return t!==null?t:0},r=function(e,t,n){var r=new Date;return e!==undefined&&r.setFullYear(e),r.setDate(n),r.setMonth(t),r},i=function(e){return n(r(e,0,2))},s=function(e){return n(r(e,5,2))},o=function(e){var t=e.getMonth()>7?s(e.getFullYear()):i(e.getFullYear()),r=n(e);return t-r!==0},u=function(){var t=i(),n=s(),r=i()-s();return r<0?t+',1':r>0?n+',1,'+e:t+',0'},a=function(){var e=u();return new t.TimeZone(t.olson.timezones[e])},f=function(e){var t=new Date(2010,6,15,1,0,0,0),n={'America/Denver':new Date(2011,2,13,3,0,0,0),'America/Mazatlan':new Date(2011,3,3,3,0,0,0),'America/Chicago':new Date(2011,2,13,3,0,0,0),'America/Mexico_City':new Date(2011,3,3,3,0,0,0),'America/Asuncion':new Date(2012,9,7,3,0,0,0),'America/Santiago':new Date(2012,9,3,3,0,0,0),'America/Campo_Grande':new Date(2012,9,21,5,0,0,0),'America/Montevideo':new Date(2011,9,2,3,0,0,0),'America/Sao_Paulo':new Date(2011,9,16,5,0,0,0),'America/Los_Angeles':new Date(2011,2,13,8,0,0,0),'America/Santa_Isabel':new Date(2011,3,5,8,0,0,0),'America/Havana':new Date(2012,2,10,2,0,0,0),'America/New_York':new Date(2012,2,10,7,0,0,0),'Asia/Beirut':new Date(2011,2,27,1,0,0,0),'Europe/Helsinki':new Date(2011,2,27,4,0,0,0),'Europe/Istanbul':new Date(2011,2,28,5,0,0,0),'Asia/Damascus':new Date(2011,3,1,2,0,0,0),'Asia/Jerusalem':new Date(2011,3,1,6,0,0,0),'Asia/Gaza':new Date(2009,2,28,0,30,0,0),'Africa/Cairo':new Date(2009,3,25,0,30,0,0),'Pacific/Auckland':new Date(2011,8,26,7,0,0,0),'Pacific/Fiji':new Date(2010,11,29,23,0,0,0),'America/Halifax':new Date(2011,2,13,6,0,0,0),'America/Goose_Bay':new Date(2011,2,13,2,1,0,0),'America/Miquelon':new Date(2011,2,13,5,0,0,0),'America/Godthab':new Date(2011,2,27,1,0,0,0),'Europe/Moscow':t,'Asia/Yekaterinburg':t,'Asia/Omsk':t,'Asia/Krasnoyarsk':t,'Asia/Irkutsk':t,'Asia/Yakutsk':t,'Asia/Vladivostok':t,'Asia/Kamchatka':t,'Europe/Minsk':t,'Australia/Perth':new Date(2008,10,1,1,0,0,0)};return n[e]};return{determine:a,date_is_dst:o,dst_start_for:f}}();t.TimeZone=function(e){'use strict';var n={'America/Denver':['America/Denver','America/Mazatlan'],'America/Chicago':['America/Chicago','America/Mexico_City'],'America/Santiago':['America/Santiago','America/Asuncion','America/Campo_Grande'],'America/Montevideo':['America/Montevideo','America/Sao_Paulo'],'Asia/Beirut':['Asia/Beirut','Europe/Helsinki','Europe/Istanbul','Asia/Damascus','Asia/Jerusalem','Asia/Gaza'],'Pacific/Auckland':['Pacific/Auckland','Pacific/Fiji'],'America/Los_Angeles':['America/Los_Angeles','America/Santa_Isabel'],'America/New_York':['America/Havana','America/New_York'],'America/Halifax':['America/Goose_Bay','America/Halifax'],'America/Godthab':['America/Miquelon','America/Godthab'],'Asia/Dubai':['Europe/Moscow'],'Asia/Dhaka':['Asia/Yekaterinburg'],'Asia/Jakarta':['Asia/Omsk'],'Asia/Shanghai':['Asia/Krasnoyarsk','Australia/Perth'],'Asia/Tokyo':['Asia/Irkutsk'],'Australia/Brisbane':['Asia/Yakutsk'],'Pacific/Noumea':['Asia/Vladivostok'],'Pacific/Tarawa':['Asia/Kamchatka'],'Africa/Johannesburg':['Asia/Gaza','Africa/Cairo'],'Asia/Baghdad':['Europe/Minsk']},r=e,i=function(){var e=n[r],i=e.length,s=0,o=e[0];for(;s<i;s+=1){o=e[s];if(t.date_is_dst(t.dst_start_for(o))){r=o;return}}},s=function(){return typeof n[r]!='undefined'};return s()&&i(),{name:function(){return r}}},t.olson={},t.olson.timezones={'-720,0':'Etc/GMT+12','-660,0':'Pacific/Pago_Pago','-600,1':'America/Adak','-600,0':'Pacific/Honolulu','-570,0':'Pacific/Marquesas','-540,0':'Pacific/Gambier','-540,1':'America/Anchorage','-480,1':'America/Los_Angeles','-480,0':'Pacific/Pitcairn','-420,0':'America/Phoenix','-420,1':'America/Denver','-360,0':'America/Guatemala','-360,1':'America/Chicago','-360,1,s':'Pacific/Easter','-300,0':'America/Bogota','-300,1':'America/New_York','-270,0':'America/Caracas','-240,1':'America/Halifax','-240,0':'America/Santo_Domingo','-240,1,s':'America/Santiago','-210,1':'America/St_Johns','-180,1':'America/Godthab','-180,0':'America/Argentina/Buenos_Aires','-180,1,s':'America/Montevideo','-120,0':'Etc/GMT+2','-120,1':'Etc/GMT+2','-60,1':'Atlantic/Azores','-60,0':'Atlantic/Cape_Verde','0,0':'Etc/UTC','0,1':'Europe/London','60,1':'Europe/Berlin','60,0':'Africa/Lagos','60,1,s':'Africa/Windhoek','120,1':'Asia/Beirut','120,0':'Africa/Johannesburg','180,0':'Asia/Baghdad','180,1':'Europe/Moscow','210,1':'Asia/Tehran','240,0':'Asia/Dubai','240,1':'Asia/Baku','270,0':'Asia/Kabul','300,1':'Asia/Yekaterinburg','300,0':'Asia/Karachi','330,0':'Asia/Kolkata','345,0':'Asia/Kathmandu','360,0':'Asia/Dhaka','360,1':'Asia/Omsk','390,0':'Asia/Rangoon','420,1':'Asia/Krasnoyarsk','420,0':'Asia/Jakarta','480,0':'Asia/Shanghai','480,1':'Asia/Irkutsk','525,0':'Australia/Eucla','525,1,s':'Australia/Eucla','540,1':'Asia/Yakutsk','540,0':'Asia/Tokyo','570,0':'Australia/Darwin','570,1,s':'Australia/Adelaide','600,0':'Australia/Brisbane','600,1':'Asia/Vladivostok','600,1,s':'Australia/Sydney','630,1,s':'Australia/Lord_Howe','660,1':'Asia/Kamchatka','660,0':'Pacific/Noumea','690,0':'Pacific/Norfolk','720,1,s':'Pacific/Auckland','720,0':'Pacific/Tarawa','765,1,s':'Pacific/Chatham','780,0':'Pacific/Tongatapu','780,1,s':'Pacific/Apia','840,0':'Pacific/Kiritimati'},typeof exports!='undefined'?exports.jstz=t:e.jstz=t})(this);</script><script>var timezone=jstz.determine();console.log('Your Timezone is:' + timezone.name());document.getElementById('timezone').innerHTML = timezone.name();</script>";
 #endif
 
@@ -211,8 +283,15 @@ const char EM_HTTP_SCRIPT_NTP[] PROGMEM = "<script>(function(e){var t=function()
   const char EM_HTTP_SCRIPT_NTP_MSG[]     PROGMEM   = "";
   const char EM_HTTP_SCRIPT_NTP_HIDDEN[]  PROGMEM   = "";
   const char EM_HTTP_SCRIPT_NTP[]         PROGMEM   = "";
+  const char EM_HTTP_SCRIPT_NTP_LINK[]    PROGMEM   = "";
 #endif
 
+#if !defined(USING_EM_TZ_JS_ASSET)
+  #define USING_EM_TZ_JS_ASSET        false
+#endif
+
+#include "utils/EM_Assets.h"
+
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
@@ -246,13 +325,42 @@ const char EM_HTTP_FORM_START[] PROGMEM = "<form method='get' action='ethsave'>"
 
 ////////////////////////////////////////////////////
 
-const char EM_HTTP_FORM_LABEL_BEFORE[]  PROGMEM   = "<div><label for='{i}'>{p}</label><input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}><div></div></div>";
-const char EM_HTTP_FORM_LABEL_AFTER[]   PROGMEM   = "<div><input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}><label for='{i}'>{p}</label><div></div></div>";
+constexpr char EM_HTTP_FORM_LABEL_BEFORE[]  PROGMEM   = "<div><label for='{i}'>{p}</label><input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}><div></div></div>";
+constexpr char EM_HTTP_FORM_LABEL_AFTER[]   PROGMEM   = "<div><input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}><label for='{i}'>{p}</label><div></div></div>";
+
+constexpr EM_TemplateSegment EM_TPL_FORM_LABEL_BEFORE[] =
+{
+  { "<div><label for='", 'i' }, { "'>", 'p' }, { "</label><input id='", 'i' }, { "' name='", 'n' }, { "' length=", 'l' },
+  { " placeholder='", 'p' }, { "' value='", 'v' }, { "' ", 'c' }, { "><div></div></div>", 0 }
+};
+
+constexpr EM_TemplateSegment EM_TPL_FORM_LABEL_AFTER[] =
+{
+  { "<div><input id='", 'i' }, { "' name='", 'n' }, { "' length=", 'l' }, { " placeholder='", 'p' }, { "' value='", 'v' },
+  { "' ", 'c' }, { "><label for='", 'i' }, { "'>", 'p' }, { "</label><div></div></div>", 0 }
+};
+
+static_assert(em_templateMatches(EM_HTTP_FORM_LABEL_BEFORE, EM_TPL_FORM_LABEL_BEFORE), "EM_TPL_FORM_LABEL_BEFORE out of sync");
+static_assert(em_templateMatches(EM_HTTP_FORM_LABEL_AFTER,  EM_TPL_FORM_LABEL_AFTER),  "EM_TPL_FORM_LABEL_AFTER out of sync");
 
 ////////////////////////////////////////////////////
 
-const char EM_HTTP_FORM_LABEL[] PROGMEM = "<label for='{i}'>{p}</label>";
-const char EM_HTTP_FORM_PARAM[] PROGMEM = "<input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}>";
+constexpr char EM_HTTP_FORM_LABEL[] PROGMEM = "<label for='{i}'>{p}</label>";
+constexpr char EM_HTTP_FORM_PARAM[] PROGMEM = "<input id='{i}' name='{n}' length={l} placeholder='{p}' value='{v}' {c}>";
+
+constexpr EM_TemplateSegment EM_TPL_FORM_LABEL[] =
+{
+  { "<label for='", 'i' }, { "'>", 'p' }, { "</label>", 0 }
+};
+
+constexpr EM_TemplateSegment EM_TPL_FORM_PARAM[] =
+{
+  { "<input id='", 'i' }, { "' name='", 'n' }, { "' length=", 'l' }, { " placeholder='", 'p' }, { "' value='", 'v' },
+  { "' ", 'c' }, { ">", 0 }
+};
+
+static_assert(em_templateMatches(EM_HTTP_FORM_LABEL, EM_TPL_FORM_LABEL), "EM_TPL_FORM_LABEL out of sync");
+static_assert(em_templateMatches(EM_HTTP_FORM_PARAM, EM_TPL_FORM_PARAM), "EM_TPL_FORM_PARAM out of sync");
 
 const char EM_HTTP_FORM_END[] PROGMEM = "<button class='btn' type='submit'>Save</button></form>";
 
@@ -271,6 +379,9 @@ const char EM_HTTP_HEAD_CT[]         = "text/html";
 const char EM_HTTP_HEAD_CT2[]        = "text/plain";
 
 const char EM_HTTP_HEAD_JSON[]       ="application/json";
+const char EM_HTTP_HEAD_CSS[]        = "text/css";
+const char EM_HTTP_HEAD_METRICS[]    = "text/plain; version=0.0.4";
+const char EM_HTTP_HEAD_JS[]         = "application/javascript";
 
 //KH Add repeatedly used const
 const char EM_HTTP_CACHE_CONTROL[]   = "Cache-Control";
@@ -281,6 +392,30 @@ const char EM_HTTP_EXPIRES[]         = "Expires";
 const char EM_HTTP_CORS[]            = "Access-Control-Allow-Origin";
 const char EM_HTTP_CORS_ALLOW_ALL[]  = "*";
 
+// For the compile-time gzipped assets. Their ETag changes with the content, so they can be cached forever
+const char EM_HTTP_ETAG[]              = "ETag";
+const char EM_HTTP_IF_NONE_MATCH[]     = "If-None-Match";
+
+// Response header profiles. Each one is appended to the response headers as a single block,
+// instead of one sendHeader() call per header. See ESP32_W5500_Manager::sendHeaderProfile()
+typedef enum
+{
+  EM_HEADERS_NO_CACHE = 0,    // Pages not to be cached, without CORS
+  EM_HEADERS_PAGE,            // Portal pages: no-cache, plus CORS if USING_CORS_FEATURE
+  EM_HEADERS_JSON,            // JSON API: as EM_HEADERS_PAGE, plus nosniff
+  EM_HEADERS_ASSET,           // Compile-time gzipped assets, cached forever
+  EM_HEADERS_REVALIDATE       // Portal pages with an ETag: stored, but revalidated on each use, plus CORS
+} EM_HeaderProfile;
+
+// The captive portal redirect has its own prebuilt response, see EM_HTTP_REDIRECT_RESPONSE
+
+const char EM_HTTP_HEADERS_NO_CACHE[] PROGMEM = "Cache-Control: no-cache, no-store, must-revalidate\r\nPragma: no-cache\r\nExpires: -1\r\n";
+const char EM_HTTP_HEADERS_JSON[]     PROGMEM = "Cache-Control: no-cache, no-store, must-revalidate\r\nPragma: no-cache\r\nExpires: -1\r\n"
+                                                "X-Content-Type-Options: nosniff\r\n";
+const char EM_HTTP_HEADERS_ASSET[]    PROGMEM = "Cache-Control: public, max-age=31536000, immutable\r\n";
+const char EM_HTTP_HEADERS_REVALIDATE[] PROGMEM = "Cache-Control: no-cache\r\n";
+const char EM_HTTP_HEADERS_GZIP[]     PROGMEM = "Content-Encoding: gzip\r\n";
+
 ////////////////////////////////////////////////////
 
 #if USE_AVAILABLE_PAGES
@@ -311,6 +446,106 @@ typedef struct
   int         _labelPlacement;
 }  EMParam_Data;
 
+////////////////////////////////////////////////////
+
+// Optional arena for ESP32_EMParameter value buffers and the _params table. Instead of one small
+// heap block per parameter, values are carved out of a few large pages, which are all freed
+// together once the last parameter and manager using them are destroyed
+#ifndef USE_EM_PARAM_ARENA
+  #define USE_EM_PARAM_ARENA        false
+#endif
+
+// Size of each arena page. A single allocation larger than this gets a page of its own
+#ifndef EM_PARAM_ARENA_PAGE_SIZE
+  #define EM_PARAM_ARENA_PAGE_SIZE  1024
+#endif
+
+typedef struct
+{
+  uint16_t  pages;
+  uint16_t  liveAllocations;
+  size_t    capacity;
+  size_t    used;
+  size_t    freeHeap;
+  size_t    largestFreeBlock;
+}  EM_ArenaUsage;
+
+////////////////////////////////////////////////////
+
+class ESP32_EMParamArena
+{
+  public:
+
+    static ESP32_EMParamArena& instance();
+
+    // Make sure the next bytes of allocations fit in the current page, to get one contiguous block
+    bool    reserve(const size_t& bytes);
+
+    void*   allocate(const size_t& size, const size_t& align = 1);
+
+    // Pages are freed once every allocation has been released
+    void    release(void* ptr);
+
+    // Arena usage plus free heap and largest free block, to compare heap fragmentation with and without the arena
+    void    getUsage(EM_ArenaUsage& usage);
+
+    void    printUsage(Print& out);
+
+  private:
+
+    ESP32_EMParamArena() {}
+
+    bool    addPage(const size_t& size);
+    void    freePages();
+
+    // Each page starts with a pointer to the previous page
+    uint8_t*  _page       = NULL;
+    size_t    _pageSize   = 0;
+    size_t    _pageUsed   = 0;
+
+    uint16_t  _pages      = 0;
+    uint16_t  _live       = 0;
+    size_t    _capacity   = 0;
+    size_t    _used       = 0;
+};
+
+////////////////////////////////////////////////////
+
+// What the last Config Portal save actually changed
+#define EM_CHANGED_IP         0x01
+#define EM_CHANGED_GW         0x02
+#define EM_CHANGED_SN         0x04
+#define EM_CHANGED_DNS1       0x08
+#define EM_CHANGED_DNS2       0x10
+
+typedef struct
+{
+  uint8_t   ipConfig;       // EM_CHANGED_xxx bits
+  bool      timezone;
+  uint16_t  params;         // Number of params changed, see ESP32_EMParameter::isChanged()
+
+  inline bool hasChanges() const
+  {
+    return (ipConfig != 0) || timezone || (params != 0);
+  }
+}  EM_ChangeSet;
+
+////////////////////////////////////////////////////
+
+// Answer conditional GETs of / and /eth with 304, using a weak ETag built from the page generation
+#ifndef USE_EM_PAGE_ETAG
+  #define USE_EM_PAGE_ETAG        true
+#endif
+
+// Generation of what / and /eth render: bumped by addParameter(), setSTAStaticIPConfig(), a Config Portal
+// save, setCustomHeadElement() and ESP32_EMParameter::setEMParam_Data(). It starts from a random value,
+// so that an ETag from before a reboot doesn't match
+inline uint32_t& em_pageGeneration()
+{
+  static uint32_t generation = esp_random();
+
+  return generation;
+}
 
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
@@ -336,10 +571,19 @@ class ESP32_EMParameter
     int         getValueLength();
     int         getLabelPlacement();
     const char *getCustomHTML();
+
+    // Whether the value was changed by the last Config Portal save
+    inline bool isChanged()
+    {
+      return _changed;
+    }
     
   private:
   
     EMParam_Data _EMParam_data;
+
+    bool _changed   = false;
+    bool _submitted = false;
     
     const char *_customHTML;
 
@@ -351,9 +595,386 @@ class ESP32_EMParameter
 
 ////////////////////////////////////////////////////
 
+// Size of the buffer used to stream Config Portal pages to the client with chunked transfer encoding.
+// Memory used to render a page is bounded by this buffer, no matter how many parameters are added
+#ifndef EM_PAGE_CHUNK_SIZE
+  #define EM_PAGE_CHUNK_SIZE        512
+#endif
+
+////////////////////////////////////////////////////
+
+// Optional cache of the rendered / and /eth bodies. While em_pageGeneration() doesn't change, they
+// are sent from the cache instead of being rendered again, with one copy to the socket
+#ifndef USE_EM_PAGE_CACHE
+  #define USE_EM_PAGE_CACHE           false
+#endif
+
+// Bytes for all cached bodies. A page which doesn't fit is still sent, but not cached
+#ifndef EM_PAGE_CACHE_BUDGET
+  #define EM_PAGE_CACHE_BUDGET        8192
+#endif
+
+// Used instead of EM_PAGE_CACHE_BUDGET when the bodies can go to PSRAM
+#ifndef EM_PAGE_CACHE_PSRAM_BUDGET
+  #define EM_PAGE_CACHE_PSRAM_BUDGET  65536
+#endif
+
+// Cached routes: EM_ROUTE_ROOT and EM_ROUTE_ETH
+#define EM_PAGE_CACHE_ROUTES          2
+
+typedef struct
+{
+  uint32_t  hits;
+  uint32_t  misses;
+  uint32_t  overflows;      // Renders not cached, as over the budget or out of memory
+  size_t    bytes;          // Allocated for the cached bodies
+  size_t    budget;
+  bool      psram;
+}  EM_PageCacheStats;
+
+class ESP32_EMPageCache
+{
+  public:
+
+    ESP32_EMPageCache();
+    ~ESP32_EMPageCache();
+
+    // The body of route rendered at generation, if cached
+    bool    lookup(const uint8_t& route, const uint32_t& generation, const char*& body, size_t& len);
+
+    // Capture the body of route, as streamed by ESP32_EMPageWriter, to be cached as rendered at generation
+    void    beginCapture(const uint8_t& route, const uint32_t& generation);
+    void    capture(const char* data, const size_t& len);
+    void    endCapture();
+
+    // Free all cached bodies
+    void    clear();
+
+    inline const EM_PageCacheStats& getStats()
+    {
+      return _stats;
+    }
+
+  private:
+
+    typedef struct
+    {
+      char*     body;
+      size_t    len;
+      size_t    capacity;
+      uint32_t  generation;
+      bool      valid;
+      bool      tooLarge;     // Didn't fit when rendered at generation, not to be captured again
+    } Entry;
+
+    Entry               _entries[EM_PAGE_CACHE_ROUTES];
+    int8_t              _capturing  = -1;
+    EM_PageCacheStats   _stats;
+};
+
+////////////////////////////////////////////////////
+
+class ESP32_EMWebServer;
+
+class ESP32_EMPageWriter : public Print
+{
+  public:
+
+    ESP32_EMPageWriter(ESP32_EMWebServer* server);
+    ~ESP32_EMPageWriter();
+
+    // Send status line and headers, then start the chunked body
+    void    begin(const int& code, const char* contentType);
+
+    // Flush the last chunk and terminate the chunked body
+    void    end();
+
+    size_t  write(uint8_t c) override;
+    size_t  write(const uint8_t *buffer, size_t size) override;
+
+    using Print::write;
+
+    // Render a pre-split template, see EM_TemplateSegment
+    void    printTemplate(const EM_TemplateSegment* seg, const size_t& count, const EM_TemplateArgs& args);
+
+    template <size_t N>
+    inline void printTemplate(const EM_TemplateSegment (&seg)[N], const EM_TemplateArgs& args)
+    {
+      printTemplate(seg, N, args);
+    }
+
+    // Print str as a quoted JSON string, escaping as needed
+    void    printJsonString(const char* str);
+
+    inline size_t getBytesWritten()
+    {
+      return _totalLen;
+    }
+
+    // Also pass the body to cache, which has to be in capture
+    inline void captureTo(ESP32_EMPageCache* cache)
+    {
+      _cache = cache;
+    }
+
+  private:
+
+    void    sendChunk();
+
+    ESP32_EMWebServer*  _server;
+    ESP32_EMPageCache*  _cache      = NULL;
+
+    char        _buffer[EM_PAGE_CHUNK_SIZE];
+    size_t      _bufferLen  = 0;
+    size_t      _totalLen   = 0;
+    bool        _started    = false;
+};
+
+////////////////////////////////////////////////////
+
+// Captive portal redirect, built once for the current local IP
+const char EM_HTTP_REDIRECT_RESPONSE[] PROGMEM  =
+  "HTTP/1.1 302 Found\r\nLocation: http://%u.%u.%u.%u\r\nContent-Type: text/plain\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+#define EM_REDIRECT_RESPONSE_SIZE     128
+
+// Connectivity probes of the OSes, answered with the redirect without further checks
+const char* const EM_CAPTIVE_PROBE_PATHS[] =
+{
+  "/generate_204",            // Android
+  "/hotspot-detect.html",     // Apple
+  "/ncsi.txt",                // Windows
+  "/connecttest.txt",         // Windows 10+
+};
+
+////////////////////////////////////////////////////
+
+// Serve several Config Portal clients at once, with non-blocking sockets, instead of one at a time with
+// WebServer. Best with startConfigPortalTask() or process(), calling handleClient() without delay
+#ifndef USE_EM_MULTI_SERVER
+  #define USE_EM_MULTI_SERVER       false
+#endif
+
+#if USE_EM_MULTI_SERVER
+
+#include "ESP32_EM_MultiServer.h"
+
+class ESP32_EMWebServer : public ESP32_EMMultiServer
+{
+  public:
+
+    ESP32_EMWebServer(int port = 80) : ESP32_EMMultiServer(port) {}
+};
+
+#else
+
+// WebServer giving access to the parsed request arguments by reference.
+// WebServer::arg(i) and argName(i) return a String copy, which allocates for anything not fitting SSO
+class ESP32_EMWebServer : public WebServer
+{
+  public:
+
+    ESP32_EMWebServer(int port = 80) : WebServer(port) {}
+
+    // Local address of the current client, as used by it
+    inline IPAddress localIP()
+    {
+      return client().localIP();
+    }
+
+    // A complete response, status line and headers included. The connection is closed once it's sent
+    void sendRawResponse(const uint8_t* data, const size_t& len)
+    {
+      WiFiClient& currentClient = client();
+
+      currentClient.write(data, len);
+      currentClient.stop();
+    }
+
+    inline const String& argNameRef(const int& i)
+    {
+      return _currentArgs[i].key;
+    }
+
+    inline const String& argRef(const int& i)
+    {
+      return _currentArgs[i].value;
+    }
+
+    inline const String& hostHeaderRef()
+    {
+      return _hostHeader;
+    }
+
+    // Append ready-made "Name: value\r\n" lines to the response headers, with no temporary Strings
+    inline void sendHeaderBlock(const char* block)
+    {
+      _responseHeaders += block;
+    }
+
+    // The send functions used by the Config Portal, the same set as ESP32_EMMultiServer, recording the status
+    // and body bytes of the current response for the route metrics. They hide all the WebServer overloads, so
+    // that none of them can bypass the count
+    void send(int code, const char* content_type = NULL, const String& content = String(""))
+    {
+      countResponse(code, content.length());
+      WebServer::send(code, content_type, content);
+    }
+
+    void send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength)
+    {
+      countResponse(code, contentLength);
+      WebServer::send_P(code, content_type, content, contentLength);
+    }
+
+    void sendContent(const String& content)
+    {
+      sendContent(content.c_str(), content.length());
+    }
+
+    void sendContent(const char* content, size_t contentLength)
+    {
+      _responseLength += contentLength;
+      WebServer::sendContent(content, contentLength);
+    }
+
+    // For responses written directly to the client
+    inline void countResponse(const int& code, const size_t& len)
+    {
+      _responseCode    = code;
+      _responseLength += len;
+    }
+
+    inline void resetResponse()
+    {
+      _responseCode   = 0;
+      _responseLength = 0;
+    }
+
+    inline int getResponseCode()
+    {
+      return _responseCode;
+    }
+
+    inline size_t getResponseLength()
+    {
+      return _responseLength;
+    }
+
+  private:
+
+    int     _responseCode     = 0;
+    size_t  _responseLength   = 0;
+};
+
+#endif    // USE_EM_MULTI_SERVER
+
+////////////////////////////////////////////////////
+
+// Per-route call count, latency histogram, body bytes and errors, exported at /metrics
+#ifndef USE_EM_METRICS
+  #define USE_EM_METRICS          true
+#endif
+
+typedef enum
+{
+  EM_ROUTE_ROOT,
+  EM_ROUTE_ETH,
+  EM_ROUTE_ETHSAVE,
+  EM_ROUTE_CLOSE,
+  EM_ROUTE_INFO,
+  EM_ROUTE_RESET,
+  EM_ROUTE_STATE,
+  EM_ROUTE_STYLE,
+  EM_ROUTE_TZ_JS,
+  EM_ROUTE_CAPTIVE,       // Captive portal redirects, from any route, and OS connectivity probes
+  EM_ROUTE_NOT_FOUND,
+  EM_ROUTE_METRICS,
+  EM_ROUTE_DNS,           // Captive DNS wakeups which found queries
+  EM_ROUTE_COUNT
+} EM_Route;
+
+#if USE_EM_METRICS
+
+// Label values of the routes in /metrics, in EM_Route order
+const char* const EM_ROUTE_NAMES[EM_ROUTE_COUNT] =
+{
+  "root", "eth", "ethsave", "close", "info", "reset", "state", "style", "tz_js", "captive", "not_found", "metrics", "dns"
+};
+
+#define EM_METRICS_BUCKETS        10
+
+// Upper bounds (us) of the latency buckets. The last bucket, +Inf, takes the rest
+const uint32_t EM_METRICS_BUCKET_BOUNDS[EM_METRICS_BUCKETS - 1] =
+{
+  100, 250, 500, 1000, 2500, 5000, 10000, 25000, 100000
+};
+
+typedef struct
+{
+  uint32_t  count;
+  uint32_t  errors;         // Responses with status >= 400
+  uint64_t  bytes;          // Response bodies
+  uint64_t  totalUs;
+  uint32_t  maxUs;
+  uint32_t  buckets[EM_METRICS_BUCKETS];
+}  EM_RouteMetrics;
+
+#endif    // USE_EM_METRICS
+
+////////////////////////////////////////////////////
+
+// Heap and stack watermarks, sampled after each Config Portal request and at Config Portal start and stop
+#ifndef USE_EM_MEMORY_STATS
+  #define USE_EM_MEMORY_STATS     true
+#endif
+
+#if USE_EM_MEMORY_STATS
+
+typedef struct
+{
+  // Last sample
+  uint32_t  freeHeap;
+  uint32_t  largestFreeBlock;
+
+  // Lowest free heap since boot, as tracked by the heap allocator
+  uint32_t  minFreeHeap;
+
+  // Lowest free stack (bytes) seen on the tasks serving the Config Portal
+  uint32_t  stackHighWaterMark;
+
+  // Current or last Config Portal session. A stop value lower than the start one, session after session,
+  // points to a leak. A largest free block shrinking while the free heap stays, to fragmentation
+  uint32_t  sessionStartFreeHeap;
+  uint32_t  sessionStopFreeHeap;          // 0 while the Config Portal is open
+  uint32_t  sessionMinLargestFreeBlock;
+
+  uint16_t  sessions;
+  uint32_t  samples;
+}  EM_MemoryStats;
+
+#endif    // USE_EM_MEMORY_STATS
+
+////////////////////////////////////////////////////
+
 #define USE_DYNAMIC_PARAMS        true
 #define DEFAULT_PORTAL_TIMEOUT    60000L
 
+// Time (ms) given back to other tasks between Config Portal iterations in blocking mode
+#ifndef TIME_BETWEEN_CONFIG_PORTAL_LOOP
+  #define TIME_BETWEEN_CONFIG_PORTAL_LOOP       50
+#endif
+
+// Stack size of the FreeRTOS task created by startConfigPortalTask()
+#ifndef EM_PORTAL_TASK_STACK_SIZE
+  #define EM_PORTAL_TASK_STACK_SIZE             6144
+#endif
+
+// Default time (ms) from scheduleRestart() to the restart, for the last page to reach the browser
+#ifndef EM_RESTART_DELAY
+  #define EM_RESTART_DELAY                      2000
+#endif
+
 // To permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
 // You have to explicitly specify false to disable the feature.
 #ifndef USE_STATIC_IP_CONFIG_IN_CP
@@ -374,6 +995,22 @@ class ESP32_W5500_Manager
     // If you want to start the config portal
     bool          startConfigPortal();
 
+    // In non-blocking mode, startConfigPortal() returns at once and the sketch has to call process()
+    // from loop() to serve the Config Portal. Default is blocking
+    void          setConfigPortalBlocking(const bool& shouldBlock);
+
+    // Serve pending Config Portal requests, without waiting. Returns true once, when the Config Portal has just closed
+    bool          process();
+
+    // Serve the Config Portal from its own FreeRTOS task, so that loop() keeps running unchanged.
+    // Use isConfigPortalActive() to know when it's closed. Don't call process() in this mode
+    bool          startConfigPortalTask(const UBaseType_t& priority = 1, const uint32_t& stackSize = EM_PORTAL_TASK_STACK_SIZE);
+
+    inline bool   isConfigPortalActive()
+    {
+      return _configPortalActive;
+    }
+
     //sets timeout before webserver loop ends and exits even if there has been no setup.
     //usefully for devices that failed to connect at some point and got stuck in a webserver loop
     //in seconds setConfigPortalTimeout is a new name for setTimeout
@@ -399,9 +1036,34 @@ class ESP32_W5500_Manager
     //called when settings have been changed and connection was successful
     void          setSaveConfigCallback(void(*func)());
 
+    // Same, with what has actually been changed
+    void          setSaveConfigCallback(void(*func)(const EM_ChangeSet& changes));
+
+    // Changes made by the last Config Portal save
+    inline const EM_ChangeSet& getChangeSet()
+    {
+      return _changes;
+    }
+
+    // Restart in delayMs, checked by the Config Portal loop and process(), so that the Config Portal
+    // keeps serving meanwhile. Also for the sketch's own "apply config and reboot", e.g. from its save callback
+    void          scheduleRestart(const uint32_t& delayMs = EM_RESTART_DELAY);
+    void          cancelRestart();
+
+    inline bool   isRestartScheduled()
+    {
+      return _restartScheduled;
+    }
+
+    // Called just before a scheduled restart, e.g. to save state
+    void          setPreRestartCallback(void(*func)());
+
 #if USE_DYNAMIC_PARAMS
     //adds a custom parameter
     bool          addParameter(ESP32_EMParameter *p);
+
+    // Size the parameter table for count parameters at once, instead of growing it while adding
+    bool          reserveParameters(const int& count);
 #else
     //adds a custom parameter
     void          addParameter(ESP32_EMParameter *p);
@@ -423,6 +1085,8 @@ class ESP32_W5500_Manager
     {     
       _CORS_Header = CORSHeaders;
 
+      buildCORSHeaderProfiles();
+
       LOGWARN1(F("Set CORS Header to : "), _CORS_Header);
     }
 
@@ -442,6 +1106,53 @@ class ESP32_W5500_Manager
     // returns the Parameters Count
     int getParametersCount();
 
+#if USE_EM_CAPTIVE_DNS
+    // Captive DNS counters of the current or last Config Portal
+    bool getDNSStats(EM_DNSStats& stats)
+    {
+      if (!dnsServer)
+        return false;
+
+      dnsServer->getStats(stats);
+
+      return true;
+    }
+#endif
+
+#if USE_EM_METRICS
+    // Counters since boot or the last resetMetrics(), kept across Config Portal sessions
+    inline const EM_RouteMetrics& getRouteMetrics(const EM_Route& route)
+    {
+      return _metrics[route];
+    }
+
+    void resetMetrics();
+
+    // Prometheus text format, as served at /metrics
+    void printMetrics(Print& out);
+#endif
+
+#if USE_EM_MEMORY_STATS
+    inline const EM_MemoryStats& getMemoryStats()
+    {
+      return _memoryStats;
+    }
+#endif
+
+    // Call if something rendered by / or /eth changed behind the manager's back, e.g. the text
+    // of the custom head element, so that browsers don't keep showing their cached page
+    inline void invalidatePages()
+    {
+      em_pageGeneration()++;
+    }
+
+#if USE_EM_PAGE_CACHE
+    inline const EM_PageCacheStats& getPageCacheStats()
+    {
+      return _pageCache.getStats();
+    }
+#endif
+
     ///////////////////////////
  
     void setHostname()
@@ -484,23 +1195,48 @@ class ESP32_W5500_Manager
     // .0 is Sunday   
     
     const char * getTZ(const char * timezoneName)
-    {               
-      //const char TZ_NAME[][TIMEZONE_MAX_LEN]
-      for (uint16_t index = 0; index < sizeof(TZ_NAME) / TIMEZONE_MAX_LEN; index++)
+    {
+      // Packed database in utils/TZ_Pool.h. Find the region by its prefix,
+      // then binary search the exact zone name, sorted in strcmp() order
+      for (const EM_TZ_Region& region : EM_TZ_REGIONS)
       {
-        if ( !strncmp(timezoneName, (TZ_NAME[index]), strlen((TZ_NAME[index])) ) )
+        size_t prefixLen = strlen(region.prefix);
+
+        if (strncmp(timezoneName, region.prefix, prefixLen) != 0)
         {
-          yield();
-          
-          return (ESP_TZ_NAME[index]);            
-        }    
+          continue;
+        }
+
+        const char* zoneName = timezoneName + prefixLen;
+
+        uint16_t low  = 0;
+        uint16_t high = region.count;
+
+        while (low < high)
+        {
+          uint16_t middle = (low + high) / 2;
+
+          int result = strcmp(zoneName, region.names + region.index[middle][0]);
+
+          if (result == 0)
+          {
+            return (region.rules + region.index[middle][1]);
+          }
+
+          if (result < 0)
+            high = middle;
+          else
+            low = middle + 1;
+        }
+
+        break;
       }
-      
-      return "";      
+
+      return "";
     }
 
     ///////////////////////////
-      
+
     const char * getTZ(const String& timezoneName)
     {
       return getTZ(timezoneName.c_str());      
@@ -512,9 +1248,9 @@ class ESP32_W5500_Manager
     
   private:
   
-    std::unique_ptr<DNSServer>  dnsServer;
+    std::unique_ptr<EM_DNSServer, ESP32_EMDeleter<EM_DNSServer>>  dnsServer;
 
-    std::unique_ptr<WebServer>  server;
+    std::unique_ptr<ESP32_EMWebServer, ESP32_EMDeleter<ESP32_EMWebServer>>  server;
 
     bool            needInfo = true;
     String          pager;
@@ -527,8 +1263,16 @@ class ESP32_W5500_Manager
     char* getRFC952_hostname(const char* iHostname);
 
     void          setupConfigPortal();
+    bool          handleConfigPortal();
+    void          stopConfigPortalServers();
     void          startWPS();
 
+    static void   configPortalTask(void* param);
+
+    bool          _configPortalBlocking     = true;
+    volatile bool _configPortalActive       = false;
+    TaskHandle_t  _configPortalTaskHandle   = NULL;
+
     ////////////////////////////////////////////////////
 
 #if USE_ESP_ETH_MANAGER_NTP
@@ -563,6 +1307,12 @@ class ESP32_W5500_Manager
     // For configuring CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
 #if USING_CORS_FEATURE
     const char*     _CORS_Header            = EM_HTTP_CORS_ALLOW_ALL;   //"*";
+
+    // EM_HEADERS_PAGE and EM_HEADERS_JSON blocks, rebuilt only when the CORS header changes
+    String          _CORSPageHeaders;
+    String          _CORSJsonHeaders;
+
+    void            buildCORSHeaderProfiles();
 #endif   
    
     wl_status_t   waitForConnectResult();
@@ -576,25 +1326,84 @@ class ESP32_W5500_Manager
     void          handleServerClose();
     void          handleInfo();
     void          handleState();
+    void          writeJsonIP(ESP32_EMPageWriter& page, const char* key, const IPAddress& ip);
     void          handleReset();
     void          handleNotFound();
-    bool          captivePortal();   
-       
-    void          reportStatus(String& page);
+    void          handleStyle();
+    void          handleTZScript();
+    void          sendHeaderProfile(const EM_HeaderProfile& profile);
+    bool          sendPageHeaders(const EM_Route& route);
+    bool          sendCachedPage(const EM_Route& route, ESP32_EMPageWriter& page);
+
+#if USE_EM_PAGE_CACHE
+    ESP32_EMPageCache   _pageCache;
+#endif
+    void          sendAsset(const uint8_t* data, const size_t& len, const char* contentType, const char* etag);
+    bool          captivePortal();
+    void          handleCaptiveProbe();
+    void          sendCaptiveRedirect();
+
+    typedef void (ESP32_W5500_Manager::*EM_RouteHandler)();
+
+    // Register handler for uri, or as the not found handler if uri is NULL, timed as route
+    void          onRoute(const char* uri, const EM_Route& route, EM_RouteHandler handler);
+
+#if (USE_EM_METRICS || USE_EM_MEMORY_STATS)
+    void          handleRoute(const EM_Route& route, EM_RouteHandler handler);
+#endif
+
+#if USE_EM_MEMORY_STATS
+    EM_MemoryStats    _memoryStats;
+
+    void          sampleMemory();
+    void          writeMemoryStats(ESP32_EMPageWriter& page);
+#endif
+
+#if USE_EM_METRICS
+    EM_RouteMetrics   _metrics[EM_ROUTE_COUNT];
+    EM_Route          _currentRoute       = EM_ROUTE_NOT_FOUND;
+
+    void          recordRoute(const EM_Route& route, const uint32_t& us, const size_t& bytes, const bool& error);
+    void          handleMetrics();
+    void          printMetric(Print& out, const char* name, const char* route, const char* le, const uint64_t& value);
+#endif
+
+    char          _redirectResponse[EM_REDIRECT_RESPONSE_SIZE];
+    size_t        _redirectLength     = 0;
+    uint32_t      _redirectIP         = 0;
+
+    void          reportStatus(ESP32_EMPageWriter& page);
+
+    // Param indexes sorted by ID, to look up submitted form args by binary search
+    uint16_t*     _paramIndex         = NULL;
+    int           _paramIndexCount    = 0;
+    int           _paramIndexParams   = -1;
+
+    void          buildParamIndex();
+    int           findParam(const char* id);
+    void          writeHeadStart(ESP32_EMPageWriter& page, const char* title);
+    void          writeIPField(ESP32_EMPageWriter& page, const char* id, const char* label, const IPAddress& ip);
 
     // DNS server
     const byte    DNS_PORT = 53;
 
-    //helpers
-    bool          isIp(const String& str);
-    String        toStringIp(const IPAddress& ip);
-
     bool          connect;
     bool          stopConfigPortal = false;
     
     bool          _debug   = false;     //true;
     
     void(*_savecallback)() = NULL;
+    void(*_changeSetCallback)(const EM_ChangeSet& changes) = NULL;
+    void(*_preRestartCallback)() = NULL;
+
+    volatile bool _restartScheduled         = false;
+    uint32_t      _restartAt                = 0;
+
+    void          handleScheduledRestart();
+
+    EM_ChangeSet  _changes                  = { 0, false, 0 };
+
+    bool          updateIP(IPAddress& target, const char* ipString);
 
     ////////////////////////////////////////////////////
 
@@ -606,24 +1415,6 @@ class ESP32_W5500_Manager
 #endif
 
     ////////////////////////////////////////////////////
-
-    template <class T>
-    auto optionalIPFromString(T *obj, const char *s) -> decltype(obj->fromString(s)) 
-    {
-      return  obj->fromString(s);
-    }
-
-    ///////////////////////////
-     
-    auto optionalIPFromString(...) -> bool 
-    {
-      LOGINFO("No IPAddress.fromString(), use ESP8266 core 2.1.0+ for Custom IP configuration to work.");
-      
-      return false;
-    }
-
-    ///////////////////////////
-     
 };
 
 #endif    // ESP32_W5500_Manager_hpp
@@ -0,0 +1,361 @@
+/****************************************************************************************************************************
+  ESP32_W5500_Manager_Alloc.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// Allocation policy for the library's own heap blocks. Each allocation has a class, and each class
+// is placed in internal RAM or in PSRAM. By default, the small blocks used on each request stay internal,
+// and the parameters, server objects and buffers go to PSRAM when the board has some, leaving internal
+// RAM to lwIP and the sketch's tasks. Without PSRAM, or when it's full, everything is internal.
+//
+// The placement of each class has a compile-time default, EM_ALLOC_xxx_PLACEMENT, and can be changed
+// at run time, before the allocations, with ESP32_EMAlloc::instance().setPlacement(), or replaced as a
+// whole with setPolicy(). printReport() shows where the bytes ended up.
+
+#pragma once
+
+#ifndef ESP32_W5500_Manager_Alloc_H
+#define ESP32_W5500_Manager_Alloc_H
+
+#include <new>
+#include <utility>
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+////////////////////////////////////////////////////
+
+typedef enum
+{
+  EM_ALLOC_HOT = 0,       // Small blocks and objects used on each request or loop: parameter index, WebServer,
+                          // DNS server
+  EM_ALLOC_BULK,          // Parameter table, values and arena pages
+  EM_ALLOC_COLD,          // Buffers used now and then: config store buffers
+  EM_ALLOC_LARGE,         // Large buffers: page cache, multi-client server request / output buffers
+  EM_ALLOC_CLASSES
+} EM_AllocClass;
+
+typedef enum
+{
+  EM_PLACE_INTERNAL = 0,
+  EM_PLACE_PSRAM          // PSRAM when found, and the block is at least EM_ALLOC_PSRAM_MIN_SIZE, else internal
+} EM_Placement;
+
+#ifndef EM_ALLOC_HOT_PLACEMENT
+  #define EM_ALLOC_HOT_PLACEMENT      EM_PLACE_INTERNAL
+#endif
+
+#ifndef EM_ALLOC_BULK_PLACEMENT
+  #define EM_ALLOC_BULK_PLACEMENT     EM_PLACE_PSRAM
+#endif
+
+#ifndef EM_ALLOC_COLD_PLACEMENT
+  #define EM_ALLOC_COLD_PLACEMENT     EM_PLACE_PSRAM
+#endif
+
+#ifndef EM_ALLOC_LARGE_PLACEMENT
+  #define EM_ALLOC_LARGE_PLACEMENT    EM_PLACE_PSRAM
+#endif
+
+// Smaller blocks are not worth the PSRAM access time, and waste more of it in heap overhead
+#ifndef EM_ALLOC_PSRAM_MIN_SIZE
+  #define EM_ALLOC_PSRAM_MIN_SIZE     32
+#endif
+
+const char* const EM_ALLOC_CLASS_NAMES[EM_ALLOC_CLASSES] = { "hot", "bulk", "cold", "large" };
+
+// Explicitly internal, as MALLOC_CAP_8BIT alone can return PSRAM when it's added to the heap
+#define EM_ALLOC_CAPS_INTERNAL        (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define EM_ALLOC_CAPS_PSRAM           (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+// Replacement policy: EM_ALLOC_CAPS_INTERNAL or EM_ALLOC_CAPS_PSRAM for a block of size bytes in class cls.
+// A PSRAM block which can't be allocated falls back to internal RAM
+typedef uint32_t (*EM_AllocPolicy)(const EM_AllocClass& cls, const size_t& size);
+
+// Live blocks and bytes of one class, by region
+typedef struct
+{
+  size_t    internalBytes;
+  size_t    psramBytes;
+  uint16_t  internalBlocks;
+  uint16_t  psramBlocks;
+  uint16_t  fallbacks;      // Meant for PSRAM, but placed in internal RAM
+  uint16_t  failures;
+}  EM_AllocUsage;
+
+////////////////////////////////////////////////////
+
+class ESP32_EMAlloc
+{
+  public:
+
+    static ESP32_EMAlloc& instance()
+    {
+      static ESP32_EMAlloc alloc;
+
+      return alloc;
+    }
+
+    ///////////////////////////
+
+    // For the blocks allocated from now on
+    inline void setPlacement(const EM_AllocClass& cls, const EM_Placement& placement)
+    {
+      _placement[cls] = placement;
+    }
+
+    inline EM_Placement getPlacement(const EM_AllocClass& cls)
+    {
+      return _placement[cls];
+    }
+
+    // NULL to go back to the placements
+    inline void setPolicy(EM_AllocPolicy policy)
+    {
+      _policy = policy;
+    }
+
+    // Whether blocks of cls would go to PSRAM
+    bool usesPSRAM(const EM_AllocClass& cls, const size_t& size = EM_ALLOC_PSRAM_MIN_SIZE)
+    {
+      return (caps(cls, size) & MALLOC_CAP_SPIRAM);
+    }
+
+    ///////////////////////////
+
+    void* allocate(const EM_AllocClass& cls, const size_t& size)
+    {
+      uint32_t  wanted  = caps(cls, size);
+      bool      psram   = (wanted & MALLOC_CAP_SPIRAM);
+      Header*   header  = (Header*) heap_caps_malloc(sizeof(Header) + size, wanted);
+
+      if ( (header == NULL) && psram )
+      {
+        header  = (Header*) heap_caps_malloc(sizeof(Header) + size, EM_ALLOC_CAPS_INTERNAL);
+        psram   = false;
+
+        if (header != NULL)
+          _usage[cls].fallbacks++;
+      }
+
+      if (header == NULL)
+      {
+        _usage[cls].failures++;
+
+        LOGERROR3(F("Alloc: failed, class ="), EM_ALLOC_CLASS_NAMES[cls], F(", size ="), size);
+
+        return NULL;
+      }
+
+      header->size  = size;
+      header->cls   = cls;
+      header->psram = psram;
+
+      count(*header, 1);
+
+      return (header + 1);
+    }
+
+    ///////////////////////////
+
+    void release(void* ptr)
+    {
+      if (ptr == NULL)
+        return;
+
+      Header* header = ((Header*) ptr) - 1;
+
+      count(*header, -1);
+
+      heap_caps_free(header);
+    }
+
+    ///////////////////////////
+
+    // As realloc(), the block may move to the region of cls
+    void* reallocate(const EM_AllocClass& cls, void* ptr, const size_t& size)
+    {
+      if (ptr == NULL)
+        return allocate(cls, size);
+
+      if (size == 0)
+      {
+        release(ptr);
+
+        return NULL;
+      }
+
+      Header* header = ((Header*) ptr) - 1;
+
+      // Shrinking stays in place
+      if ( (size <= header->size) && (header->cls == cls) )
+      {
+        Header* shrunk = (Header*) heap_caps_realloc(header, sizeof(Header) + size,
+                                                     header->psram ? EM_ALLOC_CAPS_PSRAM : EM_ALLOC_CAPS_INTERNAL);
+
+        if (shrunk == NULL)
+          return ptr;
+
+        count(*shrunk, -1);
+        shrunk->size = size;
+        count(*shrunk, 1);
+
+        return (shrunk + 1);
+      }
+
+      void* block = allocate(cls, size);
+
+      if (block != NULL)
+      {
+        memcpy(block, ptr, (size < header->size) ? size : header->size);
+        release(ptr);
+      }
+
+      return block;
+    }
+
+    ///////////////////////////
+
+    inline const EM_AllocUsage& getUsage(const EM_AllocClass& cls)
+    {
+      return _usage[cls];
+    }
+
+    void printReport(Print& out)
+    {
+      out.print(F("Alloc: PSRAM "));
+      out.println(psramFound() ? F("found") : F("not found"));
+
+      for (int i = 0; i < EM_ALLOC_CLASSES; i++)
+      {
+        out.print(F("  "));
+        out.print(EM_ALLOC_CLASS_NAMES[i]);
+        out.print(F(": internal "));
+        out.print(_usage[i].internalBytes);
+        out.print(F(" B / "));
+        out.print(_usage[i].internalBlocks);
+        out.print(F(", PSRAM "));
+        out.print(_usage[i].psramBytes);
+        out.print(F(" B / "));
+        out.print(_usage[i].psramBlocks);
+        out.print(F(", fallbacks = "));
+        out.print(_usage[i].fallbacks);
+        out.print(F(", failures = "));
+        out.println(_usage[i].failures);
+      }
+    }
+
+  private:
+
+    // Before each block, so that release() knows its size, class and region
+    typedef struct
+    {
+      uint32_t  size;
+      uint8_t   cls;
+      bool      psram;
+      uint16_t  reserved;
+    } Header;
+
+    ESP32_EMAlloc()
+    {
+      _placement[EM_ALLOC_HOT]    = EM_ALLOC_HOT_PLACEMENT;
+      _placement[EM_ALLOC_BULK]   = EM_ALLOC_BULK_PLACEMENT;
+      _placement[EM_ALLOC_COLD]   = EM_ALLOC_COLD_PLACEMENT;
+      _placement[EM_ALLOC_LARGE]  = EM_ALLOC_LARGE_PLACEMENT;
+
+      memset(_usage, 0, sizeof(_usage));
+    }
+
+    uint32_t caps(const EM_AllocClass& cls, const size_t& size)
+    {
+      if (_policy)
+        return _policy(cls, size);
+
+      if ( (_placement[cls] == EM_PLACE_PSRAM) && (size >= EM_ALLOC_PSRAM_MIN_SIZE) && psramFound() )
+        return EM_ALLOC_CAPS_PSRAM;
+
+      return EM_ALLOC_CAPS_INTERNAL;
+    }
+
+    void count(const Header& header, const int& sign)
+    {
+      EM_AllocUsage& usage = _usage[header.cls];
+
+      if (header.psram)
+      {
+        usage.psramBytes  += sign * (int) header.size;
+        usage.psramBlocks += sign;
+      }
+      else
+      {
+        usage.internalBytes  += sign * (int) header.size;
+        usage.internalBlocks += sign;
+      }
+    }
+
+    EM_Placement      _placement[EM_ALLOC_CLASSES];
+    EM_AllocPolicy    _policy     = NULL;
+    EM_AllocUsage     _usage[EM_ALLOC_CLASSES];
+};
+
+////////////////////////////////////////////////////
+
+inline void* em_malloc(const EM_AllocClass& cls, const size_t& size)
+{
+  return ESP32_EMAlloc::instance().allocate(cls, size);
+}
+
+inline void* em_realloc(const EM_AllocClass& cls, void* ptr, const size_t& size)
+{
+  return ESP32_EMAlloc::instance().reallocate(cls, ptr, size);
+}
+
+inline void em_free(void* ptr)
+{
+  ESP32_EMAlloc::instance().release(ptr);
+}
+
+////////////////////////////////////////////////////
+
+// new / delete of objects in a given class, for std::unique_ptr<T, ESP32_EMDeleter<T>>
+template <typename T, typename... Args>
+T* em_new(const EM_AllocClass& cls, Args&& ... args)
+{
+  void* block = em_malloc(cls, sizeof(T));
+
+  return block ? new (block) T(std::forward<Args>(args)...) : NULL;
+}
+
+template <typename T>
+struct ESP32_EMDeleter
+{
+  void operator()(T* object) const
+  {
+    if (object)
+    {
+      object->~T();
+      em_free(object);
+    }
+  }
+};
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_W5500_Manager_Alloc_H
@@ -0,0 +1,300 @@
+/****************************************************************************************************************************
+  ESP32_W5500_Manager_BinLog.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// Binary backend of the LOG* macros, enabled by ESP32_ETH_MGR_BINARY_LOG.
+// A LOG* call is sent as one frame:
+//
+//   0xA5 | call site ID (uint32_t, LE) | one encoded value per argument which is not a string literal
+//
+// The call site ID is computed at compile time from the file name and __LINE__. String literals, F("...")
+// or "...", are neither sent nor kept in flash. utils/em_log_decode.py finds the call sites in the sources
+// and turns the frames back into the usual text.
+//
+// Values are encoded as a 1 byte tag, then
+//   'u' unsigned varint          'i' zigzag signed varint      'c' char
+//   'f' float, 4 bytes LE        'a' IPv4 address, 4 bytes     's' length (1 byte), then the text
+
+#pragma once
+
+#ifndef ESP32_W5500_Manager_BinLog_H
+#define ESP32_W5500_Manager_BinLog_H
+
+#include <type_traits>
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+////////////////////////////////////////////////////
+
+// Longer frames are truncated to whole values
+#ifndef EM_BIN_LOG_FRAME_SIZE
+  #define EM_BIN_LOG_FRAME_SIZE       120
+#endif
+
+// Strings (names, values, String objects) are truncated to this length
+#ifndef EM_BIN_LOG_MAX_STRING
+  #define EM_BIN_LOG_MAX_STRING       48
+#endif
+
+#define EM_BIN_LOG_SYNC               0xA5
+#define EM_BIN_LOG_HEADER_SIZE        5
+
+#if ESP32_ETH_MGR_ASYNC_LOG
+  static_assert(EM_BIN_LOG_FRAME_SIZE <= EM_LOG_SLOT_SIZE, "EM_BIN_LOG_FRAME_SIZE must fit in EM_LOG_SLOT_SIZE");
+#endif
+
+////////////////////////////////////////////////////
+
+// FNV-1a of the file name without its path, then mixed with the line number.
+// utils/em_log_decode.py computes the same ID, keep both in sync
+constexpr uint32_t em_logHash(const char* s, const uint32_t h = 2166136261UL)
+{
+  return (*s == 0) ? h : em_logHash(s + 1, (h ^ (uint8_t) *s) * 16777619UL);
+}
+
+constexpr const char* em_logBasename(const char* s, const char* base)
+{
+  return (*s == 0) ? base : em_logBasename(s + 1, ((*s == '/') || (*s == '\\')) ? (s + 1) : base);
+}
+
+constexpr uint32_t em_logId(const char* file, const uint32_t line)
+{
+  return (em_logHash(em_logBasename(file, file)) ^ line) * 16777619UL;
+}
+
+// Same rule as the decoder: an argument written as F("...") or "..." is a literal
+constexpr bool em_isLogLiteral(const char* s)
+{
+  return (*s == ' ') ? em_isLogLiteral(s + 1) : ( (*s == '"') || ( (s[0] == 'F') && (s[1] == '(') && (s[2] == '"') ) );
+}
+
+#define ESP_EM_LOG_ID       (std::integral_constant<uint32_t, em_logId(__FILE__, __LINE__)>::value)
+
+////////////////////////////////////////////////////
+
+class ESP32_EMBinLogFrame
+{
+  public:
+
+    ESP32_EMBinLogFrame(const uint32_t& id)
+    {
+      _buffer[0] = EM_BIN_LOG_SYNC;
+      _buffer[1] = id;
+      _buffer[2] = id >> 8;
+      _buffer[3] = id >> 16;
+      _buffer[4] = id >> 24;
+    }
+
+    ~ESP32_EMBinLogFrame()
+    {
+#if ESP32_ETH_MGR_ASYNC_LOG
+      ESP32_EMLog::instance().push((const char *) _buffer, _len);
+#else
+      DBG_PORT_ESP_EM.write(_buffer, _len);
+#endif
+    }
+
+    ///////////////////////////
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type add(const T& value)
+    {
+      int64_t v = value;
+
+      addVarint('i', ((uint64_t) v << 1) ^ (uint64_t) (v >> 63));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type add(const T& value)
+    {
+      addVarint('u', value);
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type add(const T& value)
+    {
+      float v = value;
+
+      if (reserve(1 + sizeof(v)))
+      {
+        _buffer[_len++] = 'f';
+        memcpy(_buffer + _len, &v, sizeof(v));
+        _len += sizeof(v);
+      }
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type add(const T& value)
+    {
+      add((int) value);
+    }
+
+    // Anything else with a print() overload, e.g. a Printable, is sent as its text
+    template <typename T>
+    typename std::enable_if < !std::is_arithmetic<T>::value && !std::is_enum<T>::value >::type add(const T& value)
+    {
+      if (!reserve(2))
+        return;
+
+      StringWriter writer(*this);
+
+      writer.print(value);
+    }
+
+    ///////////////////////////
+
+    void add(const char& value)
+    {
+      if (reserve(2))
+      {
+        _buffer[_len++] = 'c';
+        _buffer[_len++] = value;
+      }
+    }
+
+    void add(const bool& value)
+    {
+      add((uint8_t) value);
+    }
+
+    void add(const char* value)
+    {
+      addString(value, strlen(value));
+    }
+
+    void add(const String& value)
+    {
+      addString(value.c_str(), value.length());
+    }
+
+    // F() strings reaching here are not literals at the call site, e.g. FPSTR(name)
+    void add(const __FlashStringHelper* value)
+    {
+      PGM_P  text = (PGM_P) value;
+      size_t len  = strlen_P(text);
+
+      if (len > EM_BIN_LOG_MAX_STRING)
+        len = EM_BIN_LOG_MAX_STRING;
+
+      if (reserve(2 + len))
+      {
+        _buffer[_len++] = 's';
+        _buffer[_len++] = len;
+        memcpy_P(_buffer + _len, text, len);
+        _len += len;
+      }
+    }
+
+    void add(const IPAddress& value)
+    {
+      if (reserve(5))
+      {
+        _buffer[_len++] = 'a';
+
+        for (int i = 0; i < 4; i++)
+          _buffer[_len++] = value[i];
+      }
+    }
+
+  private:
+
+    // Collects the print() output of one value into an 's' entry
+    class StringWriter : public Print
+    {
+      public:
+
+        StringWriter(ESP32_EMBinLogFrame& frame) : _frame(frame), _start(frame._len)
+        {
+          _frame._buffer[_frame._len++] = 's';
+          _frame._buffer[_frame._len++] = 0;
+        }
+
+        size_t write(uint8_t c) override
+        {
+          if ( (_frame._buffer[_start + 1] >= EM_BIN_LOG_MAX_STRING) || !_frame.reserve(1) )
+            return 0;
+
+          _frame._buffer[_frame._len++] = c;
+          _frame._buffer[_start + 1]++;
+
+          return 1;
+        }
+
+        using Print::write;
+
+      private:
+
+        ESP32_EMBinLogFrame&  _frame;
+        size_t                _start;
+    };
+
+    inline bool reserve(const size_t& size)
+    {
+      return (_len + size <= EM_BIN_LOG_FRAME_SIZE);
+    }
+
+    void addVarint(const char& tag, uint64_t value)
+    {
+      uint8_t  bytes[10];
+      size_t   count = 0;
+
+      do
+      {
+        bytes[count++] = (value & 0x7F) | ((value > 0x7F) ? 0x80 : 0);
+        value >>= 7;
+      } while (value);
+
+      if (reserve(1 + count))
+      {
+        _buffer[_len++] = tag;
+        memcpy(_buffer + _len, bytes, count);
+        _len += count;
+      }
+    }
+
+    void addString(const char* text, size_t len)
+    {
+      if (len > EM_BIN_LOG_MAX_STRING)
+        len = EM_BIN_LOG_MAX_STRING;
+
+      if (reserve(2 + len))
+      {
+        _buffer[_len++] = 's';
+        _buffer[_len++] = len;
+        memcpy(_buffer + _len, text, len);
+        _len += len;
+      }
+    }
+
+    uint8_t   _buffer[EM_BIN_LOG_FRAME_SIZE];
+    size_t    _len = EM_BIN_LOG_HEADER_SIZE;
+};
+
+////////////////////////////////////////////////////
+
+// The literal test is on the argument as written at the call site, so it has to be stringized by the LOG* macro
+#define ESP_EM_BIN_BEGIN          ESP32_EMBinLogFrame _emLogFrame(ESP_EM_LOG_ID)
+#define ESP_EM_BIN_ARG(x, text)   if (!std::integral_constant<bool, em_isLogLiteral(text)>::value) _emLogFrame.add(x)
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_W5500_Manager_BinLog_H
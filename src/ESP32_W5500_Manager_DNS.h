@@ -0,0 +1,255 @@
+/****************************************************************************************************************************
+  ESP32_W5500_Manager_DNS.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+#pragma once
+
+#ifndef ESP32_W5500_Manager_DNS_H
+#define ESP32_W5500_Manager_DNS_H
+
+////////////////////////////////////////////////////
+
+// Max packets answered per processNextRequest(), so that a DNS flood can't starve the WebServer
+#ifndef EM_DNS_MAX_BURST
+  #define EM_DNS_MAX_BURST          32
+#endif
+
+// Larger queries (there is no reason for a captive portal to see one) are dropped
+#ifndef EM_DNS_MAX_PACKET_SIZE
+  #define EM_DNS_MAX_PACKET_SIZE    512
+#endif
+
+#ifndef EM_DNS_TTL
+  #define EM_DNS_TTL                60
+#endif
+
+#define EM_DNS_HEADER_SIZE          12
+#define EM_DNS_ANSWER_SIZE          16
+
+#define EM_DNS_TYPE_A               1
+#define EM_DNS_TYPE_ANY             255
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  uint32_t  answered;
+  uint32_t  dropped;
+
+  // Packets handled by the last and by the busiest processNextRequest(), at most EM_DNS_MAX_BURST. Not the
+  // socket queue depth, which the UDP API doesn't give: capped counts the calls which stopped at
+  // EM_DNS_MAX_BURST, leaving the rest of the queue for the next one
+  uint16_t  lastBurst;
+  uint16_t  maxBurst;
+  uint32_t  capped;
+}  EM_DNSStats;
+
+////////////////////////////////////////////////////
+
+// Captive portal DNS responder, answering every A query with the Config Portal IP.
+// Each processNextRequest() drains all pending queries (up to EM_DNS_MAX_BURST), instead of one per
+// Config Portal iteration as DNSServer does, and answers from a response built once in start().
+// UDPClass can be replaced by any class with the WiFiUDP API, e.g. to run on the host with a local socket
+template <class UDPClass>
+class ESP32_EMCaptiveDNS_Generic
+{
+  public:
+
+    ESP32_EMCaptiveDNS_Generic()
+    {
+      memset(&_stats, 0, sizeof(_stats));
+    }
+
+    // Only the "*" domain is supported, as used by the Config Portal
+    bool start(const uint16_t& port, const String& domainName, const IPAddress& resolvedIP)
+    {
+      (void) domainName;
+
+      setResolvedIP(resolvedIP);
+
+      memset(&_stats, 0, sizeof(_stats));
+
+      return (_udp.begin(port) == 1);
+    }
+
+    void stop()
+    {
+      _udp.stop();
+    }
+
+    // Kept for DNSServer compatibility. Unknown names don't exist in a captive portal
+    void setErrorReplyCode(const DNSReplyCode& replyCode)
+    {
+      (void) replyCode;
+    }
+
+    void setResolvedIP(const IPAddress& resolvedIP)
+    {
+      buildAnswer(_answer, resolvedIP, EM_DNS_TTL);
+    }
+
+    void processNextRequest()
+    {
+      uint16_t burst = 0;
+
+      while (burst < EM_DNS_MAX_BURST)
+      {
+        int packetSize = _udp.parsePacket();
+
+        if (packetSize <= 0)
+          break;
+
+        burst++;
+
+        if (packetSize > EM_DNS_MAX_PACKET_SIZE)
+        {
+          _udp.flush();
+          _stats.dropped++;
+
+          continue;
+        }
+
+        _udp.read(_packet, packetSize);
+
+        size_t replySize = buildResponse(_packet, packetSize, _answer);
+
+        if (replySize == 0)
+        {
+          _stats.dropped++;
+
+          continue;
+        }
+
+        _udp.beginPacket(_udp.remoteIP(), _udp.remotePort());
+        _udp.write(_packet, replySize);
+        _udp.endPacket();
+
+        _stats.answered++;
+      }
+
+      _stats.lastBurst = burst;
+
+      if (burst > _stats.maxBurst)
+        _stats.maxBurst = burst;
+
+      if (burst == EM_DNS_MAX_BURST)
+        _stats.capped++;
+    }
+
+    inline void getStats(EM_DNSStats& stats)
+    {
+      memcpy(&stats, &_stats, sizeof(stats));
+    }
+
+    ///////////////////////////
+
+    // Resource record pointing back to the name in the question (0xC00C), type A, class IN
+    static void buildAnswer(uint8_t* answer, const IPAddress& ip, const uint32_t& ttl)
+    {
+      answer[0]   = 0xC0;
+      answer[1]   = EM_DNS_HEADER_SIZE;
+      answer[2]   = 0;
+      answer[3]   = EM_DNS_TYPE_A;
+      answer[4]   = 0;
+      answer[5]   = 1;
+      answer[6]   = ttl >> 24;
+      answer[7]   = ttl >> 16;
+      answer[8]   = ttl >> 8;
+      answer[9]   = ttl;
+      answer[10]  = 0;
+      answer[11]  = 4;
+      answer[12]  = ip[0];
+      answer[13]  = ip[1];
+      answer[14]  = ip[2];
+      answer[15]  = ip[3];
+    }
+
+    // Turn the query in packet into its response, in place. packet must hold size + EM_DNS_ANSWER_SIZE bytes.
+    // Returns the response size, or 0 if the query has to be dropped
+    static size_t buildResponse(uint8_t* packet, const size_t& size, const uint8_t* answer)
+    {
+      // Standard query (QR = 0, OPCODE = 0) with exactly one question
+      if ( (size <= EM_DNS_HEADER_SIZE) || (packet[2] & 0xF8) || (packet[4] != 0) || (packet[5] != 1) )
+        return 0;
+
+      size_t pos = EM_DNS_HEADER_SIZE;
+
+      // Skip QNAME labels. Compression is not valid in the question
+      while (packet[pos] != 0)
+      {
+        if (packet[pos] & 0xC0)
+          return 0;
+
+        pos += packet[pos] + 1;
+
+        if (pos >= size)
+          return 0;
+      }
+
+      // Zero label, QTYPE and QCLASS
+      if (pos + 5 > size)
+        return 0;
+
+      uint16_t qtype = (packet[pos + 1] << 8) | packet[pos + 2];
+
+      // Anything after the question (e.g. EDNS OPT record) is dropped
+      pos += 5;
+
+      bool isA = (qtype == EM_DNS_TYPE_A) || (qtype == EM_DNS_TYPE_ANY);
+
+      // QR, AA, keep RD. RA, NOERROR. Other types get an empty NOERROR answer, so clients fall back to A
+      packet[2] = 0x84 | (packet[2] & 0x01);
+      packet[3] = 0x80;
+
+      // ANCOUNT, NSCOUNT, ARCOUNT
+      packet[6]   = 0;
+      packet[7]   = isA ? 1 : 0;
+      packet[8]   = 0;
+      packet[9]   = 0;
+      packet[10]  = 0;
+      packet[11]  = 0;
+
+      if (isA)
+      {
+        memcpy(packet + pos, answer, EM_DNS_ANSWER_SIZE);
+        pos += EM_DNS_ANSWER_SIZE;
+      }
+
+      return pos;
+    }
+
+  private:
+
+    UDPClass      _udp;
+
+    EM_DNSStats   _stats;
+
+    uint8_t       _answer[EM_DNS_ANSWER_SIZE];
+    uint8_t       _packet[EM_DNS_MAX_PACKET_SIZE + EM_DNS_ANSWER_SIZE];
+};
+
+////////////////////////////////////////////////////
+
+typedef ESP32_EMCaptiveDNS_Generic<WiFiUDP>     ESP32_EMCaptiveDNS;
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_W5500_Manager_DNS_H
@@ -47,43 +47,108 @@
 const char ESP_EM_MARK[] = "[EM] ";
 const char ESP_EM_SP[]   = " ";
 
-#define ESP_EM_PRINT        DBG_PORT_ESP_EM.print
-#define ESP_EM_PRINTLN      DBG_PORT_ESP_EM.println
+// Set true to queue the LOG* output and write it from a low-priority task (see ESP32_W5500_Manager_Log.h),
+// so that logging doesn't stall the Config Portal on a slow debug port
+#ifndef ESP32_ETH_MGR_ASYNC_LOG
+  #define ESP32_ETH_MGR_ASYNC_LOG     false
+#endif
+
+// Set true to send the LOG* calls as compact binary frames (see ESP32_W5500_Manager_BinLog.h),
+// to be decoded on the host by utils/em_log_decode.py
+#ifndef ESP32_ETH_MGR_BINARY_LOG
+  #define ESP32_ETH_MGR_BINARY_LOG    false
+#endif
+
+#if ESP32_ETH_MGR_ASYNC_LOG
+  #include "ESP32_W5500_Manager_Log.h"
+
+  #define ESP_EM_LOG_BEGIN    ESP32_EMLogLine _emLogLine
+  #define ESP_EM_PRINT        _emLogLine.print
+  #define ESP_EM_PRINTLN      _emLogLine.println
+#else
+  #define ESP_EM_LOG_BEGIN
+  #define ESP_EM_PRINT        DBG_PORT_ESP_EM.print
+  #define ESP_EM_PRINTLN      DBG_PORT_ESP_EM.println
+#endif
 
 #define ESP_EM_PRINT_MARK   ESP_EM_PRINT(ESP_EM_MARK)
 #define ESP_EM_PRINT_SP     ESP_EM_PRINT(ESP_EM_SP)
 
 /////////////////////////////////////////////////////////
 
-#define LOGERROR(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
-#define LOGERROR0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_PRINT(x); }
-#define LOGERROR1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
-#define LOGERROR2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP;  ESP_EM_PRINTLN(z); }
-#define LOGERROR3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
+#if ESP32_ETH_MGR_BINARY_LOG
+
+#include "ESP32_W5500_Manager_BinLog.h"
+
+/////////////////////////////////////////////////////////
+
+#define LOGERROR(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGERROR0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGERROR1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); }
+#define LOGERROR2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); }
+#define LOGERROR3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); ESP_EM_BIN_ARG(w, #w); }
+
+/////////////////////////////////////////////////////////
+
+#define LOGWARN(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGWARN0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGWARN1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); }
+#define LOGWARN2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); }
+#define LOGWARN3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); ESP_EM_BIN_ARG(w, #w); }
+
+/////////////////////////////////////////////////////////
+
+#define LOGINFO(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGINFO0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGINFO1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); }
+#define LOGINFO2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); }
+#define LOGINFO3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); ESP_EM_BIN_ARG(w, #w); }
+
+/////////////////////////////////////////////////////////
+
+#define LOGDEBUG(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGDEBUG0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); }
+#define LOGDEBUG1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); }
+#define LOGDEBUG2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); }
+#define LOGDEBUG3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_BIN_BEGIN; ESP_EM_BIN_ARG(x, #x); ESP_EM_BIN_ARG(y, #y); ESP_EM_BIN_ARG(z, #z); ESP_EM_BIN_ARG(w, #w); }
+
+/////////////////////////////////////////////////////////
+
+#else    // ESP32_ETH_MGR_BINARY_LOG
+
+#define LOGERROR(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
+#define LOGERROR0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT(x); }
+#define LOGERROR1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
+#define LOGERROR2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP;  ESP_EM_PRINTLN(z); }
+#define LOGERROR3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>0) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
+
+/////////////////////////////////////////////////////////
+
+#define LOGWARN(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
+#define LOGWARN0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT(x); }
+#define LOGWARN1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
+#define LOGWARN2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP;  ESP_EM_PRINTLN(z); }
+#define LOGWARN3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
 
 /////////////////////////////////////////////////////////
 
-#define LOGWARN(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
-#define LOGWARN0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_PRINT(x); }
-#define LOGWARN1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
-#define LOGWARN2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP;  ESP_EM_PRINTLN(z); }
-#define LOGWARN3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>1) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
+#define LOGINFO(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
+#define LOGINFO0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT(x); }
+#define LOGINFO1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
+#define LOGINFO2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(z); }
+#define LOGINFO3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
 
 /////////////////////////////////////////////////////////
 
-#define LOGINFO(x)          if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
-#define LOGINFO0(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_PRINT(x); }
-#define LOGINFO1(x,y)       if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
-#define LOGINFO2(x,y,z)     if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(z); }
-#define LOGINFO3(x,y,z,w)   if(_ESP32_ETH_MGR_LOGLEVEL_>2) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
+#define LOGDEBUG(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
+#define LOGDEBUG0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT(x); }
+#define LOGDEBUG1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
+#define LOGDEBUG2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(z); }
+#define LOGDEBUG3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_LOG_BEGIN; ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
 
 /////////////////////////////////////////////////////////
 
-#define LOGDEBUG(x)         if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_PRINT_MARK; ESP_EM_PRINTLN(x); }
-#define LOGDEBUG0(x)        if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_PRINT(x); }
-#define LOGDEBUG1(x,y)      if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(y); }
-#define LOGDEBUG2(x,y,z)    if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(z); }
-#define LOGDEBUG3(x,y,z,w)  if(_ESP32_ETH_MGR_LOGLEVEL_>3) { ESP_EM_PRINT_MARK; ESP_EM_PRINT(x); ESP_EM_PRINT_SP; ESP_EM_PRINT(y); ESP_EM_PRINT_SP; ESP_EM_PRINT(z); ESP_EM_PRINT_SP; ESP_EM_PRINTLN(w); }
+#endif    // ESP32_ETH_MGR_BINARY_LOG
 
 /////////////////////////////////////////////////////////
 
@@ -0,0 +1,389 @@
+/****************************************************************************************************************************
+  ESP32_W5500_Manager_IP.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// IPv4 / IPv6 address text codec, parsing from and formatting into caller buffers, with no allocation.
+// Accepts and produces the same text as inet_pton() / inet_ntop():
+//   - IPv4: exactly 4 decimal fields 0-255, no leading zero, sign or space
+//   - IPv6: up to 8 groups of 1-4 hex digits, at most one "::", optionally ending with an IPv4 address
+
+#pragma once
+
+#ifndef ESP32_W5500_Manager_IP_H
+#define ESP32_W5500_Manager_IP_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+////////////////////////////////////////////////////
+
+// Buffer sizes for the formatted addresses, with the terminating '\0'
+#define EM_IPV4_STRLEN        16
+#define EM_IPV6_STRLEN        46
+
+////////////////////////////////////////////////////
+
+inline int em_hexValue(const char& c)
+{
+  if ( (c >= '0') && (c <= '9') )
+    return c - '0';
+
+  if ( (c >= 'a') && (c <= 'f') )
+    return c - 'a' + 10;
+
+  if ( (c >= 'A') && (c <= 'F') )
+    return c - 'A' + 10;
+
+  return -1;
+}
+
+////////////////////////////////////////////////////
+
+// Parse the len chars at str, not '\0' terminated
+inline bool em_parseIPv4(const char* str, const size_t& len, uint8_t* ip)
+{
+  const char* end     = str + len;
+  uint8_t     fields  = 0;
+
+  while (fields < 4)
+  {
+    if ( (str == end) || (*str < '0') || (*str > '9') )
+      return false;
+
+    uint16_t value  = 0;
+    uint8_t  digits = 0;
+
+    while ( (str < end) && (*str >= '0') && (*str <= '9') )
+    {
+      // No leading zero, so no 3+ digits value below 100 and no octal ambiguity
+      if ( (digits > 0) && (value == 0) )
+        return false;
+
+      value = value * 10 + (*str++ - '0');
+
+      if (++digits > 3 || value > 255)
+        return false;
+    }
+
+    ip[fields++] = value;
+
+    if (fields < 4)
+    {
+      if ( (str == end) || (*str++ != '.') )
+        return false;
+    }
+  }
+
+  return (str == end);
+}
+
+inline bool em_parseIPv4(const char* str, IPAddress& ip)
+{
+  uint8_t bytes[4];
+
+  if (!em_parseIPv4(str, strlen(str), bytes))
+    return false;
+
+  ip = IPAddress(bytes[0], bytes[1], bytes[2], bytes[3]);
+
+  return true;
+}
+
+////////////////////////////////////////////////////
+
+// Parse the len chars at str, not '\0' terminated, into 16 bytes in network order
+inline bool em_parseIPv6(const char* str, const size_t& len, uint8_t* ip)
+{
+  uint8_t     bytes[16];
+  uint8_t*    pos     = bytes;
+  uint8_t*    gap     = NULL;
+  const char* end     = str + len;
+  const char* group   = str;
+  uint16_t    value   = 0;
+  uint8_t     digits  = 0;
+
+  memset(bytes, 0, sizeof(bytes));
+
+  // A leading ':' is only valid as part of "::"
+  if ( (str < end) && (*str == ':') )
+  {
+    if ( (++str == end) || (*str != ':') )
+      return false;
+  }
+
+  while (str < end)
+  {
+    char c = *str++;
+    int  h = em_hexValue(c);
+
+    if (h >= 0)
+    {
+      if (++digits > 4)
+        return false;
+
+      value = (value << 4) | h;
+
+      continue;
+    }
+
+    if (c == ':')
+    {
+      group = str;
+
+      if (digits == 0)
+      {
+        // Second "::", or ":::"
+        if (gap)
+          return false;
+
+        gap = pos;
+
+        continue;
+      }
+
+      // Trailing single ':'
+      if ( (str == end) || (pos + 2 > bytes + sizeof(bytes)) )
+        return false;
+
+      *pos++  = value >> 8;
+      *pos++  = value;
+      value   = 0;
+      digits  = 0;
+
+      continue;
+    }
+
+    // Embedded IPv4 address, which has to end the string
+    if ( (c == '.') && (pos + 4 <= bytes + sizeof(bytes)) && em_parseIPv4(group, end - group, pos) )
+    {
+      pos    += 4;
+      digits  = 0;
+
+      break;
+    }
+
+    return false;
+  }
+
+  if (digits > 0)
+  {
+    if (pos + 2 > bytes + sizeof(bytes))
+      return false;
+
+    *pos++ = value >> 8;
+    *pos++ = value;
+  }
+
+  if (gap)
+  {
+    // "::" has to stand for at least one group
+    if (pos == bytes + sizeof(bytes))
+      return false;
+
+    size_t tail = pos - gap;
+    size_t fill = bytes + sizeof(bytes) - pos;
+
+    memmove(gap + fill, gap, tail);
+    memset(gap, 0, fill);
+
+    pos = bytes + sizeof(bytes);
+  }
+
+  if (pos != bytes + sizeof(bytes))
+    return false;
+
+  memcpy(ip, bytes, sizeof(bytes));
+
+  return true;
+}
+
+////////////////////////////////////////////////////
+
+// buffer must hold EM_IPV4_STRLEN chars. Returns the length written, without the '\0'
+inline size_t em_formatIPv4(const uint8_t* ip, char* buffer)
+{
+  char* pos = buffer;
+
+  for (int i = 0; i < 4; i++)
+  {
+    uint8_t value = ip[i];
+
+    if (value >= 100)
+      *pos++ = '0' + value / 100;
+
+    if (value >= 10)
+      *pos++ = '0' + (value / 10) % 10;
+
+    *pos++ = '0' + value % 10;
+    *pos++ = (i < 3) ? '.' : '\0';
+  }
+
+  return pos - buffer - 1;
+}
+
+inline size_t em_formatIPv4(const IPAddress& ip, char* buffer)
+{
+  uint8_t bytes[4] = { ip[0], ip[1], ip[2], ip[3] };
+
+  return em_formatIPv4(bytes, buffer);
+}
+
+////////////////////////////////////////////////////
+
+// Shortest form as inet_ntop(): lower case, the longest run (leftmost if tied) of 2+ zero groups as "::",
+// and the IPv4-compatible / IPv4-mapped addresses ending in dotted form.
+// buffer must hold EM_IPV6_STRLEN chars. Returns the length written, without the '\0'
+inline size_t em_formatIPv6(const uint8_t* ip, char* buffer)
+{
+  static const char hexDigits[] = "0123456789abcdef";
+
+  uint16_t  groups[8];
+  int       bestStart = -1, bestLen = 0;
+  int       runStart  = -1;
+
+  for (int i = 0; i < 8; i++)
+  {
+    groups[i] = (ip[2 * i] << 8) | ip[2 * i + 1];
+
+    if (groups[i] == 0)
+    {
+      if (runStart < 0)
+        runStart = i;
+
+      if (i - runStart + 1 > bestLen)
+      {
+        bestStart = runStart;
+        bestLen   = i - runStart + 1;
+      }
+    }
+    else
+    {
+      runStart = -1;
+    }
+  }
+
+  if (bestLen < 2)
+    bestStart = -1;
+
+  char* pos = buffer;
+
+  for (int i = 0; i < 8; i++)
+  {
+    if ( (bestStart >= 0) && (i >= bestStart) && (i < bestStart + bestLen) )
+    {
+      if (i == bestStart)
+        *pos++ = ':';
+
+      continue;
+    }
+
+    if (i != 0)
+      *pos++ = ':';
+
+    if ( (i == 6) && (bestStart == 0) && ( (bestLen == 6) || ( (bestLen == 5) && (groups[5] == 0xFFFF) ) ) )
+    {
+      pos += em_formatIPv4(ip + 12, pos);
+
+      return pos - buffer;
+    }
+
+    bool started = false;
+
+    for (int shift = 12; shift >= 0; shift -= 4)
+    {
+      uint8_t nibble = (groups[i] >> shift) & 0x0F;
+
+      if (started || nibble || (shift == 0))
+      {
+        *pos++  = hexDigits[nibble];
+        started = true;
+      }
+    }
+  }
+
+  if ( (bestStart >= 0) && (bestStart + bestLen == 8) )
+    *pos++ = ':';
+
+  *pos = '\0';
+
+  return pos - buffer;
+}
+
+////////////////////////////////////////////////////
+
+// True if the Host header value is an IP literal: "a.b.c.d", "[IPv6]", either with an optional ":port",
+// or a bare IPv6 address as sent by some clients. A zone ID ("%25eth0", RFC 6874) is allowed in brackets
+inline bool em_isIPHost(const char* host, const size_t& len)
+{
+  uint8_t     ip[16];
+  const char* end   = host + len;
+  const char* port  = NULL;
+  bool        isIP  = false;
+
+  if ( (len > 0) && (host[0] == '[') )
+  {
+    const char* close = (const char*) memchr(host, ']', len);
+
+    if (close == NULL)
+      return false;
+
+    const char* zone = (const char*) memchr(host, '%', close - host);
+
+    isIP = em_parseIPv6(host + 1, (zone ? zone : close) - host - 1, ip);
+    port = close + 1;
+
+    if (port == end)
+      return isIP;
+
+    if (*port++ != ':')
+      return false;
+  }
+  else
+  {
+    const char* colon = (const char*) memchr(host, ':', len);
+
+    if (colon == NULL)
+      return em_parseIPv4(host, len, ip);
+
+    // More than one ':' can only be a bare IPv6 address
+    if (memchr(colon + 1, ':', end - colon - 1))
+      return em_parseIPv6(host, len, ip);
+
+    isIP = em_parseIPv4(host, colon - host, ip);
+    port = colon + 1;
+  }
+
+  // 1 to 5 digits port
+  if ( (port == end) || (end - port > 5) )
+    return false;
+
+  for (const char* c = port; c < end; c++)
+  {
+    if ( (*c < '0') || (*c > '9') )
+      return false;
+  }
+
+  return isIP;
+}
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_W5500_Manager_IP_H
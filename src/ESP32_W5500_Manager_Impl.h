@@ -27,6 +27,144 @@
 
 //////////////////////////////////////////
 
+ESP32_EMParamArena& ESP32_EMParamArena::instance()
+{
+  static ESP32_EMParamArena arena;
+
+  return arena;
+}
+
+//////////////////////////////////////////
+
+bool ESP32_EMParamArena::addPage(const size_t& size)
+{
+  size_t dataSize = (size > EM_PARAM_ARENA_PAGE_SIZE) ? size : EM_PARAM_ARENA_PAGE_SIZE;
+
+  uint8_t* page = (uint8_t*) em_malloc(EM_ALLOC_BULK, sizeof(uint8_t*) + dataSize);
+
+  if (page == NULL)
+  {
+    LOGERROR1(F("Arena: can't allocate page, size ="), dataSize);
+
+    return false;
+  }
+
+  // Link to the previous page, so that freePages() can walk them all
+  *((uint8_t**) page) = _page;
+
+  _page     = page;
+  _pageSize = dataSize;
+  _pageUsed = 0;
+
+  _pages++;
+  _capacity += dataSize;
+
+  LOGINFO1(F("Arena: new page, size ="), dataSize);
+
+  return true;
+}
+
+//////////////////////////////////////////
+
+void ESP32_EMParamArena::freePages()
+{
+  while (_page != NULL)
+  {
+    uint8_t* previous = *((uint8_t**) _page);
+
+    em_free(_page);
+
+    _page = previous;
+  }
+
+  LOGINFO1(F("Arena: freed pages ="), _pages);
+
+  _pageSize = 0;
+  _pageUsed = 0;
+  _pages    = 0;
+  _capacity = 0;
+  _used     = 0;
+}
+
+//////////////////////////////////////////
+
+bool ESP32_EMParamArena::reserve(const size_t& bytes)
+{
+  if ( (_page != NULL) && (_pageSize - _pageUsed >= bytes) )
+    return true;
+
+  return addPage(bytes);
+}
+
+//////////////////////////////////////////
+
+void* ESP32_EMParamArena::allocate(const size_t& size, const size_t& align)
+{
+  size_t offset = (_pageUsed + align - 1) & ~(align - 1);
+
+  if ( (_page == NULL) || (offset + size > _pageSize) )
+  {
+    // The rest of the current page is left unused
+    if (!addPage(size))
+      return NULL;
+
+    offset = 0;
+  }
+
+  _pageUsed = offset + size;
+  _used    += size;
+  _live++;
+
+  return (_page + sizeof(uint8_t*) + offset);
+}
+
+//////////////////////////////////////////
+
+void ESP32_EMParamArena::release(void* ptr)
+{
+  if ( (ptr == NULL) || (_live == 0) )
+    return;
+
+  if (--_live == 0)
+    freePages();
+}
+
+//////////////////////////////////////////
+
+void ESP32_EMParamArena::getUsage(EM_ArenaUsage& usage)
+{
+  usage.pages             = _pages;
+  usage.liveAllocations   = _live;
+  usage.capacity          = _capacity;
+  usage.used              = _used;
+  usage.freeHeap          = ESP.getFreeHeap();
+  usage.largestFreeBlock  = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+//////////////////////////////////////////
+
+void ESP32_EMParamArena::printUsage(Print& out)
+{
+  EM_ArenaUsage usage;
+
+  getUsage(usage);
+
+  out.print(F("Arena pages = "));
+  out.print(usage.pages);
+  out.print(F(", allocations = "));
+  out.print(usage.liveAllocations);
+  out.print(F(", used = "));
+  out.print(usage.used);
+  out.print(F("/"));
+  out.print(usage.capacity);
+  out.print(F(", free heap = "));
+  out.print(usage.freeHeap);
+  out.print(F(", largest free block = "));
+  out.println(usage.largestFreeBlock);
+}
+
+//////////////////////////////////////////
+
 ESP32_EMParameter::ESP32_EMParameter(const char *custom)
 {
   _EMParam_data._id             = NULL;
@@ -65,7 +203,11 @@ void ESP32_EMParameter::init(const char *id, const char *placeholder, const char
   _EMParam_data._length = length;
   _EMParam_data._labelPlacement = labelPlacement;
 
-  _EMParam_data._value = new char[_EMParam_data._length + 1];
+#if USE_EM_PARAM_ARENA
+  _EMParam_data._value = (char *) ESP32_EMParamArena::instance().allocate(_EMParam_data._length + 1);
+#else
+  _EMParam_data._value = (char *) em_malloc(EM_ALLOC_BULK, _EMParam_data._length + 1);
+#endif
 
   if (_EMParam_data._value != NULL)
   {
@@ -86,7 +228,11 @@ ESP32_EMParameter::~ESP32_EMParameter()
 {
   if (_EMParam_data._value != NULL)
   {
-    delete[] _EMParam_data._value;
+#if USE_EM_PARAM_ARENA
+    ESP32_EMParamArena::instance().release(_EMParam_data._value);
+#else
+    em_free(_EMParam_data._value);
+#endif
   }
 }
 
@@ -98,6 +244,8 @@ void ESP32_EMParameter::setEMParam_Data(const EMParam_Data& EMParam_data)
   LOGINFO(F("setEMParam_Data"));
 
   memcpy(&_EMParam_data, &EMParam_data, sizeof(_EMParam_data));
+
+  em_pageGeneration()++;
 }
 
 //////////////////////////////////////////
@@ -153,988 +301,2272 @@ const char* ESP32_EMParameter::getCustomHTML()
 
 //////////////////////////////////////////
 
-/**
-   [getParameters description]
-   @access public
-*/
-ESP32_EMParameter** ESP32_W5500_Manager::getParameters()
+ESP32_EMPageWriter::ESP32_EMPageWriter(ESP32_EMWebServer* server)
 {
-  return _params;
+  _server = server;
 }
 
-//////////////////////////////////////////
 //////////////////////////////////////////
 
-/**
-   [getParametersCount description]
-   @access public
-*/
-int ESP32_W5500_Manager::getParametersCount()
+ESP32_EMPageWriter::~ESP32_EMPageWriter()
 {
-  return _paramsCount;
+  // Never leave the client waiting for the terminating chunk
+  if (_started)
+  {
+    end();
+  }
 }
 
 //////////////////////////////////////////
 
-char* ESP32_W5500_Manager::getRFC952_hostname(const char* iHostname)
+void ESP32_EMPageWriter::begin(const int& code, const char* contentType)
 {
-  memset(RFC952_hostname, 0, sizeof(RFC952_hostname));
+  _bufferLen  = 0;
+  _totalLen   = 0;
 
-  size_t len = (RFC952_HOSTNAME_MAXLEN < strlen(iHostname)) ? RFC952_HOSTNAME_MAXLEN : strlen(iHostname);
+  // Unknown length => WebServer uses "Transfer-Encoding: chunked" for HTTP/1.1 clients
+  _server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  _server->send(code, contentType, "");
 
-  size_t j = 0;
+  _started = true;
+}
 
-  for (size_t i = 0; i < len - 1; i++)
+//////////////////////////////////////////
+
+void ESP32_EMPageWriter::sendChunk()
+{
+  if (_bufferLen > 0)
   {
-    if (isalnum(iHostname[i]) || iHostname[i] == '-')
-    {
-      RFC952_hostname[j] = iHostname[i];
-      j++;
-    }
-  }
+    _server->sendContent(_buffer, _bufferLen);
 
-  // no '-' as last char
-  if (isalnum(iHostname[len - 1]) || (iHostname[len - 1] != '-'))
-    RFC952_hostname[j] = iHostname[len - 1];
+    if (_cache)
+      _cache->capture(_buffer, _bufferLen);
 
-  return RFC952_hostname;
+    _bufferLen = 0;
+  }
 }
 
 //////////////////////////////////////////
 
-ESP32_W5500_Manager::ESP32_W5500_Manager(const char *iHostname)
+void ESP32_EMPageWriter::end()
 {
+  if (!_started)
+    return;
 
-  //server    = webserver;
-  //dnsServer = dnsserver;
+  sendChunk();
 
-#if USE_DYNAMIC_PARAMS
-  _max_params = ETH_MANAGER_MAX_PARAMS;
-  _params = (ESP32_EMParameter**) malloc(_max_params * sizeof(ESP32_EMParameter*));
-#endif
+  // Zero-length chunk to terminate the body
+  _server->sendContent("");
 
-  if (iHostname[0] == 0)
+  if (_cache)
   {
-    String _hostname = "ESP32-" + String(ESP_getChipId(), HEX);
+    _cache->endCapture();
+    _cache = NULL;
+  }
 
-    _hostname.toUpperCase();
+  _started = false;
 
-    getRFC952_hostname(_hostname.c_str());
+  LOGDEBUG1(F("Page sent, bytes ="), _totalLen);
+}
 
-  }
-  else
+//////////////////////////////////////////
+
+size_t ESP32_EMPageWriter::write(uint8_t c)
+{
+  if (_bufferLen == sizeof(_buffer))
   {
-    // Prepare and store the hostname only not NULL
-    getRFC952_hostname(iHostname);
+    sendChunk();
   }
 
-  LOGWARN1(F("RFC925 Hostname ="), RFC952_hostname);
+  _buffer[_bufferLen++] = c;
+  _totalLen++;
 
-  setHostname();
+  return 1;
 }
 
 //////////////////////////////////////////
 
-ESP32_W5500_Manager::~ESP32_W5500_Manager()
+size_t ESP32_EMPageWriter::write(const uint8_t *buffer, size_t size)
 {
-#if USE_DYNAMIC_PARAMS
+  size_t remaining = size;
 
-  if (_params != NULL)
+  while (remaining > 0)
   {
-    LOGINFO(F("freeing allocated params!"));
+    if (_bufferLen == sizeof(_buffer))
+    {
+      sendChunk();
+    }
 
-    free(_params);
+    size_t toCopy = std::min(remaining, sizeof(_buffer) - _bufferLen);
+
+    memcpy(&_buffer[_bufferLen], buffer, toCopy);
+
+    _bufferLen  += toCopy;
+    buffer      += toCopy;
+    remaining   -= toCopy;
   }
 
-#endif
+  _totalLen += size;
+
+  return size;
 }
 
 //////////////////////////////////////////
 
-#if USE_DYNAMIC_PARAMS
-  bool ESP32_W5500_Manager::addParameter(ESP32_EMParameter *p)
-#else
-  void ESP32_W5500_Manager::addParameter(ESP32_EMParameter *p)
-#endif
+void ESP32_EMPageWriter::printTemplate(const EM_TemplateSegment* seg, const size_t& count, const EM_TemplateArgs& args)
 {
-#if USE_DYNAMIC_PARAMS
-
-  if (_paramsCount == _max_params)
+  for (size_t i = 0; i < count; i++)
   {
-    // rezise the params array
-    _max_params += ETH_MANAGER_MAX_PARAMS;
-
-    LOGINFO1(F("Increasing _max_params to:"), _max_params);
+    print(seg[i].literal);
 
-    ESP32_EMParameter** new_params = (ESP32_EMParameter**) realloc(_params, _max_params * sizeof(ESP32_EMParameter*));
-
-    if (new_params != NULL)
-    {
-      _params = new_params;
-    }
-    else
+    switch (seg[i].slot)
     {
-      LOGINFO(F("ERROR: failed to realloc params, size not increased!"));
-
-      return false;
-    }
-  }
-
-  _params[_paramsCount] = p;
-  _paramsCount++;
+      case 'i':
+      case 'n':
+        print(args.id);
+        break;
 
-  LOGINFO1(F("Adding parameter"), p->getID());
+      case 'p':
+        print(args.placeholder);
+        break;
 
-  return true;
+      case 'l':
+        print(args.length);
+        break;
 
-#else
+      case 'v':
+        print(args.value);
+        break;
 
-  // Danger here. Better to use Tzapu way here
-  if (_paramsCount < (ETH_MANAGER_MAX_PARAMS))
-  {
-    _params[_paramsCount] = p;
-    _paramsCount++;
+      case 'c':
+        print(args.custom);
+        break;
 
-    LOGINFO1(F("Adding parameter"), p->getID());
-  }
-  else
-  {
-    LOGINFO("Can't add parameter. Full");
+      default:
+        break;
+    }
   }
-
-#endif
 }
 
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::setupConfigPortal()
+void ESP32_EMPageWriter::printJsonString(const char* str)
 {
-  stopConfigPortal = false; //Signal not to close config portal
+  static const char hexDigits[] = "0123456789abcdef";
 
-  dnsServer.reset(new DNSServer());
+  write('"');
 
-  server.reset(new WebServer(HTTP_PORT_TO_USE));
-
-  /* Setup the DNS server redirecting all the domains to the apIP */
-  if (dnsServer)
+  if (str)
   {
-    dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
+    const char* run = str;
 
-    // AsyncDNSServer started with "*" domain name, all DNS requests will be passsed to ETH.localIP()
-    if (! dnsServer->start(DNS_PORT, "*", ETH.localIP()))
+    for (const char* p = str; *p; p++)
     {
-      // No socket available
-      LOGERROR(F("Can't start DNS Server. No available socket"));
+      uint8_t c = (uint8_t) *p;
+
+      if ( (c >= 0x20) && (c != '"') && (c != '\\') )
+        continue;
+
+      // Flush the run of characters not needing escape in one go
+      write((const uint8_t *) run, p - run);
+      run = p + 1;
+
+      write('\\');
+
+      switch (c)
+      {
+        case '"':
+        case '\\':
+          write(c);
+          break;
+
+        case '\n':
+          write('n');
+          break;
+
+        case '\r':
+          write('r');
+          break;
+
+        case '\t':
+          write('t');
+          break;
+
+        default:
+          write((const uint8_t *) "u00", 3);
+          write(hexDigits[c >> 4]);
+          write(hexDigits[c & 0x0F]);
+          break;
+      }
     }
-  }
-  else
-  {
-    // No space available
-    LOGERROR(F("Can't initiate DNS Server. No enough space"));
-  }
 
-  _configPortalStart = millis();
+    write((const uint8_t *) run, strlen(run));
+  }
 
-  LOGDEBUG1(F("_configPortalStart millis() ="), millis());
+  write('"');
+}
 
-  LOGWARN1(F("Config Portal IP address ="), ETH.localIP());
+//////////////////////////////////////////
 
-  /* Setup web pages: root, eth config pages, SO captive portal detectors and not found. */
+static_assert( (EM_ROUTE_ROOT < EM_PAGE_CACHE_ROUTES) && (EM_ROUTE_ETH < EM_PAGE_CACHE_ROUTES),
+               "EM_PAGE_CACHE_ROUTES must cover EM_ROUTE_ROOT and EM_ROUTE_ETH");
 
-  server->on("/",         std::bind(&ESP32_W5500_Manager::handleRoot,         this));
-  server->on("/eth",      std::bind(&ESP32_W5500_Manager::handleETH,          this));
-  server->on("/ethsave",  std::bind(&ESP32_W5500_Manager::handleETHSave,      this));
-  server->on("/close",    std::bind(&ESP32_W5500_Manager::handleServerClose,  this));
-  server->on("/i",        std::bind(&ESP32_W5500_Manager::handleInfo,         this));
-  server->on("/r",        std::bind(&ESP32_W5500_Manager::handleReset,        this));
-  server->on("/state",    std::bind(&ESP32_W5500_Manager::handleState,        this));
-  //Microsoft captive portal. Maybe not needed. Might be handled by notFound handler.
-  server->on("/fwlink",   std::bind(&ESP32_W5500_Manager::handleRoot,         this));
-  server->onNotFound(     std::bind(&ESP32_W5500_Manager::handleNotFound,     this));
+ESP32_EMPageCache::ESP32_EMPageCache()
+{
+  memset(_entries, 0, sizeof(_entries));
+  memset(&_stats, 0, sizeof(_stats));
+}
 
-  server->begin(); // Web server start
+//////////////////////////////////////////
 
-  LOGWARN(F("HTTP server started"));
+ESP32_EMPageCache::~ESP32_EMPageCache()
+{
+  clear();
 }
 
 //////////////////////////////////////////
 
-bool ESP32_W5500_Manager::startConfigPortal()
+bool ESP32_EMPageCache::lookup(const uint8_t& route, const uint32_t& generation, const char*& body, size_t& len)
 {
-  connect = false;
+  if ( (route >= EM_PAGE_CACHE_ROUTES) || !_entries[route].valid || (_entries[route].generation != generation) )
+    return false;
 
-  setupConfigPortal();
+  body  = _entries[route].body;
+  len   = _entries[route].len;
 
-  bool TimedOut = true;
+  _stats.hits++;
 
-  LOGINFO("startConfigPortal : Enter loop");
+  return true;
+}
+
+//////////////////////////////////////////
 
-  while (true)
+void ESP32_EMPageCache::beginCapture(const uint8_t& route, const uint32_t& generation)
+{
+  if (route >= EM_PAGE_CACHE_ROUTES)
+    return;
+
+  // PSRAM is only known to be there once the core is up, not when a global manager is constructed
+  if (_stats.budget == 0)
   {
-    //DNS
-    dnsServer->processNextRequest();
-    //HTTP
-    server->handleClient();
+    _stats.psram  = ESP32_EMAlloc::instance().usesPSRAM(EM_ALLOC_LARGE);
+    _stats.budget = _stats.psram ? EM_PAGE_CACHE_PSRAM_BUDGET : EM_PAGE_CACHE_BUDGET;
+  }
 
-#if ( USING_ESP32_S2 || USING_ESP32_C3 )
-    // Fix ESP32-S2 issue with WebServer (https://github.com/espressif/arduino-esp32/issues/4348)
-    delay(1);
-#endif
+  _stats.misses++;
 
-    if (connect)
-    {
-      TimedOut = false;
+  if (_entries[route].tooLarge && (_entries[route].generation == generation))
+    return;
 
-      if (_shouldBreakAfterConfig)
-      {
-        //flag set to exit after config after trying to connect
-        //notify that configuration has changed and any optional parameters should be saved
-        if (_savecallback != NULL)
-        {
-          //todo: check if any custom parameters actually exist, and check if they really changed maybe
-          _savecallback();
-        }
+  // The buffer of the previous render is kept, it's usually about the right size
+  _entries[route].valid       = false;
+  _entries[route].tooLarge    = false;
+  _entries[route].len         = 0;
+  _entries[route].generation  = generation;
 
-        LOGDEBUG("Stop ConfigPortal: _shouldBreakAfterConfig");
+  _capturing = route;
+}
 
-        break;
-      }
-    }
+//////////////////////////////////////////
 
-    if (stopConfigPortal)
-    {
-      TimedOut = false;
+void ESP32_EMPageCache::capture(const char* data, const size_t& len)
+{
+  if (_capturing < 0)
+    return;
 
-      LOGERROR("stopConfigPortal");
+  Entry& entry = _entries[_capturing];
 
-      stopConfigPortal = false;
+  if (entry.len + len > entry.capacity)
+  {
+    size_t available  = _stats.budget - (_stats.bytes - entry.capacity);
+    size_t capacity   = std::min(std::max(entry.len + len, 2 * entry.capacity), available);
+    char*  body       = NULL;
 
-      break;
+    if (capacity >= entry.len + len)
+    {
+      body = (char*) em_realloc(EM_ALLOC_LARGE, entry.body, capacity);
     }
 
-    if (_configPortalTimeout > 0 && ( millis() > _configPortalStart + _configPortalTimeout) )
+    if (body == NULL)
     {
-      //LOGDEBUG3("startConfigPortal: timeout, _configPortalTimeout =", _configPortalTimeout, "millis() =", millis());
+      LOGINFO1(F("Page cache: not cached, size >"), entry.len + len);
 
-      stopConfigPortal = false;
+      // Don't keep holding memory for a page which doesn't fit
+      em_free(entry.body);
 
-      break;
-    }
+      _stats.bytes -= entry.capacity;
+      _stats.overflows++;
 
-#define TIME_BETWEEN_CONFIG_PORTAL_LOOP       50
+      entry.body      = NULL;
+      entry.len       = 0;
+      entry.capacity  = 0;
+      entry.tooLarge  = true;
 
-    vTaskDelay(TIME_BETWEEN_CONFIG_PORTAL_LOOP / portTICK_PERIOD_MS);
+      _capturing = -1;
+
+      return;
+    }
+
+    _stats.bytes   += capacity - entry.capacity;
+    entry.body      = body;
+    entry.capacity  = capacity;
   }
 
-  //LOGDEBUG3("startConfigPortal: exit, _configPortalTimeout =", _configPortalTimeout, "millis() =", millis());
-
-  server->stop();
-  server.reset();
-  dnsServer->stop();
-  dnsServer.reset();
-
-  return  (ESP32_W5500_isConnected());
-}
+  memcpy(entry.body + entry.len, data, len);
+  entry.len += len;
+}
 
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::setTimeout(const unsigned long& seconds)
+void ESP32_EMPageCache::endCapture()
 {
-  setConfigPortalTimeout(seconds);
-}
+  if (_capturing < 0)
+    return;
 
-//////////////////////////////////////////
+  Entry& entry = _entries[_capturing];
 
-void ESP32_W5500_Manager::setConfigPortalTimeout(const unsigned long& seconds)
-{
-  _configPortalTimeout = seconds * 1000;
+  _capturing = -1;
+
+  // Nothing to cache. em_realloc() to 0 would free the buffer behind entry.body
+  if (entry.len == 0)
+  {
+    em_free(entry.body);
+
+    _stats.bytes -= entry.capacity;
+
+    entry.body      = NULL;
+    entry.capacity  = 0;
+
+    return;
+  }
+
+  // Give back what the doubling in capture() over-allocated
+  if (entry.len < entry.capacity)
+  {
+    char* body = (char*) em_realloc(EM_ALLOC_LARGE, entry.body, entry.len);
+
+    if (body != NULL)
+    {
+      _stats.bytes   -= entry.capacity - entry.len;
+      entry.body      = body;
+      entry.capacity  = entry.len;
+    }
+  }
+
+  entry.valid = true;
+
+  LOGDEBUG1(F("Page cache: cached, size ="), entry.len);
 }
 
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::setConnectTimeout(const unsigned long& seconds)
+void ESP32_EMPageCache::clear()
 {
-  _connectTimeout = seconds * 1000;
+  for (int i = 0; i < EM_PAGE_CACHE_ROUTES; i++)
+  {
+    em_free(_entries[i].body);
+  }
+
+  memset(_entries, 0, sizeof(_entries));
+
+  _capturing    = -1;
+  _stats.bytes  = 0;
 }
 
-void ESP32_W5500_Manager::setDebugOutput(bool debug)
+//////////////////////////////////////////
+
+/**
+   [getParameters description]
+   @access public
+*/
+ESP32_EMParameter** ESP32_W5500_Manager::getParameters()
 {
-  _debug = debug;
+  return _params;
 }
 
+//////////////////////////////////////////
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::setBreakAfterConfig(bool shouldBreak)
+/**
+   [getParametersCount description]
+   @access public
+*/
+int ESP32_W5500_Manager::getParametersCount()
 {
-  _shouldBreakAfterConfig = shouldBreak;
+  return _paramsCount;
 }
 
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::reportStatus(String& page)
+char* ESP32_W5500_Manager::getRFC952_hostname(const char* iHostname)
 {
-  page += FPSTR(EM_HTTP_SCRIPT_NTP_MSG);
-}
+  memset(RFC952_hostname, 0, sizeof(RFC952_hostname));
 
+  size_t len = (RFC952_HOSTNAME_MAXLEN < strlen(iHostname)) ? RFC952_HOSTNAME_MAXLEN : strlen(iHostname);
 
+  size_t j = 0;
 
-//////////////////////////////////////////
+  for (size_t i = 0; i < len - 1; i++)
+  {
+    if (isalnum(iHostname[i]) || iHostname[i] == '-')
+    {
+      RFC952_hostname[j] = iHostname[i];
+      j++;
+    }
+  }
 
-void ESP32_W5500_Manager::setSTAStaticIPConfig(const IPAddress& ip, const IPAddress& gw, const IPAddress& sn)
-{
-  LOGINFO(F("setSTAStaticIPConfig"));
+  // no '-' as last char
+  if (isalnum(iHostname[len - 1]) || (iHostname[len - 1] != '-'))
+    RFC952_hostname[j] = iHostname[len - 1];
 
-  _ETH_STA_IPconfig._sta_static_ip = ip;
-  _ETH_STA_IPconfig._sta_static_gw = gw;
-  _ETH_STA_IPconfig._sta_static_sn = sn;
+  return RFC952_hostname;
 }
 
 //////////////////////////////////////////
 
-void ESP32_W5500_Manager::setSTAStaticIPConfig(const ETH_STA_IPConfig& EM_STA_IPconfig)
+ESP32_W5500_Manager::ESP32_W5500_Manager(const char *iHostname)
 {
-  LOGINFO(F("setSTAStaticIPConfig"));
 
-  memcpy((void *) &_ETH_STA_IPconfig, &EM_STA_IPconfig, sizeof(_ETH_STA_IPconfig));
-}
+  //server    = webserver;
+  //dnsServer = dnsserver;
 
-//////////////////////////////////////////
+#if USE_DYNAMIC_PARAMS
+  _max_params = ETH_MANAGER_MAX_PARAMS;
 
-void ESP32_W5500_Manager::getSTAStaticIPConfig(ETH_STA_IPConfig& EM_STA_IPconfig)
-{
-  LOGINFO(F("getSTAStaticIPConfig"));
+#if USE_EM_PARAM_ARENA
+  _params = (ESP32_EMParameter**) ESP32_EMParamArena::instance().allocate(_max_params * sizeof(ESP32_EMParameter*),
+                                                                           sizeof(ESP32_EMParameter*));
+#else
+  _params = (ESP32_EMParameter**) em_malloc(EM_ALLOC_BULK, _max_params * sizeof(ESP32_EMParameter*));
+#endif
+#endif
 
-  memcpy((void *) &EM_STA_IPconfig, &_ETH_STA_IPconfig, sizeof(EM_STA_IPconfig));
-}
+  if (iHostname[0] == 0)
+  {
+    String _hostname = "ESP32-" + String(ESP_getChipId(), HEX);
 
+    _hostname.toUpperCase();
 
-//////////////////////////////////////////
+    getRFC952_hostname(_hostname.c_str());
 
-#if USE_CONFIGURABLE_DNS
-void ESP32_W5500_Manager::setSTAStaticIPConfig(const IPAddress& ip, const IPAddress& gw, const IPAddress& sn,
-                                               const IPAddress& dns_address_1, const IPAddress& dns_address_2)
-{
-  LOGINFO(F("setSTAStaticIPConfig for USE_CONFIGURABLE_DNS"));
+  }
+  else
+  {
+    // Prepare and store the hostname only not NULL
+    getRFC952_hostname(iHostname);
+  }
 
-  _ETH_STA_IPconfig._sta_static_ip = ip;
-  _ETH_STA_IPconfig._sta_static_gw = gw;
-  _ETH_STA_IPconfig._sta_static_sn = sn;
-  _ETH_STA_IPconfig._sta_static_dns1 = dns_address_1; //***** Added argument *****
-  _ETH_STA_IPconfig._sta_static_dns2 = dns_address_2; //***** Added argument *****
-}
+  LOGWARN1(F("RFC925 Hostname ="), RFC952_hostname);
+
+  setHostname();
+
+#if USING_CORS_FEATURE
+  buildCORSHeaderProfiles();
+#endif
+
+#if USE_EM_METRICS
+  resetMetrics();
 #endif
 
+#if USE_EM_MEMORY_STATS
+  memset(&_memoryStats, 0, sizeof(_memoryStats));
+#endif
+}
+
 //////////////////////////////////////////
 
-// Handle root or redirect to captive portal
-void ESP32_W5500_Manager::handleRoot()
+ESP32_W5500_Manager::~ESP32_W5500_Manager()
 {
-  LOGDEBUG(F("handleRoot"));
-
-  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
-  _configPortalTimeout = 0;
+#if USE_DYNAMIC_PARAMS
 
-  if (captivePortal())
+  if (_params != NULL)
   {
-    LOGDEBUG(F("handleRoot: captive portal exit"));
+    LOGINFO(F("freeing allocated params!"));
 
-    // If captive portal redirect instead of displaying the error page.
-    return;
+#if USE_EM_PARAM_ARENA
+    ESP32_EMParamArena::instance().release(_params);
+#else
+    em_free(_params);
+#endif
   }
 
-  server->sendHeader(FPSTR(EM_HTTP_CACHE_CONTROL), FPSTR(EM_HTTP_NO_STORE));
+#endif
 
-#if USING_CORS_FEATURE
-  // For configure CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
-  server->sendHeader(FPSTR(EM_HTTP_CORS), _CORS_Header);
+  if (_paramIndex != NULL)
+  {
+    em_free(_paramIndex);
+  }
+}
+
+//////////////////////////////////////////
+
+#if USE_DYNAMIC_PARAMS
+  bool ESP32_W5500_Manager::addParameter(ESP32_EMParameter *p)
+#else
+  void ESP32_W5500_Manager::addParameter(ESP32_EMParameter *p)
 #endif
+{
+#if USE_DYNAMIC_PARAMS
+
+  if (_paramsCount == _max_params)
+  {
+    // rezise the params array
+    if (!reserveParameters(_max_params + ETH_MANAGER_MAX_PARAMS))
+    {
+      return false;
+    }
+  }
+
+  _params[_paramsCount] = p;
+  _paramsCount++;
 
-  server->sendHeader(FPSTR(EM_HTTP_PRAGMA), FPSTR(EM_HTTP_NO_CACHE));
-  server->sendHeader(FPSTR(EM_HTTP_EXPIRES), "-1");
+  em_pageGeneration()++;
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
+  LOGINFO1(F("Adding parameter"), p->getID());
 
-  page.replace("{v}", "Options");
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_SCRIPT_NTP);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(EM_HTTP_HEAD_END);
+  return true;
 
-  page += FPSTR(EM_HTTP_PORTAL_OPTIONS);
-  page += F("<div class=\"msg\">");
-  reportStatus(page);
-  page += F("</div>");
-  page += FPSTR(EM_HTTP_END);
+#else
 
-  server->send(200, "text/html", page);
+  // Danger here. Better to use Tzapu way here
+  if (_paramsCount < (ETH_MANAGER_MAX_PARAMS))
+  {
+    _params[_paramsCount] = p;
+    _paramsCount++;
+
+    em_pageGeneration()++;
+
+    LOGINFO1(F("Adding parameter"), p->getID());
+  }
+  else
+  {
+    LOGINFO("Can't add parameter. Full");
+  }
+
+#endif
 }
 
 //////////////////////////////////////////
 
-// ETH config page handler
-void ESP32_W5500_Manager::handleETH()
+#if USE_DYNAMIC_PARAMS
+bool ESP32_W5500_Manager::reserveParameters(const int& count)
 {
-  LOGDEBUG(F("Handle ETH"));
+  if (count <= _max_params)
+    return true;
 
-  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
-  _configPortalTimeout = 0;
+  LOGINFO1(F("Increasing _max_params to:"), count);
 
-  server->sendHeader(FPSTR(EM_HTTP_CACHE_CONTROL), FPSTR(EM_HTTP_NO_STORE));
+#if USE_EM_PARAM_ARENA
+  // The old table stays in the arena until it is freed as a whole
+  ESP32_EMParameter** new_params = (ESP32_EMParameter**) ESP32_EMParamArena::instance().allocate(count * sizeof(
+                                     ESP32_EMParameter*), sizeof(ESP32_EMParameter*));
 
-#if USING_CORS_FEATURE
-  // For configure CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
-  server->sendHeader(FPSTR(EM_HTTP_CORS), _CORS_Header);
+  if (new_params != NULL)
+  {
+    memcpy(new_params, _params, _paramsCount * sizeof(ESP32_EMParameter*));
+    ESP32_EMParamArena::instance().release(_params);
+  }
+#else
+  ESP32_EMParameter** new_params = (ESP32_EMParameter**) em_realloc(EM_ALLOC_BULK, _params, count * sizeof(ESP32_EMParameter*));
 #endif
 
-  server->sendHeader(FPSTR(EM_HTTP_PRAGMA), FPSTR(EM_HTTP_NO_CACHE));
-  server->sendHeader(FPSTR(EM_HTTP_EXPIRES), "-1");
+  if (new_params == NULL)
+  {
+    LOGINFO(F("ERROR: failed to realloc params, size not increased!"));
+
+    return false;
+  }
+
+  _params     = new_params;
+  _max_params = count;
+
+  return true;
+}
+#endif
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
+//////////////////////////////////////////
 
-  page.replace("{v}", "Config ESP");
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_SCRIPT_NTP);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(EM_HTTP_HEAD_END);
-  page += F("<h2>Configuration</h2>");
+void ESP32_W5500_Manager::buildParamIndex()
+{
+  uint16_t* newIndex = (uint16_t*) em_realloc(EM_ALLOC_HOT, _paramIndex, (_paramsCount > 0 ? _paramsCount : 1) * sizeof(uint16_t));
 
-  page += FPSTR(EM_HTTP_FORM_START);
+  if (newIndex == NULL)
+  {
+    LOGERROR(F("Can't allocate param index"));
 
-  char parLength[2];
+    return;
+  }
 
-  page += FPSTR(EM_FLDSET_START);
+  _paramIndex       = newIndex;
+  _paramIndexCount  = 0;
+  _paramIndexParams = _paramsCount;
 
-  // add the extra parameters to the form
+  // Insertion sort by ID, done once per Config Portal. Custom HTML-only params have no ID
   for (int i = 0; i < _paramsCount; i++)
   {
-    if (_params[i] == NULL)
+    if ( (_params[i] == NULL) || (_params[i]->getID() == NULL) || (_params[i]->_EMParam_data._value == NULL) )
+      continue;
+
+    int j = _paramIndexCount++;
+
+    while ( (j > 0) && (strcmp(_params[_paramIndex[j - 1]]->getID(), _params[i]->getID()) > 0) )
     {
-      break;
+      _paramIndex[j] = _paramIndex[j - 1];
+      j--;
     }
 
-    String pitem;
+    _paramIndex[j] = i;
+  }
 
-    switch (_params[i]->getLabelPlacement())
-    {
-      case WFM_LABEL_BEFORE:
-        pitem = FPSTR(EM_HTTP_FORM_LABEL_BEFORE);
-        break;
+  LOGDEBUG1(F("Param index built, count ="), _paramIndexCount);
+}
 
-      case WFM_LABEL_AFTER:
-        pitem = FPSTR(EM_HTTP_FORM_LABEL_AFTER);
-        break;
+//////////////////////////////////////////
 
-      default:
-        // WFM_NO_LABEL
-        pitem = FPSTR(EM_HTTP_FORM_PARAM);
-        break;
-    }
+int ESP32_W5500_Manager::findParam(const char* id)
+{
+  int low  = 0;
+  int high = _paramIndexCount;
 
-    if (_params[i]->getID() != NULL)
-    {
-      pitem.replace("{i}", _params[i]->getID());
-      pitem.replace("{n}", _params[i]->getID());
-      pitem.replace("{p}", _params[i]->getPlaceholder());
+  while (low < high)
+  {
+    int middle = (low + high) / 2;
+    int result = strcmp(id, _params[_paramIndex[middle]]->getID());
 
-      snprintf(parLength, 2, "%d", _params[i]->getValueLength());
+    if (result == 0)
+      return _paramIndex[middle];
 
-      pitem.replace("{l}", parLength);
-      pitem.replace("{v}", _params[i]->getValue());
-      pitem.replace("{c}", _params[i]->getCustomHTML());
-    }
+    if (result < 0)
+      high = middle;
     else
-    {
-      pitem = _params[i]->getCustomHTML();
-    }
-
-    page += pitem;
+      low = middle + 1;
   }
 
-  if (_paramsCount > 0)
-  {
-    page += FPSTR(EM_FLDSET_END);
-  }
+  return -1;
+}
 
-  if (_params[0] != NULL)
-  {
-    page += "<br/>";
-  }
+//////////////////////////////////////////
 
-  LOGDEBUG1(F("Static IP ="), _ETH_STA_IPconfig._sta_static_ip.toString());
+void ESP32_W5500_Manager::setupConfigPortal()
+{
+  stopConfigPortal = false; //Signal not to close config portal
 
-  // KH, Comment out to permit changing from DHCP to static IP, or vice versa
-  // and add staticIP label in CP
+#if USE_EM_MEMORY_STATS
+  // Before the servers are allocated, to compare with the sample taken after they are freed
+  _memoryStats.sessionStopFreeHeap        = 0;
+  _memoryStats.sessionMinLargestFreeBlock = 0;
 
-  // To permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
-  // You'll loose the feature of dynamically changing from DHCP to static IP, or vice versa
-  // You have to explicitly specify false to disable the feature.
+  sampleMemory();
+
+  _memoryStats.sessionStartFreeHeap = _memoryStats.freeHeap;
+  _memoryStats.sessions++;
+#endif
+
+  dnsServer.reset(em_new<EM_DNSServer>(EM_ALLOC_HOT));
+
+  server.reset(em_new<ESP32_EMWebServer>(EM_ALLOC_HOT, HTTP_PORT_TO_USE));
+
+  /* Setup the DNS server redirecting all the domains to the apIP */
+  if (dnsServer)
+  {
+    dnsServer->setErrorReplyCode(DNSReplyCode::NoError);
+
+    // AsyncDNSServer started with "*" domain name, all DNS requests will be passsed to ETH.localIP()
+    if (! dnsServer->start(DNS_PORT, "*", ETH.localIP()))
+    {
+      // No socket available
+      LOGERROR(F("Can't start DNS Server. No available socket"));
+    }
+  }
+  else
+  {
+    // No space available
+    LOGERROR(F("Can't initiate DNS Server. No enough space"));
+  }
+
+  _configPortalStart = millis();
+
+  LOGDEBUG1(F("_configPortalStart millis() ="), millis());
+
+  LOGWARN1(F("Config Portal IP address ="), ETH.localIP());
+
+  buildParamIndex();
+
+  /* Setup web pages: root, eth config pages, SO captive portal detectors and not found. */
+
+  onRoute("/",         EM_ROUTE_ROOT,      &ESP32_W5500_Manager::handleRoot);
+  onRoute("/eth",      EM_ROUTE_ETH,       &ESP32_W5500_Manager::handleETH);
+  onRoute("/ethsave",  EM_ROUTE_ETHSAVE,   &ESP32_W5500_Manager::handleETHSave);
+  onRoute("/close",    EM_ROUTE_CLOSE,     &ESP32_W5500_Manager::handleServerClose);
+  onRoute("/i",        EM_ROUTE_INFO,      &ESP32_W5500_Manager::handleInfo);
+  onRoute("/r",        EM_ROUTE_RESET,     &ESP32_W5500_Manager::handleReset);
+  onRoute("/state",    EM_ROUTE_STATE,     &ESP32_W5500_Manager::handleState);
+  onRoute("/em.css",   EM_ROUTE_STYLE,     &ESP32_W5500_Manager::handleStyle);
+#if USING_EM_TZ_JS_ASSET
+  onRoute("/tz.js",    EM_ROUTE_TZ_JS,     &ESP32_W5500_Manager::handleTZScript);
+#endif
+#if USE_EM_METRICS
+  onRoute("/metrics",  EM_ROUTE_METRICS,   &ESP32_W5500_Manager::handleMetrics);
+#endif
+  //Microsoft captive portal. Maybe not needed. Might be handled by notFound handler.
+  onRoute("/fwlink",   EM_ROUTE_ROOT,      &ESP32_W5500_Manager::handleRoot);
+
+  for (const char* path : EM_CAPTIVE_PROBE_PATHS)
+  {
+    onRoute(path,      EM_ROUTE_CAPTIVE,   &ESP32_W5500_Manager::handleCaptiveProbe);
+  }
+
+  onRoute(NULL,        EM_ROUTE_NOT_FOUND, &ESP32_W5500_Manager::handleNotFound);
+
+  // Needed to answer conditional requests for the cacheable assets
+  const char* headerKeys[] = { EM_HTTP_IF_NONE_MATCH };
+  server->collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+
+  server->begin(); // Web server start
+
+  LOGWARN(F("HTTP server started"));
+}
+
+//////////////////////////////////////////
+
+bool ESP32_W5500_Manager::startConfigPortal()
+{
+  // Would rebuild the servers under a running process() or task
+  if (_configPortalActive)
+  {
+    LOGERROR(F("Config Portal already active"));
+
+    return false;
+  }
+
+  connect = false;
+
+  setupConfigPortal();
+
+  _configPortalActive = true;
+
+  if (!_configPortalBlocking)
+  {
+    LOGINFO("startConfigPortal : Non-blocking, call process() in loop()");
+
+    return false;
+  }
+
+  LOGINFO("startConfigPortal : Enter loop");
+
+  while (!handleConfigPortal())
+  {
+    vTaskDelay(TIME_BETWEEN_CONFIG_PORTAL_LOOP / portTICK_PERIOD_MS);
+  }
+
+  //LOGDEBUG3("startConfigPortal: exit, _configPortalTimeout =", _configPortalTimeout, "millis() =", millis());
+
+  stopConfigPortalServers();
+
+  // Closed with a restart scheduled, e.g. by the save callback
+  while (_restartScheduled)
+  {
+    handleScheduledRestart();
+    vTaskDelay(TIME_BETWEEN_CONFIG_PORTAL_LOOP / portTICK_PERIOD_MS);
+  }
+
+  return  (ESP32_W5500_isConnected());
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setConfigPortalBlocking(const bool& shouldBlock)
+{
+  _configPortalBlocking = shouldBlock;
+}
+
+//////////////////////////////////////////
+
+bool ESP32_W5500_Manager::process()
+{
+  // The task runs the Config Portal, and the scheduled restart
+  if (_configPortalTaskHandle != NULL)
+  {
+    return false;
+  }
+
+  if (!_configPortalActive)
+  {
+    // Scheduled before the Config Portal closed. While it's open, handleConfigPortal() checks it
+    handleScheduledRestart();
+
+    return false;
+  }
+
+  if (!handleConfigPortal())
+  {
+    return false;
+  }
+
+  stopConfigPortalServers();
+
+  return true;
+}
+
+//////////////////////////////////////////
+
+bool ESP32_W5500_Manager::startConfigPortalTask(const UBaseType_t& priority, const uint32_t& stackSize)
+{
+  if (_configPortalActive)
+  {
+    LOGERROR(F("Config Portal already active"));
+
+    return false;
+  }
+
+  connect = false;
+
+  setupConfigPortal();
+
+  _configPortalActive = true;
+
+  if (xTaskCreate(configPortalTask, "EM_Portal", stackSize, this, priority, &_configPortalTaskHandle) != pdPASS)
+  {
+    LOGERROR(F("Can't create Config Portal task"));
+
+    _configPortalTaskHandle = NULL;
+
+    stopConfigPortalServers();
+
+    return false;
+  }
+
+  LOGINFO1(F("startConfigPortalTask : priority ="), priority);
+
+  return true;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::configPortalTask(void* param)
+{
+  ESP32_W5500_Manager* manager = (ESP32_W5500_Manager*) param;
+
+  // Only give up the CPU for one tick, so requests aren't delayed by a long polling interval
+  while (!manager->handleConfigPortal())
+  {
+    vTaskDelay(1);
+  }
+
+  manager->stopConfigPortalServers();
+
+  while (manager->_restartScheduled)
+  {
+    manager->handleScheduledRestart();
+    vTaskDelay(TIME_BETWEEN_CONFIG_PORTAL_LOOP / portTICK_PERIOD_MS);
+  }
+
+  manager->_configPortalTaskHandle = NULL;
+
+  vTaskDelete(NULL);
+}
+
+//////////////////////////////////////////
+
+// One Config Portal iteration. Returns true when the Config Portal has to be closed
+bool ESP32_W5500_Manager::handleConfigPortal()
+{
+  //DNS
+#if (USE_EM_METRICS && USE_EM_CAPTIVE_DNS)
+  uint32_t dnsStart = micros();
+
+  dnsServer->processNextRequest();
+
+  EM_DNSStats dnsStats;
+
+  dnsServer->getStats(dnsStats);
+
+  // Polling an empty socket says nothing about the DNS latency
+  if (dnsStats.lastBurst > 0)
+  {
+    recordRoute(EM_ROUTE_DNS, micros() - dnsStart, 0, false);
+  }
+#else
+  dnsServer->processNextRequest();
+#endif
+  //HTTP
+  server->handleClient();
+
+#if ( USING_ESP32_S2 || USING_ESP32_C3 )
+  // Fix ESP32-S2 issue with WebServer (https://github.com/espressif/arduino-esp32/issues/4348)
+  delay(1);
+#endif
+
+  handleScheduledRestart();
+
+  // Only set by a save which changed something
+  if (connect)
+  {
+    if (_shouldBreakAfterConfig)
+    {
+      //flag set to exit after config after trying to connect
+      //notify that configuration has changed and any optional parameters should be saved
+      if (_savecallback != NULL)
+      {
+        _savecallback();
+      }
+
+      if (_changeSetCallback != NULL)
+      {
+        _changeSetCallback(_changes);
+      }
+
+      LOGDEBUG("Stop ConfigPortal: _shouldBreakAfterConfig");
+
+      return true;
+    }
+  }
+
+  if (stopConfigPortal)
+  {
+    LOGERROR("stopConfigPortal");
+
+    stopConfigPortal = false;
+
+    return true;
+  }
+
+  if (_configPortalTimeout > 0 && ( millis() > _configPortalStart + _configPortalTimeout) )
+  {
+    //LOGDEBUG3("startConfigPortal: timeout, _configPortalTimeout =", _configPortalTimeout, "millis() =", millis());
+
+    stopConfigPortal = false;
+
+    return true;
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::stopConfigPortalServers()
+{
+  server->stop();
+  server.reset();
+  dnsServer->stop();
+  dnsServer.reset();
+
+#if USE_EM_PAGE_CACHE
+  _pageCache.clear();
+#endif
+
+  _configPortalActive = false;
+
+#if USE_EM_MEMORY_STATS
+  sampleMemory();
+
+  _memoryStats.sessionStopFreeHeap = _memoryStats.freeHeap;
+#endif
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setTimeout(const unsigned long& seconds)
+{
+  setConfigPortalTimeout(seconds);
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setConfigPortalTimeout(const unsigned long& seconds)
+{
+  _configPortalTimeout = seconds * 1000;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setConnectTimeout(const unsigned long& seconds)
+{
+  _connectTimeout = seconds * 1000;
+}
+
+void ESP32_W5500_Manager::setDebugOutput(bool debug)
+{
+  _debug = debug;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setBreakAfterConfig(bool shouldBreak)
+{
+  _shouldBreakAfterConfig = shouldBreak;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::reportStatus(ESP32_EMPageWriter& page)
+{
+  page.print(FPSTR(EM_HTTP_SCRIPT_NTP_MSG));
+}
+
+//////////////////////////////////////////
+
+// Write EM_HTTP_HEAD_START, with the {v} placeholder replaced by the page title
+void ESP32_W5500_Manager::writeHeadStart(ESP32_EMPageWriter& page, const char* title)
+{
+  EM_TemplateArgs args = { NULL, NULL, 0, title, NULL };
+
+  page.printTemplate(EM_TPL_HEAD_START, args);
+}
+
+//////////////////////////////////////////
+
+// Write one of the Static IP config fields, as EM_HTTP_FORM_LABEL + EM_HTTP_FORM_PARAM
+void ESP32_W5500_Manager::writeIPField(ESP32_EMPageWriter& page, const char* id, const char* label, const IPAddress& ip)
+{
+  char ipString[EM_IPV4_STRLEN];
+
+  em_formatIPv4(ip, ipString);
+
+  EM_TemplateArgs args = { id, label, 15, ipString, "" };
+
+  page.printTemplate(EM_TPL_FORM_LABEL, args);
+  page.printTemplate(EM_TPL_FORM_PARAM, args);
+}
+
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setSTAStaticIPConfig(const IPAddress& ip, const IPAddress& gw, const IPAddress& sn)
+{
+  LOGINFO(F("setSTAStaticIPConfig"));
+
+  _ETH_STA_IPconfig._sta_static_ip = ip;
+  _ETH_STA_IPconfig._sta_static_gw = gw;
+  _ETH_STA_IPconfig._sta_static_sn = sn;
+
+  em_pageGeneration()++;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::setSTAStaticIPConfig(const ETH_STA_IPConfig& EM_STA_IPconfig)
+{
+  LOGINFO(F("setSTAStaticIPConfig"));
+
+  memcpy((void *) &_ETH_STA_IPconfig, &EM_STA_IPconfig, sizeof(_ETH_STA_IPconfig));
+
+  em_pageGeneration()++;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::getSTAStaticIPConfig(ETH_STA_IPConfig& EM_STA_IPconfig)
+{
+  LOGINFO(F("getSTAStaticIPConfig"));
+
+  memcpy((void *) &EM_STA_IPconfig, &_ETH_STA_IPconfig, sizeof(EM_STA_IPconfig));
+}
+
+
+//////////////////////////////////////////
+
+#if USE_CONFIGURABLE_DNS
+void ESP32_W5500_Manager::setSTAStaticIPConfig(const IPAddress& ip, const IPAddress& gw, const IPAddress& sn,
+                                               const IPAddress& dns_address_1, const IPAddress& dns_address_2)
+{
+  LOGINFO(F("setSTAStaticIPConfig for USE_CONFIGURABLE_DNS"));
+
+  _ETH_STA_IPconfig._sta_static_ip = ip;
+  _ETH_STA_IPconfig._sta_static_gw = gw;
+  _ETH_STA_IPconfig._sta_static_sn = sn;
+  _ETH_STA_IPconfig._sta_static_dns1 = dns_address_1; //***** Added argument *****
+  _ETH_STA_IPconfig._sta_static_dns2 = dns_address_2; //***** Added argument *****
+
+  em_pageGeneration()++;
+}
+#endif
+
+//////////////////////////////////////////
+
+// Handle root or redirect to captive portal
+void ESP32_W5500_Manager::handleRoot()
+{
+  LOGDEBUG(F("handleRoot"));
+
+  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
+  _configPortalTimeout = 0;
+
+  if (captivePortal())
+  {
+    LOGDEBUG(F("handleRoot: captive portal exit"));
+
+    // If captive portal redirect instead of displaying the error page.
+    return;
+  }
+
+  if (sendPageHeaders(EM_ROUTE_ROOT))
+    return;
+
+  ESP32_EMPageWriter page(server.get());
+
+  if (sendCachedPage(EM_ROUTE_ROOT, page))
+    return;
+
+  page.begin(200, EM_HTTP_HEAD_CT);
+
+  writeHeadStart(page, "Options");
+  page.print(FPSTR(EM_HTTP_SCRIPT));
+  page.print(FPSTR(EM_HTTP_SCRIPT_NTP_LINK));
+  page.print(FPSTR(EM_HTTP_STYLE_LINK));
+  page.print(_customHeadElement);
+  page.print(FPSTR(EM_HTTP_HEAD_END));
+
+  page.print(FPSTR(EM_HTTP_PORTAL_OPTIONS));
+  page.print(F("<div class=\"msg\">"));
+  reportStatus(page);
+  page.print(F("</div>"));
+  page.print(FPSTR(EM_HTTP_END));
+
+  page.end();
+}
+
+//////////////////////////////////////////
+
+// ETH config page handler
+void ESP32_W5500_Manager::handleETH()
+{
+  LOGDEBUG(F("Handle ETH"));
+
+  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
+  _configPortalTimeout = 0;
+
+  if (sendPageHeaders(EM_ROUTE_ETH))
+    return;
+
+  ESP32_EMPageWriter page(server.get());
+
+  if (sendCachedPage(EM_ROUTE_ETH, page))
+    return;
+
+  page.begin(200, EM_HTTP_HEAD_CT);
+
+  writeHeadStart(page, "Config ESP");
+  page.print(FPSTR(EM_HTTP_SCRIPT));
+  page.print(FPSTR(EM_HTTP_SCRIPT_NTP_LINK));
+  page.print(FPSTR(EM_HTTP_STYLE_LINK));
+  page.print(_customHeadElement);
+  page.print(FPSTR(EM_HTTP_HEAD_END));
+  page.print(F("<h2>Configuration</h2>"));
+
+  page.print(FPSTR(EM_HTTP_FORM_START));
+
+  page.print(FPSTR(EM_FLDSET_START));
+
+  // add the extra parameters to the form
+  for (int i = 0; i < _paramsCount; i++)
+  {
+    if (_params[i] == NULL)
+    {
+      break;
+    }
+
+    if (_params[i]->getID() == NULL)
+    {
+      page.print(_params[i]->getCustomHTML());
+
+      continue;
+    }
+
+    EM_TemplateArgs args = { _params[i]->getID(), _params[i]->getPlaceholder(), _params[i]->getValueLength(),
+                             _params[i]->getValue(), _params[i]->getCustomHTML()
+                           };
+
+    switch (_params[i]->getLabelPlacement())
+    {
+      case WFM_LABEL_BEFORE:
+        page.printTemplate(EM_TPL_FORM_LABEL_BEFORE, args);
+        break;
+
+      case WFM_LABEL_AFTER:
+        page.printTemplate(EM_TPL_FORM_LABEL_AFTER, args);
+        break;
+
+      default:
+        // WFM_NO_LABEL
+        page.printTemplate(EM_TPL_FORM_PARAM, args);
+        break;
+    }
+  }
+
+  if (_paramsCount > 0)
+  {
+    page.print(FPSTR(EM_FLDSET_END));
+
+    if (_params[0] != NULL)
+    {
+      page.print(F("<br/>"));
+    }
+  }
+
+  LOGDEBUG1(F("Static IP ="), _ETH_STA_IPconfig._sta_static_ip.toString());
+
+  // KH, Comment out to permit changing from DHCP to static IP, or vice versa
+  // and add staticIP label in CP
+
+  // To permit disable/enable StaticIP configuration in Config Portal from sketch. Valid only if DHCP is used.
+  // You'll loose the feature of dynamically changing from DHCP to static IP, or vice versa
+  // You have to explicitly specify false to disable the feature.
 
 #if !USE_STATIC_IP_CONFIG_IN_CP
 
-  if (_ETH_STA_IPconfig._sta_static_ip)
-#endif
-  {
-    page += FPSTR(EM_FLDSET_START);
+  if (_ETH_STA_IPconfig._sta_static_ip)
+#endif
+  {
+    page.print(FPSTR(EM_FLDSET_START));
+
+    writeIPField(page, "ip", "Static IP",  _ETH_STA_IPconfig._sta_static_ip);
+    writeIPField(page, "gw", "Gateway IP", _ETH_STA_IPconfig._sta_static_gw);
+    writeIPField(page, "sn", "Subnet",     _ETH_STA_IPconfig._sta_static_sn);
+
+#if USE_CONFIGURABLE_DNS
+    //***** Added for DNS address options *****
+    writeIPField(page, "dns1", "DNS1 IP", _ETH_STA_IPconfig._sta_static_dns1);
+    writeIPField(page, "dns2", "DNS2 IP", _ETH_STA_IPconfig._sta_static_dns2);
+    //***** End added for DNS address options *****
+#endif
+
+    page.print(FPSTR(EM_FLDSET_END));
+
+    page.print(F("<br/>"));
+  }
+
+  page.print(FPSTR(EM_HTTP_SCRIPT_NTP_HIDDEN));
+
+  page.print(FPSTR(EM_HTTP_FORM_END));
+
+  page.print(FPSTR(EM_HTTP_END));
+
+  page.end();
+
+  LOGDEBUG(F("Sent config page"));
+}
+
+//////////////////////////////////////////
+
+// Handle the WLAN save form and redirect to WLAN config page again
+void ESP32_W5500_Manager::handleETHSave()
+{
+  LOGDEBUG(F("ETH save"));
+
+  sendHeaderProfile(EM_HEADERS_PAGE);
+
+  // Params added after the Config Portal started
+  if (_paramIndexParams != _paramsCount)
+  {
+    buildParamIndex();
+  }
+
+  memset(&_changes, 0, sizeof(_changes));
+
+  for (int i = 0; i < _paramIndexCount; i++)
+  {
+    _params[_paramIndex[i]]->_changed   = false;
+    _params[_paramIndex[i]]->_submitted = false;
+  }
+
+  const char* ipName[]      = { "ip", "gw", "sn", "dns1", "dns2" };
+  IPAddress*  ipTarget[]    = { &_ETH_STA_IPconfig._sta_static_ip, &_ETH_STA_IPconfig._sta_static_gw,
+                                &_ETH_STA_IPconfig._sta_static_sn, &_ETH_STA_IPconfig._sta_static_dns1,
+                                &_ETH_STA_IPconfig._sta_static_dns2
+                              };
+
+#if USE_CONFIGURABLE_DNS
+  const uint8_t ipFields = 5;
+#else
+  const uint8_t ipFields = 3;
+#endif
+
+  // EM_CHANGED_xxx bits of the IP fields already taken, so that the first of duplicated args wins as for params
+  uint8_t ipSubmitted = 0;
+
+#if USE_ESP_ETH_MANAGER_NTP
+  bool    tzSubmitted = false;
+#endif
+
+  // Single pass over the submitted args
+  for (int i = 0; i < server->args(); i++)
+  {
+    const char* name  = server->argNameRef(i).c_str();
+    const String& arg = server->argRef(i);
+
+    int index = findParam(name);
+
+    if (index >= 0)
+    {
+      ESP32_EMParameter* param  = _params[index];
+      EMParam_Data& data        = param->_EMParam_data;
+
+      if (param->_submitted)
+        continue;
+
+      param->_submitted = true;
+
+      // Only the first _length chars are kept
+      if (strncmp(data._value, arg.c_str(), data._length) != 0)
+      {
+        strncpy(data._value, arg.c_str(), data._length);
+        data._value[data._length] = 0;
+
+        param->_changed = true;
+        _changes.params++;
+
+        LOGDEBUG2(F("Parameter and value :"), name, data._value);
+      }
+
+      continue;
+    }
+
+    if (arg.length() == 0)
+      continue;
+
+    for (uint8_t field = 0; field < ipFields; field++)
+    {
+      uint8_t bit = 1 << field;
+
+      if ( (ipSubmitted & bit) || (strcmp(name, ipName[field]) != 0) )
+        continue;
+
+      ipSubmitted |= bit;
+
+      if (updateIP(*ipTarget[field], arg.c_str()))
+      {
+        _changes.ipConfig |= bit;
+
+        LOGDEBUG2(F("New Static"), name, *ipTarget[field]);
+      }
+
+      break;
+    }
+
+#if USE_ESP_ETH_MANAGER_NTP
+
+    if (!tzSubmitted && (strcmp(name, "timezone") == 0))
+    {
+      tzSubmitted = true;
+
+      if (_timezoneName != arg)
+      {
+        _timezoneName = arg;
+        _changes.timezone = true;
+
+        LOGDEBUG1(F("TZ name ="), _timezoneName);
+      }
+    }
+
+#endif
+  }
+
+  // Params not submitted are cleared, as before
+  for (int i = 0; i < _paramIndexCount; i++)
+  {
+    ESP32_EMParameter* param = _params[_paramIndex[i]];
+
+    if (!param->_submitted && (param->_EMParam_data._value[0] != 0))
+    {
+      param->_EMParam_data._value[0] = 0;
+
+      param->_changed = true;
+      _changes.params++;
+    }
+  }
+
+  ESP32_EMPageWriter page(server.get());
+
+  page.begin(200, EM_HTTP_HEAD_CT);
+
+  writeHeadStart(page, "Credentials Saved");
+  page.print(FPSTR(EM_HTTP_SCRIPT));
+  page.print(FPSTR(EM_HTTP_STYLE_LINK));
+  page.print(_customHeadElement);
+  page.print(FPSTR(EM_HTTP_HEAD_END));
+  page.print(FPSTR(EM_HTTP_SAVED));
+
+  page.print(FPSTR(EM_HTTP_END));
+
+  page.end();
+
+  LOGDEBUG(F("Sent eth save page"));
+
+  LOGINFO3(F("Changed: IP fields ="), _changes.ipConfig, F(", params ="), _changes.params);
+
+  // Nothing to save or reconnect for, when nothing changed
+  connect = _changes.hasChanges(); //signal ready to connect/reset
+
+  // The /eth form shows the saved values from now on
+  if (connect)
+    em_pageGeneration()++;
+
+  stopConfigPortal = true; //signal ready to shutdown config portal
+
+  // Restore when Press Save WiFi
+  _configPortalTimeout = DEFAULT_PORTAL_TIMEOUT;
+}
+
+//////////////////////////////////////////
+
+// Handle shut down the server page
+void ESP32_W5500_Manager::handleServerClose()
+{
+  LOGDEBUG(F("Server Close"));
+
+  sendHeaderProfile(EM_HEADERS_PAGE);
+
+  ESP32_EMPageWriter page(server.get());
+
+  page.begin(200, EM_HTTP_HEAD_CT);
+
+  writeHeadStart(page, "Close Server");
+  page.print(FPSTR(EM_HTTP_SCRIPT));
+  page.print(FPSTR(EM_HTTP_STYLE_LINK));
+  page.print(_customHeadElement);
+  page.print(FPSTR(EM_HTTP_HEAD_END));
+  page.print(F("<div class=\"msg\">"));
+  page.print(F("</b><br>"));
+  page.print(F("IP address is <b>"));
+  page.print(ETH.localIP());
+  page.print(F("</b><br><br>"));
+  page.print(F("Portal closed...<br><br>"));
+
+  //page.print(F("Push button on device to restart configuration server!"));
+
+  page.print(FPSTR(EM_HTTP_END));
+
+  page.end();
+
+  stopConfigPortal = true; //signal ready to shutdown config portal
+
+  LOGDEBUG(F("Sent server close page"));
+
+  // Restore when Press Save WiFi
+  _configPortalTimeout = DEFAULT_PORTAL_TIMEOUT;
+}
+
+//////////////////////////////////////////
+
+// Handle the info page
+void ESP32_W5500_Manager::handleInfo()
+{
+  LOGDEBUG(F("Info"));
+
+  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
+  _configPortalTimeout = 0;
+
+  sendHeaderProfile(EM_HEADERS_PAGE);
+
+  ESP32_EMPageWriter page(server.get());
+
+  page.begin(200, EM_HTTP_HEAD_CT);
+
+  writeHeadStart(page, "Info");
+  page.print(FPSTR(EM_HTTP_SCRIPT));
+  page.print(FPSTR(EM_HTTP_SCRIPT_NTP_LINK));
+  page.print(FPSTR(EM_HTTP_STYLE_LINK));
+  page.print(_customHeadElement);
+
+  if (connect)
+    page.print(F("<meta http-equiv=\"refresh\" content=\"5; url=/i\">"));
+
+  page.print(FPSTR(EM_HTTP_HEAD_END));
+
+  page.print(F("<dl>"));
+
+  if (connect)
+  {
+    page.print(F("<dt>Trying to connect</dt><dd>"));
+    page.print((int) ethStatus);
+    page.print(F("</dd>"));
+  }
+
+  page.print(pager);
+  page.print(F("<h2>Information</h2>"));
+
+  reportStatus(page);
+
+  page.print(FPSTR(EM_FLDSET_START));
+  page.print(F("<h3>Device Data</h3>"));
+  page.print(F("<table class=\"table\">"));
+  page.print(F("<thead><tr><th>Name</th><th>Value</th></tr></thead><tbody><tr><td>Chip ID</td><td>"));
+
+  page.print(ESP_getChipId(), HEX);
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>Chip OUI</td><td>"));
+  page.print(F("0x"));
+  page.print(getChipOUI(), HEX);
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>Chip Model</td><td>"));
+  page.print(ESP.getChipModel());
+  page.print(F(" Rev"));
+  page.print(ESP.getChipRevision());
+
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>Flash Chip ID</td><td>"));
+
+  // TODO
+  page.print(F("TODO"));
+
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>IDE Flash Size</td><td>"));
+  page.print(ESP.getFlashChipSize());
+  page.print(F(" bytes</td></tr>"));
+
+  page.print(F("<tr><td>Real Flash Size</td><td>"));
+
+  // TODO
+  page.print(F("TODO"));
+
+  page.print(F(" bytes</td></tr>"));
+
+  page.print(F("<tr><td>Station IP</td><td>"));
+  page.print(ETH.localIP());
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>Station MAC</td><td>"));
+  page.print(ETH.macAddress());
+  page.print(F("</td></tr>"));
+  page.print(F("</tbody></table>"));
+
+  page.print(FPSTR(EM_FLDSET_END));
+
+#if USE_EM_MEMORY_STATS
+  writeMemoryStats(page);
+#endif
+
+#if USE_AVAILABLE_PAGES
+  page.print(FPSTR(EM_FLDSET_START));
+  page.print(FPSTR(EM_HTTP_AVAILABLE_PAGES));
+  page.print(FPSTR(EM_FLDSET_END));
+#endif
+
+  page.print(F("<p/>More information about ESP32_W5500_Manager at"));
+  page.print(F("<p/><a href=\"https://github.com/khoih-prog/ESP32_W5500_Manager\">https://github.com/khoih-prog/ESP32_W5500_Manager</a>"));
+  page.print(FPSTR(EM_HTTP_END));
+
+  page.end();
+
+  LOGDEBUG(F("Sent info page"));
+}
+
+//////////////////////////////////////////
+
+// Handle the state page
+void ESP32_W5500_Manager::writeJsonIP(ESP32_EMPageWriter& page, const char* key, const IPAddress& ip)
+{
+  char ipString[EM_IPV4_STRLEN];
+
+  em_formatIPv4(ip, ipString);
+
+  page.printJsonString(key);
+  page.write(':');
+  page.printJsonString(ipString);
+}
+
+//////////////////////////////////////////
+
+// Streamed straight into the chunk buffer, no String or JSON document is built
+void ESP32_W5500_Manager::handleState()
+{
+  LOGDEBUG(F("State-Json"));
+
+  sendHeaderProfile(EM_HEADERS_JSON);
+
+  ESP32_EMPageWriter page(server.get());
+
+  page.begin(200, EM_HTTP_HEAD_JSON);
+
+  page.print(F("{\"chipId\":\""));
+  page.print(ESP_getChipId(), HEX);
+  page.print(F("\",\"linkUp\":"));
+  page.print(ETH.linkUp() ? F("true") : F("false"));
+  page.print(F(",\"connected\":"));
+  page.print(ESP32_W5500_isConnected() ? F("true") : F("false"));
+
+  page.print(F(",\"ipConfig\":{"));
+  writeJsonIP(page, "ip",   _ETH_STA_IPconfig._sta_static_ip);
+  page.write(',');
+  writeJsonIP(page, "gw",   _ETH_STA_IPconfig._sta_static_gw);
+  page.write(',');
+  writeJsonIP(page, "sn",   _ETH_STA_IPconfig._sta_static_sn);
+  page.write(',');
+  writeJsonIP(page, "dns1", _ETH_STA_IPconfig._sta_static_dns1);
+  page.write(',');
+  writeJsonIP(page, "dns2", _ETH_STA_IPconfig._sta_static_dns2);
+
+  page.print(F("},\"timezone\":"));
+#if USE_ESP_ETH_MANAGER_NTP
+  page.printJsonString(_timezoneName.c_str());
+#else
+  page.print(F("\"\""));
+#endif
+  page.print(F(",\"uptime\":"));
+  page.print(millis() - _configPortalStart);
+
+  page.print(F(",\"params\":["));
+
+  bool first = true;
+
+  for (int i = 0; i < _paramsCount; i++)
+  {
+    // Custom HTML-only params carry no value
+    if ( (_params[i] == NULL) || (_params[i]->getID() == NULL) )
+      continue;
+
+    if (!first)
+      page.write(',');
+
+    first = false;
+
+    page.print(F("{\"id\":"));
+    page.printJsonString(_params[i]->getID());
+    page.print(F(",\"value\":"));
+    page.printJsonString(_params[i]->getValue());
+    page.write('}');
+  }
+
+  page.print(F("]}"));
+
+  page.end();
+
+  LOGDEBUG1(F("Sent state page in json format, len ="), page.getBytesWritten());
+}
+
+//////////////////////////////////////////
+
+// Handle the reset page
+void ESP32_W5500_Manager::handleReset()
+{
+  LOGDEBUG(F("Reset"));
+
+  sendHeaderProfile(EM_HEADERS_NO_CACHE);
+
+  {
+    ESP32_EMPageWriter page(server.get());
+
+    page.begin(200, EM_HTTP_HEAD_CT);
+
+    writeHeadStart(page, "ETH Information");
+    page.print(FPSTR(EM_HTTP_SCRIPT));
+    page.print(FPSTR(EM_HTTP_STYLE_LINK));
+    page.print(_customHeadElement);
+    page.print(FPSTR(EM_HTTP_HEAD_END));
+    page.print(F("Resetting"));
+    page.print(FPSTR(EM_HTTP_END));
+
+    page.end();
+  }
+
+  LOGDEBUG(F("Sent reset page"));
+
+  // Not delay() here, which would stop the whole Config Portal until the restart
+  scheduleRestart();
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::scheduleRestart(const uint32_t& delayMs)
+{
+  LOGWARN1(F("Restart in ms ="), delayMs);
+
+  _restartAt        = millis() + delayMs;
+  _restartScheduled = true;
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::cancelRestart()
+{
+  LOGWARN(F("Restart cancelled"));
+
+  _restartScheduled = false;
+}
+
+//////////////////////////////////////////
 
-    String item = FPSTR(EM_HTTP_FORM_LABEL);
+void ESP32_W5500_Manager::setPreRestartCallback(void(*func)())
+{
+  _preRestartCallback = func;
+}
 
-    item += FPSTR(EM_HTTP_FORM_PARAM);
+//////////////////////////////////////////
 
-    item.replace("{i}", "ip");
-    item.replace("{n}", "ip");
-    item.replace("{p}", "Static IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _ETH_STA_IPconfig._sta_static_ip.toString());
+void ESP32_W5500_Manager::handleScheduledRestart()
+{
+  if ( !_restartScheduled || ((int32_t) (millis() - _restartAt) < 0) )
+    return;
 
-    page += item;
+  LOGWARN(F("Scheduled restart"));
 
-    item = FPSTR(EM_HTTP_FORM_LABEL);
-    item += FPSTR(EM_HTTP_FORM_PARAM);
+  if (_preRestartCallback != NULL)
+  {
+    _preRestartCallback();
+  }
 
-    item.replace("{i}", "gw");
-    item.replace("{n}", "gw");
-    item.replace("{p}", "Gateway IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _ETH_STA_IPconfig._sta_static_gw.toString());
+  // Close the listening and client sockets, rather than leaving the clients to time out
+  if (server)
+    server->stop();
 
-    page += item;
+  if (dnsServer)
+    dnsServer->stop();
 
-    item = FPSTR(EM_HTTP_FORM_LABEL);
-    item += FPSTR(EM_HTTP_FORM_PARAM);
+  // Time for lwIP to send the FINs
+  delay(100);
 
-    item.replace("{i}", "sn");
-    item.replace("{n}", "sn");
-    item.replace("{p}", "Subnet");
-    item.replace("{l}", "15");
-    item.replace("{v}", _ETH_STA_IPconfig._sta_static_sn.toString());
+  ESP.restart();
+}
 
-#if USE_CONFIGURABLE_DNS
-    //***** Added for DNS address options *****
-    page += item;
+//////////////////////////////////////////
 
-    item = FPSTR(EM_HTTP_FORM_LABEL);
-    item += FPSTR(EM_HTTP_FORM_PARAM);
+#if USING_CORS_FEATURE
+void ESP32_W5500_Manager::buildCORSHeaderProfiles()
+{
+  _CORSPageHeaders = FPSTR(EM_HTTP_HEADERS_NO_CACHE);
+  _CORSPageHeaders += FPSTR(EM_HTTP_CORS);
+  _CORSPageHeaders += F(": ");
+  _CORSPageHeaders += _CORS_Header;
+  _CORSPageHeaders += F("\r\n");
+
+  _CORSJsonHeaders = FPSTR(EM_HTTP_HEADERS_JSON);
+  _CORSJsonHeaders += _CORSPageHeaders.c_str() + strlen_P(EM_HTTP_HEADERS_NO_CACHE);
+}
+#endif
 
-    item.replace("{i}", "dns1");
-    item.replace("{n}", "dns1");
-    item.replace("{p}", "DNS1 IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _ETH_STA_IPconfig._sta_static_dns1.toString());
+//////////////////////////////////////////
 
-    page += item;
+void ESP32_W5500_Manager::sendHeaderProfile(const EM_HeaderProfile& profile)
+{
+  switch (profile)
+  {
+#if USING_CORS_FEATURE
 
-    item = FPSTR(EM_HTTP_FORM_LABEL);
-    item += FPSTR(EM_HTTP_FORM_PARAM);
+    case EM_HEADERS_PAGE:
+      server->sendHeaderBlock(_CORSPageHeaders.c_str());
+      break;
 
-    item.replace("{i}", "dns2");
-    item.replace("{n}", "dns2");
-    item.replace("{p}", "DNS2 IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _ETH_STA_IPconfig._sta_static_dns2.toString());
-    //***** End added for DNS address options *****
-#endif
+    case EM_HEADERS_JSON:
+      server->sendHeaderBlock(_CORSJsonHeaders.c_str());
+      break;
 
-    page += item;
+    case EM_HEADERS_REVALIDATE:
+      // The CORS line, after the no-cache lines of _CORSPageHeaders
+      server->sendHeaderBlock(EM_HTTP_HEADERS_REVALIDATE);
+      server->sendHeaderBlock(_CORSPageHeaders.c_str() + strlen_P(EM_HTTP_HEADERS_NO_CACHE));
+      break;
 
-    page += FPSTR(EM_FLDSET_END);
+#else
 
-    page += "<br/>";
-  }
+    case EM_HEADERS_PAGE:
+      server->sendHeaderBlock(EM_HTTP_HEADERS_NO_CACHE);
+      break;
 
-  page += FPSTR(EM_HTTP_SCRIPT_NTP_HIDDEN);
+    case EM_HEADERS_JSON:
+      server->sendHeaderBlock(EM_HTTP_HEADERS_JSON);
+      break;
 
-  page += FPSTR(EM_HTTP_FORM_END);
+    case EM_HEADERS_REVALIDATE:
+      server->sendHeaderBlock(EM_HTTP_HEADERS_REVALIDATE);
+      break;
 
-  page += FPSTR(EM_HTTP_END);
+#endif
 
-  server->send(200, "text/html", page);
+    case EM_HEADERS_ASSET:
+      server->sendHeaderBlock(EM_HTTP_HEADERS_ASSET);
+      break;
 
-  LOGDEBUG(F("Sent config page"));
+    case EM_HEADERS_NO_CACHE:
+    default:
+      server->sendHeaderBlock(EM_HTTP_HEADERS_NO_CACHE);
+      break;
+  }
 }
 
 //////////////////////////////////////////
 
-// Handle the WLAN save form and redirect to WLAN config page again
-void ESP32_W5500_Manager::handleETHSave()
+// Headers of / and /eth, with a weak ETag made of the route and em_pageGeneration().
+// True if the browser's copy is still current and a 304 was sent, so there's nothing to render
+bool ESP32_W5500_Manager::sendPageHeaders(const EM_Route& route)
 {
-  LOGDEBUG(F("ETH save"));
+#if USE_EM_PAGE_ETAG
+  static const char hexDigits[] = "0123456789abcdef";
 
-#if USING_CORS_FEATURE
-  // For configuring CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
-  server->sendHeader(FPSTR(EM_HTTP_CORS), _CORS_Header);
-#endif
+  // W/"<route>-<generation>"
+  char      etag[16]    = "W/\"";
+  char*     pos         = etag + 3;
+  uint32_t  generation  = em_pageGeneration();
 
-#if USE_ESP_ETH_MANAGER_NTP
+  *pos++ = hexDigits[route & 0x0F];
+  *pos++ = '-';
 
-  if (server->arg("timezone") != "")
-  {
-    _timezoneName = server->arg("timezone");
-    LOGDEBUG1(F("TZ name ="), _timezoneName);
-  }
-  else
-  {
-    LOGDEBUG(F("No TZ arg"));
-  }
+  for (int shift = 28; shift >= 0; shift -= 4)
+    *pos++ = hexDigits[(generation >> shift) & 0x0F];
 
-#endif
+  *pos++ = '"';
+  *pos   = '\0';
 
-  ///////////////////////
+  sendHeaderProfile(EM_HEADERS_REVALIDATE);
+  server->sendHeader(FPSTR(EM_HTTP_ETAG), etag);
 
-  //parameters
-  for (int i = 0; i < _paramsCount; i++)
+  // Weak comparison (RFC 7232), so with or without the "W/", alone or in a list of tags
+  if (strstr(server->header(FPSTR(EM_HTTP_IF_NONE_MATCH)).c_str(), etag + 2))
   {
-    if (_params[i] == NULL)
-    {
-      break;
-    }
+    LOGDEBUG1(F("Page not modified, ETag ="), etag);
 
-    //read parameter
-    String value = server->arg(_params[i]->getID()).c_str();
+    server->send(304);
 
-    //store it in array
-    value.toCharArray(_params[i]->_EMParam_data._value, _params[i]->_EMParam_data._length);
-
-    LOGDEBUG2(F("Parameter and value :"), _params[i]->getID(), value);
+    return true;
   }
+#else
+  (void) route;
 
+  sendHeaderProfile(EM_HEADERS_PAGE);
+#endif
 
-  if (server->arg("ip") != "")
-  {
-    String ip = server->arg("ip");
+  return false;
+}
 
-    optionalIPFromString(&_ETH_STA_IPconfig._sta_static_ip, ip.c_str());
+//////////////////////////////////////////
 
-    LOGDEBUG1(F("New Static IP ="), _ETH_STA_IPconfig._sta_static_ip.toString());
-  }
+// Send the cached body of route if still current, after sendPageHeaders(). Otherwise have page capture
+// the body it is about to render
+bool ESP32_W5500_Manager::sendCachedPage(const EM_Route& route, ESP32_EMPageWriter& page)
+{
+#if USE_EM_PAGE_CACHE
+  uint32_t    generation  = em_pageGeneration();
+  const char* body;
+  size_t      len;
 
-  if (server->arg("gw") != "")
+  if (_pageCache.lookup(route, generation, body, len))
   {
-    String gw = server->arg("gw");
+    LOGDEBUG1(F("Page from cache, bytes ="), len);
 
-    optionalIPFromString(&_ETH_STA_IPconfig._sta_static_gw, gw.c_str());
+    server->send_P(200, EM_HTTP_HEAD_CT, body, len);
 
-    LOGDEBUG1(F("New Static Gateway ="), _ETH_STA_IPconfig._sta_static_gw.toString());
+    return true;
   }
 
-  if (server->arg("sn") != "")
-  {
-    String sn = server->arg("sn");
+  _pageCache.beginCapture(route, generation);
+  page.captureTo(&_pageCache);
+#else
+  (void) route;
+  (void) page;
+#endif
 
-    optionalIPFromString(&_ETH_STA_IPconfig._sta_static_sn, sn.c_str());
+  return false;
+}
 
-    LOGDEBUG1(F("New Static Netmask ="), _ETH_STA_IPconfig._sta_static_sn.toString());
-  }
+//////////////////////////////////////////
 
-#if USE_CONFIGURABLE_DNS
+// Send one of the compile-time gzipped assets in utils/EM_Assets.h
+void ESP32_W5500_Manager::sendAsset(const uint8_t* data, const size_t& len, const char* contentType, const char* etag)
+{
+  sendHeaderProfile(EM_HEADERS_ASSET);
+  server->sendHeader(FPSTR(EM_HTTP_ETAG), FPSTR(etag));
 
-  //*****  Added for DNS Options *****
-  if (server->arg("dns1") != "")
+  if (server->header(FPSTR(EM_HTTP_IF_NONE_MATCH)) == etag)
   {
-    String dns1 = server->arg("dns1");
+    LOGDEBUG1(F("Asset not modified, ETag ="), etag);
 
-    optionalIPFromString(&_ETH_STA_IPconfig._sta_static_dns1, dns1.c_str());
+    server->send(304);
 
-    LOGDEBUG1(F("New Static DNS1 ="), _ETH_STA_IPconfig._sta_static_dns1.toString());
+    return;
   }
 
-  if (server->arg("dns2") != "")
-  {
-    String dns2 = server->arg("dns2");
+  server->sendHeaderBlock(EM_HTTP_HEADERS_GZIP);
 
-    optionalIPFromString(&_ETH_STA_IPconfig._sta_static_dns2, dns2.c_str());
+  server->send_P(200, contentType, (PGM_P) data, len);
+}
 
-    LOGDEBUG1(F("New Static DNS2 ="), _ETH_STA_IPconfig._sta_static_dns2.toString());
-  }
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::handleStyle()
+{
+  LOGDEBUG(F("Style"));
+
+  sendAsset(EM_ASSET_CSS, sizeof(EM_ASSET_CSS), EM_HTTP_HEAD_CSS, EM_ASSET_CSS_ETAG);
+}
+
+//////////////////////////////////////////
+
+void ESP32_W5500_Manager::handleTZScript()
+{
+  LOGDEBUG(F("TZ Script"));
 
-  //*****  End added for DNS Options *****
+#if USING_EM_TZ_JS_ASSET
+  sendAsset(EM_ASSET_TZ_JS, sizeof(EM_ASSET_TZ_JS), EM_HTTP_HEAD_JS, EM_ASSET_TZ_JS_ETAG);
 #endif
+}
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
-  page.replace("{v}", "Credentials Saved");
+//////////////////////////////////////////
 
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(EM_HTTP_HEAD_END);
-  page += FPSTR(EM_HTTP_SAVED);
+void ESP32_W5500_Manager::handleNotFound()
+{
+  if (captivePortal())
+  {
+    LOGDEBUG(F("handleNotFound: captive portal exit"));
 
-  page += FPSTR(EM_HTTP_END);
+    // If captive portal redirect instead of displaying the error page.
+    return;
+  }
 
-  server->send(200, "text/html", page);
+  String message = "File Not Found\n\n";
 
-  LOGDEBUG(F("Sent eth save page"));
+  message += "URI: ";
+  message += server->uri();
+  message += "\nMethod: ";
+  message += (server->method() == HTTP_GET) ? "GET" : "POST";
+  message += "\nArguments: ";
+  message += server->args();
+  message += "\n";
 
-  connect = true; //signal ready to connect/reset
+  for (uint8_t i = 0; i < server->args(); i++)
+  {
+    message += " " + server->argName(i) + ": " + server->arg(i) + "\n";
+  }
 
-  stopConfigPortal = true; //signal ready to shutdown config portal
+  sendHeaderProfile(EM_HEADERS_NO_CACHE);
 
-  // Restore when Press Save WiFi
-  _configPortalTimeout = DEFAULT_PORTAL_TIMEOUT;
+  server->send(404, "text/plain", message);
 }
 
 //////////////////////////////////////////
 
-// Handle shut down the server page
-void ESP32_W5500_Manager::handleServerClose()
+/**
+   HTTPD redirector
+   Redirect to captive portal if we got a request for another domain.
+   Return true in that case so the page handler do not try to handle the request again.
+*/
+bool ESP32_W5500_Manager::captivePortal()
 {
-  LOGDEBUG(F("Server Close"));
+  const String& hostHeader = server->hostHeaderRef();
+
+  LOGDEBUG1(F("captivePortal: hostHeader = "), hostHeader);
 
-  server->sendHeader(FPSTR(EM_HTTP_CACHE_CONTROL), FPSTR(EM_HTTP_NO_STORE));
+  // No Host header (HTTP/1.0) is not redirected either
+  if ( (hostHeader.length() > 0) && !em_isIPHost(hostHeader.c_str(), hostHeader.length()) )
+  {
+    sendCaptiveRedirect();
 
+    return true;
+  }
 
-#if USING_CORS_FEATURE
-  // For configuring CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
-  server->sendHeader(FPSTR(EM_HTTP_CORS), _CORS_Header);
-#endif
+  return false;
+}
 
-  server->sendHeader(FPSTR(EM_HTTP_PRAGMA), FPSTR(EM_HTTP_NO_CACHE));
-  server->sendHeader(FPSTR(EM_HTTP_EXPIRES), "-1");
+//////////////////////////////////////////
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
+void ESP32_W5500_Manager::handleCaptiveProbe()
+{
+  LOGDEBUG1(F("handleCaptiveProbe: uri = "), server->uri());
 
-  page.replace("{v}", "Close Server");
+  sendCaptiveRedirect();
+}
 
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(EM_HTTP_HEAD_END);
-  page += F("<div class=\"msg\">");
-  page += F("</b><br>");
-  page += F("IP address is <b>");
-  page += ETH.localIP().toString();
-  page += F("</b><br><br>");
-  page += F("Portal closed...<br><br>");
+//////////////////////////////////////////
 
-  //page += F("Push button on device to restart configuration server!");
+// Write the whole prebuilt 302 in one call, then close as no content follows
+void ESP32_W5500_Manager::sendCaptiveRedirect()
+{
+  IPAddress localIP = server->localIP();
 
-  page += FPSTR(EM_HTTP_END);
+  if ( (_redirectLength == 0) || ((uint32_t) localIP != _redirectIP) )
+  {
+    int len = snprintf_P(_redirectResponse, sizeof(_redirectResponse), EM_HTTP_REDIRECT_RESPONSE,
+                         localIP[0], localIP[1], localIP[2], localIP[3]);
 
-  server->send(200, "text/html", page);
+    _redirectLength = (len > 0) ? len : 0;
+    _redirectIP     = (uint32_t) localIP;
 
-  stopConfigPortal = true; //signal ready to shutdown config portal
+    LOGINFO1(F("Request redirected to captive portal : "), localIP);
+  }
 
-  LOGDEBUG(F("Sent server close page"));
+  server->sendRawResponse((const uint8_t *) _redirectResponse, _redirectLength);
 
-  // Restore when Press Save WiFi
-  _configPortalTimeout = DEFAULT_PORTAL_TIMEOUT;
+  server->countResponse(302, 0);
+
+#if USE_EM_METRICS
+  _currentRoute = EM_ROUTE_CAPTIVE;
+#endif
 }
 
 //////////////////////////////////////////
 
-// Handle the info page
-void ESP32_W5500_Manager::handleInfo()
+void ESP32_W5500_Manager::onRoute(const char* uri, const EM_Route& route, EM_RouteHandler handler)
 {
-  LOGDEBUG(F("Info"));
+#if (USE_EM_METRICS || USE_EM_MEMORY_STATS)
+  ESP32_EMWebServer::THandlerFunction function = std::bind(&ESP32_W5500_Manager::handleRoute, this, route, handler);
+#else
+  (void) route;
 
-  // Disable _configPortalTimeout when someone accessing Portal to give some time to config
-  _configPortalTimeout = 0;
+  ESP32_EMWebServer::THandlerFunction function = std::bind(handler, this);
+#endif
 
-  server->sendHeader(FPSTR(EM_HTTP_CACHE_CONTROL), FPSTR(EM_HTTP_NO_STORE));
+  if (uri)
+    server->on(uri, function);
+  else
+    server->onNotFound(function);
+}
 
-#if USING_CORS_FEATURE
-  // For configuring CORS Header, default to EM_HTTP_CORS_ALLOW_ALL = "*"
-  server->sendHeader(FPSTR(EM_HTTP_CORS), _CORS_Header);
-#endif
+//////////////////////////////////////////
 
-  server->sendHeader(FPSTR(EM_HTTP_PRAGMA), FPSTR(EM_HTTP_NO_CACHE));
-  server->sendHeader(FPSTR(EM_HTTP_EXPIRES), "-1");
+#if (USE_EM_METRICS || USE_EM_MEMORY_STATS)
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
-  page.replace("{v}", "Info");
+void ESP32_W5500_Manager::handleRoute(const EM_Route& route, EM_RouteHandler handler)
+{
+#if USE_EM_METRICS
+  server->resetResponse();
 
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_SCRIPT_NTP);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
+  // Changed by sendCaptiveRedirect(), whatever route redirects
+  _currentRoute = route;
 
-  if (connect)
-    page += F("<meta http-equiv=\"refresh\" content=\"5; url=/i\">");
+  uint32_t start = micros();
 
-  page += FPSTR(EM_HTTP_HEAD_END);
+  (this->*handler)();
 
-  page += F("<dl>");
+  recordRoute(_currentRoute, micros() - start, server->getResponseLength(), (server->getResponseCode() >= 400));
+#else
+  (void) route;
 
-  if (connect)
-  {
-    page += F("<dt>Trying to connect</dt><dd>");
-    page += ethStatus;
-    page += F("</dd>");
-  }
+  (this->*handler)();
+#endif
+
+#if USE_EM_MEMORY_STATS
+  sampleMemory();
+#endif
+}
 
-  page += pager;
-  page += F("<h2>Information</h2>");
+#endif
 
-  reportStatus(page);
+//////////////////////////////////////////
 
-  page += FPSTR(EM_FLDSET_START);
-  page += F("<h3>Device Data</h3>");
-  page += F("<table class=\"table\">");
-  page += F("<thead><tr><th>Name</th><th>Value</th></tr></thead><tbody><tr><td>Chip ID</td><td>");
+#if USE_EM_MEMORY_STATS
 
-  page += String(ESP_getChipId(), HEX);
-  page += F("</td></tr>");
+void ESP32_W5500_Manager::sampleMemory()
+{
+  _memoryStats.freeHeap         = ESP.getFreeHeap();
+  _memoryStats.largestFreeBlock = ESP.getMaxAllocHeap();
+  _memoryStats.minFreeHeap      = ESP.getMinFreeHeap();
 
-  page += F("<tr><td>Chip OUI</td><td>");
-  page += F("0x");
-  page += String(getChipOUI(), HEX);
-  page += F("</td></tr>");
+  // Of the calling task, in bytes on ESP32
+  uint32_t stackHighWaterMark = uxTaskGetStackHighWaterMark(NULL);
 
-  page += F("<tr><td>Chip Model</td><td>");
-  page += ESP.getChipModel();
-  page += F(" Rev");
-  page += ESP.getChipRevision();
+  if ( (_memoryStats.samples == 0) || (stackHighWaterMark < _memoryStats.stackHighWaterMark) )
+    _memoryStats.stackHighWaterMark = stackHighWaterMark;
 
-  page += F("</td></tr>");
+  if ( (_memoryStats.sessionMinLargestFreeBlock == 0) || (_memoryStats.largestFreeBlock < _memoryStats.sessionMinLargestFreeBlock) )
+    _memoryStats.sessionMinLargestFreeBlock = _memoryStats.largestFreeBlock;
 
-  page += F("<tr><td>Flash Chip ID</td><td>");
+  _memoryStats.samples++;
+}
 
-  // TODO
-  page += F("TODO");
+//////////////////////////////////////////
 
-  page += F("</td></tr>");
+void ESP32_W5500_Manager::writeMemoryStats(ESP32_EMPageWriter& page)
+{
+  sampleMemory();
+
+  page.print(FPSTR(EM_FLDSET_START));
+  page.print(F("<h3>Memory</h3>"));
+  page.print(F("<table class=\"table\">"));
+  page.print(F("<thead><tr><th>Name</th><th>Value</th></tr></thead><tbody><tr><td>Free Heap</td><td>"));
+  page.print(_memoryStats.freeHeap);
+  page.print(F(" bytes</td></tr>"));
+
+  // Share of the free heap not usable by a single allocation
+  page.print(F("<tr><td>Largest Free Block</td><td>"));
+  page.print(_memoryStats.largestFreeBlock);
+  page.print(F(" bytes ("));
+  page.print((_memoryStats.freeHeap > 0) ? (100 - (100ULL * _memoryStats.largestFreeBlock / _memoryStats.freeHeap)) : 0);
+  page.print(F("% fragmented)</td></tr>"));
+
+  page.print(F("<tr><td>Min Free Heap</td><td>"));
+  page.print(_memoryStats.minFreeHeap);
+  page.print(F(" bytes</td></tr>"));
+
+  page.print(F("<tr><td>Stack High Water Mark</td><td>"));
+  page.print(_memoryStats.stackHighWaterMark);
+  page.print(F(" bytes</td></tr>"));
+
+  page.print(F("<tr><td>Portal Sessions</td><td>"));
+  page.print(_memoryStats.sessions);
+  page.print(F("</td></tr>"));
+
+  page.print(F("<tr><td>Free Heap at Portal Start</td><td>"));
+  page.print(_memoryStats.sessionStartFreeHeap);
+  page.print(F(" bytes</td></tr>"));
+
+  page.print(F("<tr><td>Min Largest Free Block in Session</td><td>"));
+  page.print(_memoryStats.sessionMinLargestFreeBlock);
+  page.print(F(" bytes</td></tr>"));
+  page.print(F("</tbody></table>"));
+
+  page.print(FPSTR(EM_FLDSET_END));
+}
 
-  page += F("<tr><td>IDE Flash Size</td><td>");
-  page += ESP.getFlashChipSize();
-  page += F(" bytes</td></tr>");
+#endif    // USE_EM_MEMORY_STATS
 
-  page += F("<tr><td>Real Flash Size</td><td>");
+//////////////////////////////////////////
 
-  // TODO
-  page += F("TODO");
+#if USE_EM_METRICS
 
-  page += F(" bytes</td></tr>");
+void ESP32_W5500_Manager::recordRoute(const EM_Route& route, const uint32_t& us, const size_t& bytes, const bool& error)
+{
+  EM_RouteMetrics& metrics = _metrics[route];
 
-  page += F("<tr><td>Station IP</td><td>");
-  page += ETH.localIP().toString();
-  page += F("</td></tr>");
+  uint8_t bucket = 0;
 
-  page += F("<tr><td>Station MAC</td><td>");
-  page += ETH.macAddress();
-  page += F("</td></tr>");
-  page += F("</tbody></table>");
+  while ( (bucket < EM_METRICS_BUCKETS - 1) && (us > EM_METRICS_BUCKET_BOUNDS[bucket]) )
+    bucket++;
 
-  page += FPSTR(EM_FLDSET_END);
+  metrics.count++;
+  metrics.buckets[bucket]++;
+  metrics.bytes   += bytes;
+  metrics.totalUs += us;
 
-#if USE_AVAILABLE_PAGES
-  page += FPSTR(EM_FLDSET_START);
-  page += FPSTR(EM_HTTP_AVAILABLE_PAGES);
-  page += FPSTR(EM_FLDSET_END);
-#endif
+  if (error)
+    metrics.errors++;
 
-  page += F("<p/>More information about ESP32_W5500_Manager at");
-  page += F("<p/><a href=\"https://github.com/khoih-prog/ESP32_W5500_Manager\">https://github.com/khoih-prog/ESP32_W5500_Manager</a>");
-  page += FPSTR(EM_HTTP_END);
+  if (us > metrics.maxUs)
+    metrics.maxUs = us;
+}
 
-  server->send(200, "text/html", page);
+//////////////////////////////////////////
 
-  LOGDEBUG(F("Sent info page"));
+void ESP32_W5500_Manager::resetMetrics()
+{
+  memset(_metrics, 0, sizeof(_metrics));
 }
 
 //////////////////////////////////////////
 
-// Handle the state page
-void ESP32_W5500_Manager::handleState()
+void ESP32_W5500_Manager::printMetric(Print& out, const char* name, const char* route, const char* le,
+                                      const uint64_t& value)
 {
-  LOGDEBUG(F("State-Json"));
+  out.print(name);
+  out.print(F("{route=\""));
+  out.print(route);
+
+  if (le)
+  {
+    out.print(F("\",le=\""));
+    out.print(le);
+  }
 
-  LOGDEBUG(F("Sent state page in json format"));
+  out.print(F("\"} "));
+  out.print((unsigned long long) value);
+  out.write('\n');
 }
 
 //////////////////////////////////////////
 
-// Handle the reset page
-void ESP32_W5500_Manager::handleReset()
+void ESP32_W5500_Manager::printMetrics(Print& out)
 {
-  LOGDEBUG(F("Reset"));
+  out.print(F("# HELP em_requests_total Config Portal requests by route\n# TYPE em_requests_total counter\n"));
 
-  server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-  server->sendHeader("Pragma", "no-cache");
-  server->sendHeader("Expires", "-1");
+  for (int i = 0; i < EM_ROUTE_COUNT; i++)
+    printMetric(out, "em_requests_total", EM_ROUTE_NAMES[i], NULL, _metrics[i].count);
 
-  String page = FPSTR(EM_HTTP_HEAD_START);
+  out.print(F("# HELP em_errors_total Responses with status >= 400\n# TYPE em_errors_total counter\n"));
 
-  page.replace("{v}", "ETH Information");
-  page += FPSTR(EM_HTTP_SCRIPT);
-  page += FPSTR(EM_HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(EM_HTTP_HEAD_END);
-  page += F("Resetting");
-  page += FPSTR(EM_HTTP_END);
+  for (int i = 0; i < EM_ROUTE_COUNT; i++)
+    printMetric(out, "em_errors_total", EM_ROUTE_NAMES[i], NULL, _metrics[i].errors);
 
-  server->send(200, "text/html", page);
+  out.print(F("# HELP em_response_bytes_total Response body bytes\n# TYPE em_response_bytes_total counter\n"));
 
-  LOGDEBUG(F("Sent reset page"));
-  delay(5000);
+  for (int i = 0; i < EM_ROUTE_COUNT; i++)
+    printMetric(out, "em_response_bytes_total", EM_ROUTE_NAMES[i], NULL, _metrics[i].bytes);
 
-  ESP.restart();
+  out.print(F("# HELP em_duration_max_microseconds Slowest call\n# TYPE em_duration_max_microseconds gauge\n"));
 
-  delay(2000);
-}
+  for (int i = 0; i < EM_ROUTE_COUNT; i++)
+    printMetric(out, "em_duration_max_microseconds", EM_ROUTE_NAMES[i], NULL, _metrics[i].maxUs);
 
-//////////////////////////////////////////
+  // Only the routes called so far, the empty histograms would double the output
+  out.print(F("# HELP em_duration_microseconds Handler duration\n# TYPE em_duration_microseconds histogram\n"));
 
-void ESP32_W5500_Manager::handleNotFound()
-{
-  if (captivePortal())
+  for (int i = 0; i < EM_ROUTE_COUNT; i++)
   {
-    LOGDEBUG(F("handleNotFound: captive portal exit"));
+    const EM_RouteMetrics& metrics = _metrics[i];
 
-    // If captive portal redirect instead of displaying the error page.
-    return;
-  }
+    if (metrics.count == 0)
+      continue;
 
-  String message = "File Not Found\n\n";
+    uint32_t  cumulative = 0;
+    char      le[12];
 
-  message += "URI: ";
-  message += server->uri();
-  message += "\nMethod: ";
-  message += (server->method() == HTTP_GET) ? "GET" : "POST";
-  message += "\nArguments: ";
-  message += server->args();
-  message += "\n";
+    for (int bucket = 0; bucket < EM_METRICS_BUCKETS - 1; bucket++)
+    {
+      cumulative += metrics.buckets[bucket];
 
-  for (uint8_t i = 0; i < server->args(); i++)
-  {
-    message += " " + server->argName(i) + ": " + server->arg(i) + "\n";
+      snprintf(le, sizeof(le), "%lu", (unsigned long) EM_METRICS_BUCKET_BOUNDS[bucket]);
+      printMetric(out, "em_duration_microseconds_bucket", EM_ROUTE_NAMES[i], le, cumulative);
+    }
+
+    printMetric(out, "em_duration_microseconds_bucket", EM_ROUTE_NAMES[i], "+Inf",  metrics.count);
+    printMetric(out, "em_duration_microseconds_sum",    EM_ROUTE_NAMES[i], NULL,    metrics.totalUs);
+    printMetric(out, "em_duration_microseconds_count",  EM_ROUTE_NAMES[i], NULL,    metrics.count);
   }
 
-  server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-  server->sendHeader("Pragma", "no-cache");
-  server->sendHeader("Expires", "-1");
+#if USE_EM_CAPTIVE_DNS
+  EM_DNSStats dnsStats;
 
-  server->send(404, "text/plain", message);
+  if (getDNSStats(dnsStats))
+  {
+    out.print(F("# HELP em_dns_queries_total Captive DNS queries of the current Config Portal\n"
+                "# TYPE em_dns_queries_total counter\nem_dns_queries_total{result=\"answered\"} "));
+    out.print(dnsStats.answered);
+    out.print(F("\nem_dns_queries_total{result=\"dropped\"} "));
+    out.print(dnsStats.dropped);
+    out.print(F("\n# HELP em_dns_max_burst Most DNS packets handled by one portal loop iteration\n"
+                "# TYPE em_dns_max_burst gauge\nem_dns_max_burst "));
+    out.print(dnsStats.maxBurst);
+    out.print(F("\n# HELP em_dns_burst_capped_total Portal loop iterations which stopped at EM_DNS_MAX_BURST DNS packets\n"
+                "# TYPE em_dns_burst_capped_total counter\nem_dns_burst_capped_total "));
+    out.print(dnsStats.capped);
+    out.write('\n');
+  }
+#endif
+
+#if USE_EM_MEMORY_STATS
+  out.print(F("# TYPE em_free_heap_bytes gauge\nem_free_heap_bytes "));
+  out.print(_memoryStats.freeHeap);
+  out.print(F("\n# TYPE em_largest_free_block_bytes gauge\nem_largest_free_block_bytes "));
+  out.print(_memoryStats.largestFreeBlock);
+  out.print(F("\n# TYPE em_min_free_heap_bytes gauge\nem_min_free_heap_bytes "));
+  out.print(_memoryStats.minFreeHeap);
+  out.print(F("\n# TYPE em_stack_high_water_mark_bytes gauge\nem_stack_high_water_mark_bytes "));
+  out.print(_memoryStats.stackHighWaterMark);
+  out.write('\n');
+#endif
 }
 
 //////////////////////////////////////////
 
-/**
-   HTTPD redirector
-   Redirect to captive portal if we got a request for another domain.
-   Return true in that case so the page handler do not try to handle the request again.
-*/
-bool ESP32_W5500_Manager::captivePortal()
+void ESP32_W5500_Manager::handleMetrics()
 {
-  LOGDEBUG1(F("captivePortal: hostHeader = "), server->hostHeader());
-
-  if (!isIp(server->hostHeader()))
-  {
-    LOGINFO1(F("Request redirected to captive portal : "), server->client().localIP());
+  LOGDEBUG(F("Metrics"));
 
-    server->sendHeader(F("Location"), (String)F("http://") + toStringIp(server->client().localIP()), true);
+  sendHeaderProfile(EM_HEADERS_NO_CACHE);
 
-    // Empty content inhibits Content-length header so we have to close the socket ourselves.
-    server->send(302, FPSTR(EM_HTTP_HEAD_CT2), "");
+  ESP32_EMPageWriter page(server.get());
 
-    server->client().stop(); // Stop is needed because we sent no content length
+  page.begin(200, EM_HTTP_HEAD_METRICS);
 
-    return true;
-  }
+  printMetrics(page);
 
-  return false;
+  page.end();
 }
 
+#endif    // USE_EM_METRICS
+
 //////////////////////////////////////////
 
 // start up save config callback
@@ -1145,45 +2577,34 @@ void ESP32_W5500_Manager::setSaveConfigCallback(void(*func)())
 
 //////////////////////////////////////////
 
-// sets a custom element to add to head, like a new style tag
-void ESP32_W5500_Manager::setCustomHeadElement(const char* element)
+void ESP32_W5500_Manager::setSaveConfigCallback(void(*func)(const EM_ChangeSet& changes))
 {
-  _customHeadElement = element;
+  _changeSetCallback = func;
 }
 
 //////////////////////////////////////////
 
-// Is this an IP?
-bool ESP32_W5500_Manager::isIp(const String& str)
+// Returns true if target was changed. Invalid addresses are ignored
+bool ESP32_W5500_Manager::updateIP(IPAddress& target, const char* ipString)
 {
-  for (unsigned int i = 0; i < str.length(); i++)
-  {
-    int c = str.charAt(i);
+  IPAddress ip;
 
-    if ( (c != '.') && (c != ':') && ( (c < '0') || (c > '9') ) )
-    {
-      return false;
-    }
-  }
+  if (!em_parseIPv4(ipString, ip) || (ip == target))
+    return false;
+
+  target = ip;
 
   return true;
 }
 
 //////////////////////////////////////////
 
-// IP to String
-String ESP32_W5500_Manager::toStringIp(const IPAddress& ip)
+// sets a custom element to add to head, like a new style tag
+void ESP32_W5500_Manager::setCustomHeadElement(const char* element)
 {
-  String res = "";
-
-  for (int i = 0; i < 3; i++)
-  {
-    res += String((ip >> (8 * i)) & 0xFF) + ".";
-  }
-
-  res += String(((ip >> 8 * 3)) & 0xFF);
+  _customHeadElement = element;
 
-  return res;
+  em_pageGeneration()++;
 }
 
 //////////////////////////////////////////
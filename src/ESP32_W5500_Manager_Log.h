@@ -0,0 +1,403 @@
+/****************************************************************************************************************************
+  ESP32_W5500_Manager_Log.h
+
+  For Ethernet shields using ESP32_W5500 (ESP32 + LwIP W5500)
+
+  WebServer_ESP32_W5500 is a library for the ESP32 with Ethernet W5500 to run WebServer
+
+  Modified from
+  1. Tzapu               (https://github.com/tzapu/WiFiManager)
+  2. Ken Taylor          (https://github.com/kentaylor)
+  3. Khoi Hoang          (https://github.com/khoih-prog/ESP_WiFiManager)
+
+  Built by Khoi Hoang https://github.com/khoih-prog/ESP32_W5500_Manager
+  Licensed under MIT license
+
+  Version: 1.0.0
+
+  Version Modified By  Date      Comments
+  ------- -----------  ---------- -----------
+  1.0.0   K Hoang     11/12/2022 Initial coding for ESP32_W5500
+ *****************************************************************************************************************************/
+
+// Asynchronous backend of the LOG* macros, enabled by ESP32_ETH_MGR_ASYNC_LOG.
+// Each LOG* call is formatted on the stack into one record, queued into a lock-free ring of fixed slots
+// (bounded MPMC queue), and written to the sink by a low-priority task. A full ring drops the record
+// and counts it, instead of blocking the caller.
+
+#pragma once
+
+#ifndef ESP32_W5500_Manager_Log_H
+#define ESP32_W5500_Manager_Log_H
+
+#include <atomic>
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+
+////////////////////////////////////////////////////
+
+// Number of records in the ring, must be a power of 2
+#ifndef EM_LOG_SLOTS
+  #define EM_LOG_SLOTS                32
+#endif
+
+// Max text length of a record, longer ones are truncated, keeping their line end
+#ifndef EM_LOG_SLOT_SIZE
+  #define EM_LOG_SLOT_SIZE            120
+#endif
+
+// The last 2 bytes of a slot are kept for the "\r\n" of a truncated record
+#define EM_LOG_TEXT_SIZE              (EM_LOG_SLOT_SIZE - 2)
+
+// How often (ms) the drain task checks the ring
+#ifndef EM_LOG_DRAIN_INTERVAL
+  #define EM_LOG_DRAIN_INTERVAL       10
+#endif
+
+#ifndef EM_LOG_TASK_PRIORITY
+  #define EM_LOG_TASK_PRIORITY        1
+#endif
+
+#ifndef EM_LOG_TASK_STACK_SIZE
+  #define EM_LOG_TASK_STACK_SIZE      3072
+#endif
+
+static_assert((EM_LOG_SLOTS & (EM_LOG_SLOTS - 1)) == 0, "EM_LOG_SLOTS must be a power of 2");
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+// Where the records end up. A record may hold a partial line (LOGxxx0 macros), so text may not end with '\n'
+class ESP32_EMLogSink
+{
+  public:
+
+    virtual ~ESP32_EMLogSink() {}
+
+    virtual void write(const uint32_t& timestamp, const char* text, const size_t& len) = 0;
+
+    // Called once the ring is empty
+    virtual void flush() {}
+};
+
+////////////////////////////////////////////////////
+
+// Any Print: Serial, or a File opened for append on LittleFS / SPIFFS / FFat.
+// Lines are prefixed with the millis() timestamp of their first record, unless timestamps is false
+// (binary frames of ESP32_ETH_MGR_BINARY_LOG)
+class ESP32_EMPrintLogSink : public ESP32_EMLogSink
+{
+  public:
+
+    ESP32_EMPrintLogSink(Print& out, const bool& timestamps = true) : _out(out), _timestamps(timestamps) {}
+
+    void write(const uint32_t& timestamp, const char* text, const size_t& len) override
+    {
+      if (_timestamps && _lineStart)
+      {
+        char prefix[16];
+
+        _out.write((const uint8_t *) prefix, snprintf(prefix, sizeof(prefix), "%lu ", (unsigned long) timestamp));
+      }
+
+      _out.write((const uint8_t *) text, len);
+
+      _lineStart = (len > 0) && (text[len - 1] == '\n');
+    }
+
+    void flush() override
+    {
+      _out.flush();
+    }
+
+  private:
+
+    Print&  _out;
+    bool    _timestamps;
+    bool    _lineStart = true;
+};
+
+////////////////////////////////////////////////////
+
+// One UDP syslog (RFC 3164) message per line, to a local collector
+class ESP32_EMSyslogLogSink : public ESP32_EMLogSink
+{
+  public:
+
+    ESP32_EMSyslogLogSink(const IPAddress& server, const uint16_t& port = 514, const char* appName = "EM")
+      : _server(server), _port(port), _appName(appName) {}
+
+    void write(const uint32_t& timestamp, const char* text, const size_t& len) override
+    {
+      (void) timestamp;
+
+      for (size_t i = 0; i < len; i++)
+      {
+        if (text[i] == '\n')
+        {
+          sendLine();
+        }
+        else if (text[i] != '\r')
+        {
+          if (_lineLen == sizeof(_line))
+            sendLine();
+
+          _line[_lineLen++] = text[i];
+        }
+      }
+    }
+
+  private:
+
+    void sendLine()
+    {
+      if (_lineLen == 0)
+        return;
+
+      // Facility local0, severity debug
+      char header[32];
+      int  headerLen = snprintf(header, sizeof(header), "<191>%s: ", _appName);
+
+      if (_udp.beginPacket(_server, _port))
+      {
+        _udp.write((const uint8_t *) header, headerLen);
+        _udp.write((const uint8_t *) _line, _lineLen);
+        _udp.endPacket();
+      }
+
+      _lineLen = 0;
+    }
+
+    WiFiUDP       _udp;
+
+    IPAddress     _server;
+    uint16_t      _port;
+    const char*   _appName;
+
+    char          _line[EM_LOG_SLOT_SIZE];
+    size_t        _lineLen = 0;
+};
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+class ESP32_EMLog
+{
+  public:
+
+    static ESP32_EMLog& instance()
+    {
+      static ESP32_EMLog log;
+
+      return log;
+    }
+
+    // Optional, to choose the sink before the first record. Default is DBG_PORT_ESP_EM
+    bool begin(ESP32_EMLogSink* sink = NULL)
+    {
+      if (sink != NULL)
+        _sink = sink;
+
+      bool expected = false;
+
+      if (!_started.compare_exchange_strong(expected, true))
+        return true;
+
+      if (xTaskCreate(drainTask, "EM_Log", EM_LOG_TASK_STACK_SIZE, this, EM_LOG_TASK_PRIORITY, NULL) != pdPASS)
+      {
+        _started = false;
+
+        return false;
+      }
+
+      return true;
+    }
+
+    inline void setSink(ESP32_EMLogSink* sink)
+    {
+      _sink = sink;
+    }
+
+    // Safe from any task, never blocks. Returns false if the ring is full
+    bool push(const char* text, const size_t& len)
+    {
+      if (!_started)
+        begin();
+
+      uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+      Slot*    slot;
+
+      while (true)
+      {
+        slot = &_slots[pos & (EM_LOG_SLOTS - 1)];
+
+        int32_t diff = (int32_t) (slot->sequence.load(std::memory_order_acquire) - pos);
+
+        if (diff == 0)
+        {
+          if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+        }
+        else if (diff < 0)
+        {
+          _overflows.fetch_add(1, std::memory_order_relaxed);
+
+          return false;
+        }
+        else
+        {
+          pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+      }
+
+      slot->timestamp = millis();
+      slot->len       = len;
+      memcpy(slot->text, text, len);
+
+      slot->sequence.store(pos + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    // Write all queued records to the sink. Called by the drain task, only one consumer at a time
+    void drain()
+    {
+      bool drained = false;
+
+      while (true)
+      {
+        uint32_t pos  = _dequeuePos.load(std::memory_order_relaxed);
+        Slot*    slot = &_slots[pos & (EM_LOG_SLOTS - 1)];
+
+        if (slot->sequence.load(std::memory_order_acquire) != pos + 1)
+          break;
+
+        _dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+        _sink->write(slot->timestamp, slot->text, slot->len);
+
+        slot->sequence.store(pos + EM_LOG_SLOTS, std::memory_order_release);
+
+        drained = true;
+      }
+
+      uint32_t overflows = _overflows.load(std::memory_order_relaxed);
+
+      if (overflows != _reportedOverflows)
+      {
+        char text[48];
+
+        int len = snprintf(text, sizeof(text), "[EM] Log ring full, %lu records dropped\n",
+                           (unsigned long) (overflows - _reportedOverflows));
+
+        _sink->write(millis(), text, len);
+
+        _reportedOverflows  = overflows;
+        drained             = true;
+      }
+
+      if (drained)
+        _sink->flush();
+    }
+
+    // Records dropped because the ring was full, since boot
+    inline uint32_t getOverflowCount()
+    {
+      return _overflows.load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    typedef struct
+    {
+      std::atomic<uint32_t>   sequence;
+      uint32_t                timestamp;
+      uint16_t                len;
+      char                    text[EM_LOG_SLOT_SIZE];
+    }  Slot;
+
+    ESP32_EMLog() : _defaultSink(DBG_PORT_ESP_EM, !ESP32_ETH_MGR_BINARY_LOG)
+    {
+      for (uint32_t i = 0; i < EM_LOG_SLOTS; i++)
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+
+      _sink = &_defaultSink;
+    }
+
+    static void drainTask(void* param)
+    {
+      ESP32_EMLog* log = (ESP32_EMLog*) param;
+
+      while (true)
+      {
+        log->drain();
+
+        vTaskDelay(EM_LOG_DRAIN_INTERVAL / portTICK_PERIOD_MS);
+      }
+    }
+
+    Slot                    _slots[EM_LOG_SLOTS];
+
+    std::atomic<uint32_t>   _enqueuePos         { 0 };
+    std::atomic<uint32_t>   _dequeuePos         { 0 };
+    std::atomic<uint32_t>   _overflows          { 0 };
+    uint32_t                _reportedOverflows  = 0;
+
+    std::atomic<bool>       _started            { false };
+
+    ESP32_EMPrintLogSink    _defaultSink;
+    ESP32_EMLogSink*        _sink;
+};
+
+////////////////////////////////////////////////////
+
+// Formats one LOG* call on the stack, queued as one record when going out of scope.
+// A truncated record still ends with "\r\n", so that the next one starts its own line, with its timestamp
+class ESP32_EMLogLine : public Print
+{
+  public:
+
+    ~ESP32_EMLogLine()
+    {
+      if (_truncated)
+      {
+        _buffer[_len++] = '\r';
+        _buffer[_len++] = '\n';
+      }
+
+      if (_len > 0)
+        ESP32_EMLog::instance().push(_buffer, _len);
+    }
+
+    size_t write(uint8_t c) override
+    {
+      return write(&c, 1);
+    }
+
+    size_t write(const uint8_t *buffer, size_t size) override
+    {
+      if (size > EM_LOG_TEXT_SIZE - _len)
+      {
+        size        = EM_LOG_TEXT_SIZE - _len;
+        _truncated  = true;
+      }
+
+      memcpy(_buffer + _len, buffer, size);
+      _len += size;
+
+      return size;
+    }
+
+    using Print::write;
+
+  private:
+
+    char    _buffer[EM_LOG_SLOT_SIZE];
+    size_t  _len        = 0;
+    bool    _truncated  = false;
+};
+
+////////////////////////////////////////////////////
+
+#endif    // ESP32_W5500_Manager_Log_H
@@ -0,0 +1,197 @@
+// autogenerated by utils/gen_portal_assets.py from src/ESP32_W5500_Manager.hpp. Do not edit.
+//
+// gzip-compressed Config Portal assets, served as /em.css and /tz.js
+
+#pragma once
+
+#ifndef EM_ASSETS_H
+#define EM_ASSETS_H
+
+////////////////////////////////////////////////////
+
+// 834 bytes, 1471 bytes uncompressed
+const uint8_t EM_ASSET_CSS[] PROGMEM =
+{
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x54, 0x6b, 0x6f, 0xa3, 0x38,
+  0x14, 0xfd, 0x2b, 0x48, 0xd5, 0xa8, 0xed, 0x28, 0x24, 0x90, 0x57, 0x0b, 0xa8, 0xa3, 0x4d, 0x32,
+  0x34, 0x6d, 0x27, 0x4d, 0xda, 0x66, 0x92, 0xc9, 0x64, 0xb5, 0x1f, 0x0c, 0x36, 0xc6, 0x05, 0x6c,
+  0x0a, 0x4e, 0x20, 0x41, 0xfc, 0xf7, 0xb5, 0x93, 0x92, 0x26, 0xdd, 0x95, 0x56, 0xcb, 0x17, 0xec,
+  0xeb, 0xfb, 0x38, 0xf7, 0x9e, 0x63, 0x43, 0xb2, 0x2e, 0x62, 0x00, 0x21, 0xa1, 0xd8, 0x6c, 0xc6,
+  0xb9, 0xe5, 0x31, 0xca, 0xd5, 0x94, 0x6c, 0x91, 0xa9, 0xa3, 0xc8, 0x2a, 0x1d, 0x06, 0x37, 0x35,
+  0x8e, 0x72, 0x0e, 0x12, 0x04, 0x6a, 0x84, 0xc6, 0x2b, 0x5e, 0x4b, 0x51, 0x88, 0x5c, 0x5e, 0x38,
+  0xc0, 0x0d, 0x70, 0xc2, 0x56, 0x14, 0x9a, 0x8a, 0x66, 0x39, 0x2c, 0x81, 0x28, 0x51, 0x13, 0x00,
+  0xc9, 0x2a, 0x95, 0x06, 0x99, 0xc8, 0x54, 0xf4, 0x6e, 0x9c, 0x2b, 0x29, 0xa0, 0xa9, 0x9a, 0xa2,
+  0x84, 0x78, 0x56, 0x04, 0x12, 0x4c, 0xa8, 0x38, 0x2f, 0xff, 0x3d, 0x29, 0x5b, 0xf1, 0x90, 0x50,
+  0x54, 0x25, 0xd8, 0x23, 0x51, 0xf4, 0xb6, 0x40, 0xb6, 0xaf, 0x20, 0x36, 0x32, 0x23, 0x0b, 0x09,
+  0x54, 0xce, 0x5c, 0xd7, 0xb5, 0x2a, 0xf0, 0xca, 0xb5, 0xf0, 0xc9, 0x08, 0xe4, 0xbe, 0xa9, 0x18,
+  0xda, 0x97, 0xb2, 0xee, 0x70, 0xaa, 0x80, 0x42, 0x96, 0x51, 0x21, 0x72, 0x59, 0x02, 0x38, 0x61,
+  0xa2, 0x32, 0x65, 0x14, 0x95, 0x75, 0x57, 0x24, 0x07, 0xa2, 0x50, 0x52, 0x54, 0x88, 0xc0, 0x8a,
+  0xb3, 0xe3, 0xf8, 0x3f, 0x22, 0x04, 0x09, 0xb8, 0x88, 0x08, 0x55, 0xf7, 0x56, 0xbd, 0xa9, 0x69,
+  0x71, 0x7e, 0x59, 0xfc, 0x47, 0x6c, 0x4b, 0xc4, 0xfe, 0x33, 0xf8, 0xaa, 0x2b, 0xe0, 0x5d, 0x2a,
+  0x80, 0x42, 0xe5, 0x22, 0x02, 0xf9, 0xff, 0x4b, 0xd9, 0x91, 0x29, 0x65, 0x3f, 0x35, 0xbf, 0x59,
+  0x1c, 0x8d, 0xa5, 0x89, 0xa2, 0xd2, 0xd7, 0x8f, 0x2d, 0x2d, 0x61, 0x91, 0x8e, 0x27, 0xe4, 0x9c,
+  0x69, 0x00, 0x7d, 0xe6, 0xe7, 0x78, 0xa0, 0x9a, 0xe5, 0xb2, 0x90, 0x89, 0xc5, 0x99, 0xe7, 0x79,
+  0x96, 0xbb, 0x4a, 0x52, 0xb9, 0x89, 0x19, 0xa1, 0x1c, 0x25, 0x16, 0x24, 0x69, 0x1c, 0x82, 0x8d,
+  0xa9, 0x10, 0x2a, 0x99, 0x51, 0x9d, 0x90, 0xb9, 0xc1, 0x81, 0x47, 0x21, 0x19, 0x11, 0x7f, 0xe0,
+  0x40, 0x17, 0xed, 0xec, 0xd8, 0x52, 0x74, 0xfd, 0x83, 0x0e, 0x5d, 0x7b, 0xe7, 0xc3, 0xf4, 0xd9,
+  0x5a, 0xf4, 0x78, 0x0a, 0xce, 0x80, 0xfb, 0x33, 0xe0, 0x72, 0xb2, 0x46, 0xb5, 0xdd, 0xda, 0x63,
+  0xee, 0x2a, 0xfd, 0xe4, 0x77, 0xed, 0x94, 0x21, 0x70, 0x50, 0xf8, 0xed, 0x6b, 0xf1, 0x09, 0x53,
+  0xe9, 0xb1, 0x24, 0x3a, 0x36, 0x1f, 0x63, 0x54, 0x1d, 0xc6, 0x39, 0x8b, 0xf6, 0xd8, 0x0e, 0xaa,
+  0xdb, 0x57, 0xd8, 0x6b, 0xef, 0x7d, 0xbd, 0x57, 0x60, 0x55, 0x7a, 0x3f, 0xae, 0x6a, 0x30, 0x1d,
+  0xe0, 0x94, 0xf5, 0x28, 0xc5, 0xa7, 0x90, 0x20, 0xf2, 0xaa, 0xb9, 0x86, 0xc8, 0x13, 0x6a, 0xef,
+  0x7c, 0x48, 0xb3, 0x63, 0xc0, 0xa3, 0xb1, 0xd4, 0x3b, 0x92, 0x98, 0xb7, 0xc2, 0x0b, 0x19, 0x10,
+  0x7e, 0x09, 0xc1, 0x3e, 0xaf, 0xa6, 0xd3, 0x95, 0x5c, 0xec, 0x64, 0x0a, 0x42, 0x82, 0xe9, 0xfb,
+  0x69, 0x59, 0x0f, 0x4f, 0x8a, 0xad, 0x92, 0xf0, 0xe2, 0x1c, 0x02, 0x0e, 0x4c, 0x12, 0x01, 0x8c,
+  0x1a, 0x31, 0xc5, 0x96, 0x03, 0x52, 0xd4, 0x6d, 0xd7, 0xc8, 0xbc, 0x3f, 0x79, 0xc9, 0xb4, 0x1f,
+  0x43, 0xcc, 0x7a, 0xe2, 0x1b, 0x4f, 0x67, 0xbe, 0x3d, 0xc3, 0x62, 0x35, 0x90, 0xdb, 0x1e, 0x1e,
+  0xf4, 0x1e, 0xc5, 0xaf, 0x6f, 0xc7, 0xf7, 0xc9, 0x50, 0x1a, 0x46, 0xf3, 0xfe, 0xe3, 0xdc, 0x5e,
+  0x34, 0x1a, 0x8d, 0x6b, 0xbb, 0x9f, 0x79, 0xfd, 0x2c, 0x1d, 0x65, 0xd7, 0x4f, 0xbd, 0xed, 0xf8,
+  0x15, 0x0c, 0x70, 0x7b, 0xfc, 0x73, 0x3e, 0x9f, 0xbd, 0x3e, 0x90, 0xe5, 0xf7, 0x97, 0xd9, 0x6c,
+  0x76, 0x9b, 0x43, 0xb2, 0x1c, 0x4e, 0x7d, 0xd6, 0x9d, 0x4c, 0x83, 0xce, 0x13, 0x6e, 0xa3, 0xdb,
+  0x0d, 0xbc, 0xfb, 0x39, 0x78, 0x05, 0x5e, 0x4b, 0xe6, 0x5a, 0xda, 0xa1, 0xfd, 0x3c, 0x7f, 0x6e,
+  0xbf, 0xa2, 0xe6, 0x78, 0x9a, 0x5d, 0xf5, 0xee, 0x7b, 0xbe, 0xdd, 0x07, 0xd1, 0x0f, 0x6a, 0x5c,
+  0x35, 0x56, 0x8f, 0x0b, 0x7b, 0xd8, 0x5f, 0xb3, 0x6d, 0xf0, 0xcb, 0x31, 0x06, 0xcd, 0x65, 0xde,
+  0xce, 0xb7, 0xbf, 0x36, 0x41, 0xdf, 0xbf, 0xed, 0xa1, 0xdf, 0xb1, 0x81, 0x83, 0xd1, 0x66, 0x69,
+  0x6b, 0xdb, 0xfb, 0x47, 0xca, 0x0c, 0xda, 0xc6, 0xba, 0xe1, 0x47, 0xf0, 0x77, 0xcb, 0x48, 0xdd,
+  0xec, 0x6d, 0x1e, 0x4c, 0x16, 0x20, 0x8f, 0x7d, 0x6d, 0x39, 0x58, 0x3c, 0xbb, 0x6f, 0xf9, 0x34,
+  0xc6, 0xcf, 0xf1, 0x64, 0x0c, 0x3a, 0x46, 0x16, 0xbc, 0x7c, 0x9f, 0x8c, 0x8c, 0x16, 0xea, 0x2d,
+  0xd6, 0x24, 0xca, 0x42, 0xe7, 0xc9, 0xc9, 0xb2, 0x79, 0x0f, 0xe1, 0xd1, 0x54, 0xbf, 0x1b, 0x7a,
+  0xcb, 0x5d, 0xcb, 0xfd, 0x87, 0x97, 0x59, 0xc7, 0x4e, 0x82, 0x07, 0x8c, 0xf1, 0xcd, 0xcd, 0xf9,
+  0xa5, 0xb8, 0xf4, 0x6a, 0x82, 0x62, 0x04, 0xb8, 0x22, 0x89, 0x52, 0x5c, 0xb4, 0x93, 0xf6, 0xc7,
+  0x7c, 0xab, 0x77, 0x46, 0xb0, 0xb4, 0x93, 0xc4, 0x9f, 0x7c, 0x13, 0xa3, 0x9b, 0x73, 0xd7, 0x47,
+  0x6e, 0xe0, 0xb0, 0xfc, 0xfc, 0xaf, 0x8a, 0x39, 0x19, 0x5e, 0x11, 0xd7, 0x94, 0x82, 0xaa, 0x73,
+  0xe0, 0x84, 0x48, 0xe1, 0xf0, 0xf0, 0x8a, 0x4a, 0xae, 0x8f, 0xf9, 0x94, 0x21, 0x07, 0x37, 0xf9,
+  0x9e, 0x7e, 0x33, 0x29, 0xf7, 0x55, 0xd7, 0x27, 0x21, 0xbc, 0x68, 0x52, 0x55, 0xbf, 0x3c, 0x26,
+  0xfa, 0x0c, 0x42, 0x58, 0x7a, 0x04, 0x85, 0x30, 0x45, 0xbc, 0x38, 0xbd, 0xb5, 0x5a, 0xbd, 0x93,
+  0x88, 0xdc, 0xef, 0x77, 0x4f, 0x54, 0xb7, 0xca, 0xbf, 0x01, 0xdd, 0x95, 0x52, 0xe4, 0xbf, 0x05,
+  0x00, 0x00,
+};
+
+const char EM_ASSET_CSS_ETAG[] PROGMEM = "\"5845ca9b8f7bfbc6\"";
+
+////////////////////////////////////////////////////
+
+// 1816 bytes, 5452 bytes uncompressed
+const uint8_t EM_ASSET_TZ_JS[] PROGMEM =
+{
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x58, 0x6d, 0x4f, 0xdb, 0x3a,
+  0x14, 0xfe, 0x2b, 0xdd, 0x17, 0x92, 0x88, 0xb4, 0xf4, 0x85, 0xb6, 0xd0, 0xae, 0x43, 0xbc, 0x0d,
+  0xd8, 0x60, 0x43, 0x17, 0xee, 0xae, 0xb8, 0x55, 0x55, 0x99, 0xc6, 0x6d, 0xbc, 0xa6, 0x36, 0xd7,
+  0x76, 0x60, 0x0c, 0xf5, 0xbf, 0xdf, 0xe3, 0x24, 0x4e, 0x9c, 0xc4, 0x48, 0x13, 0x12, 0x4a, 0xce,
+  0x9b, 0x8f, 0x8f, 0x8f, 0x9f, 0xe7, 0xa4, 0xee, 0x32, 0xa6, 0x0b, 0x49, 0x18, 0x75, 0xb1, 0xf7,
+  0xf6, 0x8c, 0x78, 0x43, 0x4e, 0x72, 0x89, 0xf7, 0xe6, 0xc4, 0x02, 0x37, 0x84, 0xe4, 0x64, 0x21,
+  0x9d, 0xb1, 0xd2, 0xe2, 0x89, 0x23, 0x1c, 0x9f, 0x4e, 0xea, 0x5e, 0x4d, 0xdc, 0x5a, 0x61, 0x79,
+  0x4f, 0x36, 0xf8, 0x37, 0xa3, 0xf8, 0xfb, 0x72, 0x29, 0xb0, 0x74, 0xbd, 0x31, 0xc7, 0x32, 0xe6,
+  0xb4, 0x21, 0x3f, 0x4c, 0x26, 0x34, 0x8e, 0xa2, 0x23, 0x39, 0x6a, 0x6f, 0x7d, 0x6e, 0xf8, 0xfb,
+  0xd2, 0xa7, 0x69, 0x0c, 0x3e, 0xa1, 0xf8, 0xa5, 0x71, 0x86, 0x24, 0xd6, 0x5e, 0x18, 0xbc, 0x62,
+  0x1a, 0xe0, 0x25, 0xa1, 0x38, 0xd8, 0xd9, 0xe1, 0x2d, 0x88, 0xf9, 0x19, 0xa2, 0x3c, 0x60, 0xc4,
+  0x61, 0x65, 0x3f, 0x11, 0x28, 0x07, 0x97, 0x66, 0x2f, 0x37, 0x8c, 0xca, 0xd0, 0x95, 0xf0, 0xb6,
+  0xf5, 0x49, 0x29, 0xcb, 0x2c, 0x24, 0x75, 0xc1, 0xd3, 0x6f, 0xfb, 0x5d, 0xcf, 0xdb, 0xfa, 0xe2,
+  0x7d, 0x8b, 0x7e, 0x6a, 0xc1, 0x2c, 0x3b, 0x4d, 0x36, 0x9a, 0x2e, 0xe4, 0x7d, 0x1a, 0x1e, 0x09,
+  0x37, 0x11, 0xe4, 0x79, 0x79, 0xde, 0x88, 0xd4, 0x44, 0xb0, 0x65, 0x15, 0x21, 0x2f, 0x47, 0x93,
+  0xc3, 0xd6, 0xa0, 0x12, 0xb1, 0x59, 0xed, 0x34, 0x3c, 0x71, 0x3d, 0x28, 0xb0, 0x70, 0x95, 0x0f,
+  0x3c, 0x37, 0x45, 0x51, 0x45, 0xfe, 0xb1, 0x7d, 0x24, 0x77, 0x1d, 0xbf, 0xe3, 0x8c, 0xf8, 0xa7,
+  0xf6, 0x11, 0x55, 0x8f, 0xbe, 0xb3, 0x8b, 0x47, 0x4a, 0xd8, 0x76, 0xb6, 0x3e, 0xaa, 0x86, 0xc3,
+  0x93, 0xb8, 0x70, 0x57, 0xe5, 0x95, 0x2d, 0x75, 0x44, 0xff, 0xc2, 0x11, 0xb9, 0xb2, 0xc5, 0x22,
+  0xc1, 0x68, 0x4b, 0x66, 0x67, 0x26, 0xa6, 0x78, 0x06, 0x5b, 0x5e, 0x5a, 0xb6, 0xac, 0x0f, 0xc6,
+  0xed, 0xb6, 0x3b, 0x6d, 0x7f, 0xe0, 0x77, 0xfa, 0xb0, 0x70, 0x5b, 0xfd, 0xa9, 0x5c, 0xdf, 0x9c,
+  0xe3, 0x0d, 0x86, 0x1e, 0x41, 0x7b, 0x67, 0x98, 0x3e, 0x63, 0xee, 0x8c, 0x4c, 0xfb, 0x8e, 0xdf,
+  0xf5, 0x3b, 0x3d, 0xbf, 0xa7, 0xed, 0x73, 0xe3, 0x1b, 0xf4, 0x1b, 0xc9, 0x08, 0xd1, 0xaa, 0x79,
+  0xcf, 0xb7, 0x59, 0x9f, 0x86, 0xf0, 0x7f, 0xc5, 0xfe, 0x34, 0x36, 0xfe, 0x45, 0x16, 0x6c, 0x7e,
+  0x4a, 0xe4, 0xeb, 0x9f, 0x85, 0x3f, 0x16, 0xb0, 0x69, 0xd8, 0x73, 0xd9, 0xba, 0xeb, 0x1f, 0xfa,
+  0x43, 0x8b, 0xf5, 0x1d, 0xa2, 0x92, 0xd4, 0xb2, 0x51, 0xd6, 0xd6, 0xd4, 0xd1, 0xe6, 0x89, 0xcd,
+  0x2f, 0x38, 0x82, 0x56, 0xae, 0x7b, 0x74, 0x3b, 0xd0, 0x6c, 0xb5, 0xfc, 0xa1, 0xbd, 0xf0, 0x33,
+  0x09, 0x70, 0x6d, 0xc3, 0xe0, 0x60, 0x4d, 0x88, 0xcd, 0x6f, 0x51, 0x1c, 0x59, 0xcc, 0x3b, 0x03,
+  0x4b, 0xfc, 0x6b, 0x26, 0xe6, 0xc7, 0x74, 0x85, 0x23, 0x2c, 0xac, 0x15, 0x3d, 0xb0, 0x6e, 0x19,
+  0xcd, 0xaf, 0x04, 0x7a, 0xc4, 0x51, 0xbd, 0xa4, 0x7d, 0x8b, 0xc7, 0x25, 0x7a, 0x46, 0x14, 0x55,
+  0x37, 0x0c, 0xe1, 0xe1, 0xf6, 0xd5, 0x8c, 0xbf, 0xe1, 0x97, 0xf9, 0x03, 0xe3, 0x6b, 0xab, 0xf9,
+  0xb0, 0x30, 0x17, 0x04, 0xed, 0x9d, 0x60, 0xc2, 0x63, 0x59, 0xcf, 0xbb, 0x3b, 0x2c, 0xba, 0xd2,
+  0x39, 0x8f, 0x39, 0x7b, 0xc2, 0x7b, 0x97, 0x38, 0x12, 0x84, 0xae, 0x89, 0xd5, 0x7a, 0xbf, 0x6a,
+  0x7d, 0x25, 0x24, 0xa2, 0x8f, 0x71, 0x64, 0xb1, 0x3e, 0x30, 0xab, 0xa8, 0xb2, 0x38, 0x43, 0x1b,
+  0x24, 0x16, 0xb1, 0xa8, 0x17, 0xa3, 0x63, 0xee, 0x4f, 0x99, 0x7e, 0xc1, 0x3c, 0x16, 0x28, 0xc2,
+  0x1b, 0x9b, 0xed, 0xa0, 0x6c, 0x7b, 0x01, 0xb7, 0xa2, 0x64, 0xd6, 0x3e, 0x4c, 0x97, 0x6f, 0xfb,
+  0xbd, 0xdc, 0x70, 0x99, 0xf5, 0x15, 0xe1, 0xac, 0x6a, 0xdb, 0xf3, 0xbb, 0x7d, 0xd3, 0xf6, 0x16,
+  0x2d, 0xc8, 0x92, 0x2c, 0xf6, 0x8e, 0xe3, 0xc5, 0x1a, 0x2e, 0x5b, 0x50, 0x4d, 0xe1, 0xc0, 0xef,
+  0x0e, 0x8c, 0x02, 0x6b, 0xf3, 0xcf, 0xe4, 0x67, 0xa5, 0x66, 0x6d, 0x5f, 0x15, 0x02, 0x92, 0xe9,
+  0x59, 0x4e, 0x3a, 0x22, 0x4b, 0xf4, 0xcb, 0xda, 0x49, 0x83, 0x9a, 0xf5, 0x05, 0x63, 0x02, 0xcf,
+  0x4f, 0xd0, 0xab, 0xd5, 0xbe, 0x9b, 0x9e, 0xa1, 0x79, 0x17, 0xc8, 0x7f, 0x31, 0x8e, 0x18, 0xb5,
+  0x9a, 0xf7, 0x2d, 0xe1, 0x03, 0x19, 0xa2, 0xc7, 0x3f, 0x6b, 0x8f, 0x1b, 0x26, 0x16, 0xec, 0xc5,
+  0x19, 0xc9, 0xac, 0xfa, 0x0f, 0x78, 0x0d, 0x1e, 0x9c, 0x40, 0x13, 0xf0, 0x55, 0x21, 0xfe, 0xbe,
+  0x11, 0xeb, 0xe2, 0xed, 0x2b, 0x47, 0x82, 0xb2, 0x57, 0xc4, 0x4d, 0xe1, 0x15, 0x5f, 0xc7, 0xd2,
+  0x14, 0x3c, 0xa0, 0x8a, 0xe0, 0x47, 0x84, 0x02, 0xf2, 0xcc, 0x84, 0x64, 0x66, 0x2c, 0xb4, 0x59,
+  0x84, 0x48, 0xae, 0x51, 0x22, 0xd2, 0x59, 0x11, 0xaa, 0x1d, 0x63, 0x60, 0x5f, 0xa8, 0x2e, 0xda,
+  0xbb, 0xc5, 0x5c, 0x86, 0xe5, 0xc3, 0x3e, 0x50, 0x77, 0xa3, 0x93, 0x6f, 0x6a, 0x9b, 0xe3, 0x3c,
+  0x00, 0xb9, 0x7e, 0x79, 0x0b, 0x30, 0xec, 0x67, 0x03, 0x04, 0x3a, 0x42, 0x7e, 0x00, 0x8e, 0x73,
+  0x22, 0xe6, 0x81, 0x90, 0x23, 0xe6, 0xc3, 0xff, 0x39, 0xf4, 0x3b, 0x97, 0xf3, 0x25, 0xe3, 0xa3,
+  0xe5, 0x76, 0x0b, 0x4c, 0x51, 0xd0, 0x43, 0x89, 0x05, 0x6a, 0x73, 0x80, 0x0d, 0xf4, 0xa7, 0x55,
+  0x89, 0x05, 0xea, 0x67, 0x16, 0x40, 0x9f, 0xd6, 0x44, 0x76, 0x1c, 0x9f, 0xd9, 0xf0, 0x77, 0x5a,
+  0x97, 0x59, 0x40, 0xfd, 0x1d, 0x2c, 0x9e, 0xd9, 0x01, 0x77, 0x6a, 0x93, 0xda, 0xb0, 0x76, 0x56,
+  0x01, 0xa4, 0x69, 0xe9, 0xb5, 0x8e, 0x41, 0x75, 0x9c, 0xa9, 0x62, 0x49, 0x0d, 0x30, 0x4c, 0x54,
+  0x98, 0xd9, 0x6e, 0xf3, 0xb4, 0x2e, 0xab, 0xdc, 0xe2, 0xd9, 0x3b, 0xb0, 0x3f, 0xb5, 0x8a, 0xdf,
+  0x41, 0xfc, 0x99, 0x0d, 0xaa, 0xa7, 0x55, 0xac, 0xb7, 0x18, 0xcd, 0x2c, 0x30, 0x31, 0xb5, 0x60,
+  0x41, 0xdd, 0x6c, 0x66, 0xb9, 0xd3, 0xd3, 0x3a, 0x2a, 0xd4, 0xad, 0xf4, 0xb1, 0x9c, 0xc5, 0x8f,
+  0x88, 0x28, 0x9f, 0xf2, 0x65, 0xcf, 0xd5, 0x21, 0x52, 0xd7, 0x6e, 0x6a, 0xbb, 0xf9, 0xda, 0xe6,
+  0x0b, 0x98, 0x70, 0x59, 0x58, 0x25, 0x40, 0xa0, 0x95, 0x77, 0x21, 0xa2, 0xab, 0x30, 0x5d, 0xa2,
+  0x06, 0x0c, 0xf5, 0xbb, 0xab, 0xdd, 0xee, 0xd9, 0xfa, 0x95, 0xe5, 0x3e, 0x1a, 0x37, 0x66, 0xa6,
+  0xc3, 0x09, 0x27, 0xe2, 0x11, 0x51, 0x5c, 0x64, 0x87, 0x72, 0x2b, 0x7d, 0xb6, 0xdf, 0x58, 0xbc,
+  0xc1, 0x45, 0x66, 0x26, 0xba, 0x18, 0x56, 0xf7, 0x88, 0xa3, 0x97, 0xc2, 0xaa, 0x80, 0x9b, 0x59,
+  0x4e, 0x23, 0x5f, 0x18, 0xec, 0x03, 0xc6, 0xbf, 0x14, 0xf2, 0xa6, 0x46, 0xc3, 0x55, 0x98, 0x26,
+  0x6f, 0x77, 0xb4, 0x0a, 0x03, 0x14, 0x98, 0x95, 0x4d, 0x00, 0x6b, 0xa6, 0x26, 0x7b, 0x6c, 0xce,
+  0xdd, 0x7a, 0x08, 0xa5, 0x53, 0x3e, 0x03, 0x39, 0x6e, 0x45, 0x98, 0xae, 0x64, 0x08, 0x83, 0x77,
+  0x1b, 0x46, 0x6b, 0x3c, 0x6d, 0xcf, 0xc6, 0x80, 0x3d, 0xee, 0x58, 0x7c, 0x24, 0x63, 0xb1, 0x3b,
+  0xe9, 0x78, 0x6f, 0x4a, 0x2a, 0x66, 0x63, 0xb2, 0x84, 0xf1, 0xd4, 0x80, 0x2b, 0xf5, 0x66, 0xc2,
+  0x95, 0xcb, 0x3c, 0x0f, 0x26, 0xf6, 0x09, 0xcb, 0x60, 0x6e, 0xbb, 0x2d, 0x4d, 0xf3, 0xf9, 0x30,
+  0x2f, 0x5f, 0x9f, 0x30, 0x5b, 0x36, 0xd4, 0xfa, 0x1f, 0x26, 0x4e, 0xfe, 0x2d, 0xe1, 0xe4, 0x58,
+  0x09, 0xd3, 0xf5, 0xce, 0x8e, 0x1a, 0xb9, 0xdf, 0x28, 0xda, 0xe0, 0x51, 0x3d, 0x02, 0x57, 0xa1,
+  0xb3, 0x51, 0x79, 0xf2, 0x96, 0x3f, 0x16, 0x53, 0x33, 0x20, 0x61, 0x73, 0xd8, 0x05, 0x00, 0x76,
+  0x46, 0xce, 0xb9, 0x5c, 0xec, 0x5d, 0xdc, 0xdc, 0xef, 0x76, 0xba, 0x50, 0xbb, 0xe6, 0x60, 0x90,
+  0x4a, 0xf5, 0x59, 0xdc, 0x02, 0x3a, 0xcd, 0x6f, 0x53, 0x88, 0x6a, 0x0e, 0xda, 0x6d, 0x35, 0xc7,
+  0x17, 0x58, 0x15, 0xa0, 0xb5, 0x96, 0x9b, 0x4e, 0x97, 0x8c, 0xb2, 0x28, 0x8e, 0x62, 0xa5, 0xeb,
+  0x0f, 0xcb, 0xba, 0x1b, 0xc4, 0xe1, 0x12, 0x08, 0x24, 0x12, 0xe5, 0x7e, 0x59, 0x79, 0x81, 0x36,
+  0x8f, 0x24, 0x41, 0xe1, 0x44, 0x55, 0x5a, 0x8b, 0x2e, 0x42, 0xc6, 0xd1, 0x0a, 0x2b, 0xe5, 0xfe,
+  0x41, 0x59, 0x59, 0x06, 0x83, 0x44, 0x5d, 0xda, 0x04, 0x91, 0x0b, 0xe8, 0x06, 0x9a, 0xe8, 0xb2,
+  0x6d, 0x6b, 0xd7, 0xdb, 0x90, 0x61, 0x4a, 0x7e, 0x69, 0x95, 0x19, 0x35, 0xa7, 0x84, 0x66, 0x6f,
+  0x50, 0x76, 0xba, 0x88, 0xe1, 0x98, 0x37, 0x28, 0x42, 0x5a, 0x69, 0xba, 0x15, 0x8c, 0x90, 0xaa,
+  0x7c, 0x61, 0xa4, 0x72, 0x8e, 0x84, 0xcc, 0x62, 0xb6, 0xcb, 0x31, 0x4f, 0xd8, 0x8a, 0x49, 0xa4,
+  0x35, 0x66, 0xc0, 0x1c, 0x97, 0x40, 0xd7, 0x1d, 0x96, 0xbd, 0x4e, 0xe1, 0xae, 0x2c, 0xd2, 0x62,
+  0x76, 0x2b, 0x15, 0xd3, 0x98, 0x94, 0xa9, 0x4c, 0x2f, 0x05, 0x93, 0x6c, 0x7e, 0xc6, 0x80, 0x63,
+  0xd3, 0x44, 0x13, 0xdf, 0x24, 0x51, 0x0b, 0x35, 0x35, 0xbb, 0x9d, 0x72, 0xe4, 0x3b, 0x39, 0x87,
+  0x0b, 0x48, 0x93, 0x55, 0x3b, 0x95, 0xa3, 0xd0, 0x80, 0x96, 0xa9, 0xcc, 0x55, 0x8f, 0xf9, 0x0a,
+  0x43, 0x50, 0x0a, 0x7b, 0x8d, 0x31, 0x55, 0x47, 0x46, 0x38, 0x2e, 0x82, 0x94, 0x96, 0x2f, 0xb1,
+  0x58, 0xb3, 0x53, 0xe9, 0xd5, 0xae, 0x16, 0x76, 0xaa, 0x42, 0x7d, 0x16, 0x8a, 0xb9, 0xa5, 0x22,
+  0x98, 0xdf, 0x2c, 0x5b, 0x43, 0x1f, 0xa1, 0xd6, 0x9c, 0xa2, 0x27, 0x3c, 0xff, 0x81, 0x79, 0xa0,
+  0x3a, 0xaa, 0x08, 0xff, 0xf7, 0xfd, 0x69, 0xf2, 0x9e, 0x44, 0x4e, 0x91, 0xe2, 0x9a, 0xd1, 0x20,
+  0x01, 0xed, 0x41, 0x49, 0x7c, 0x82, 0x79, 0x44, 0x32, 0x71, 0x12, 0x39, 0xc5, 0x9d, 0x6b, 0x28,
+  0x9a, 0xc8, 0x8c, 0xd3, 0x2d, 0xa5, 0xf2, 0x7f, 0x08, 0x0d, 0xa0, 0xd7, 0xd4, 0x29, 0xea, 0xcc,
+  0xcb, 0xcc, 0xab, 0x37, 0x69, 0x83, 0x38, 0xd0, 0xea, 0x62, 0x9a, 0x68, 0x96, 0x8a, 0x8d, 0x9c,
+  0x32, 0xba, 0xf0, 0x9d, 0xfc, 0xc8, 0x12, 0xf4, 0xc6, 0x21, 0x0c, 0x0f, 0x4a, 0xba, 0x6f, 0x04,
+  0x49, 0xa9, 0x26, 0x15, 0x16, 0xd9, 0x00, 0x68, 0x2b, 0xd9, 0xd0, 0x30, 0xfc, 0x8a, 0x52, 0xda,
+  0xcf, 0xfb, 0xb2, 0xce, 0x3d, 0xa9, 0xd2, 0xf0, 0x80, 0xae, 0x0c, 0x55, 0xf0, 0x5e, 0xcf, 0x14,
+  0xb3, 0x08, 0x9c, 0x54, 0x8f, 0xf7, 0xf6, 0xfb, 0xa6, 0xb5, 0x0c, 0x37, 0x30, 0x04, 0xa8, 0x85,
+  0xf3, 0x9b, 0x56, 0xb0, 0x5d, 0x2a, 0xcc, 0x17, 0x4e, 0xe8, 0x0c, 0x64, 0x87, 0x86, 0xe1, 0x5f,
+  0x40, 0x6a, 0x2c, 0x39, 0xa2, 0x7d, 0xb3, 0xb4, 0x65, 0x6e, 0xcb, 0x6f, 0xbe, 0x49, 0x92, 0x20,
+  0x36, 0x0b, 0x9b, 0xd3, 0x63, 0x2a, 0xcf, 0x23, 0x69, 0xc6, 0xf3, 0x9d, 0x7e, 0x37, 0xcb, 0x3c,
+  0x27, 0xbe, 0xf3, 0x78, 0x91, 0x00, 0x81, 0xd2, 0x64, 0x27, 0x5e, 0xd7, 0x99, 0x35, 0xd6, 0xc4,
+  0x98, 0x8a, 0xf3, 0xb5, 0x53, 0x8e, 0x05, 0xa1, 0xae, 0x7d, 0x1e, 0xe5, 0x0c, 0xf1, 0x97, 0xa4,
+  0xd3, 0x94, 0xaa, 0xba, 0xc4, 0x71, 0x80, 0x23, 0x44, 0x92, 0x2e, 0xd6, 0x38, 0x6c, 0x21, 0xe5,
+  0x54, 0x99, 0xa7, 0x60, 0x32, 0x6f, 0xa6, 0xaa, 0x84, 0xbd, 0x7b, 0x0d, 0x28, 0x56, 0x23, 0xce,
+  0xa0, 0x57, 0x57, 0x5e, 0x33, 0x1e, 0xcc, 0x2f, 0xd9, 0x4b, 0x12, 0xd7, 0x3c, 0x9c, 0x82, 0xab,
+  0x53, 0x85, 0x89, 0xc2, 0x19, 0xf9, 0x83, 0xe2, 0xb0, 0xaa, 0xe0, 0x4b, 0xe8, 0x0c, 0xd0, 0x28,
+  0x4e, 0x2a, 0xe3, 0xa5, 0x31, 0x20, 0x6a, 0xc2, 0xaa, 0x8c, 0x09, 0xa0, 0x18, 0xf4, 0x2b, 0x5e,
+  0xa7, 0x90, 0x43, 0x88, 0xd4, 0x24, 0x3a, 0xac, 0x50, 0xc1, 0x3d, 0xa3, 0x2b, 0x68, 0xc1, 0xa7,
+  0x38, 0xd3, 0x55, 0x56, 0x7b, 0x22, 0x2a, 0xe0, 0x41, 0x85, 0x96, 0xbe, 0x12, 0x4e, 0x80, 0x3b,
+  0x91, 0x24, 0x0e, 0x90, 0x69, 0x4a, 0xcf, 0xf8, 0xd7, 0x13, 0xe3, 0x52, 0x94, 0x18, 0xfa, 0x28,
+  0x13, 0xb6, 0x7e, 0x0a, 0xf9, 0x7b, 0x22, 0x47, 0x38, 0x7b, 0xd8, 0x7a, 0xae, 0x0c, 0x89, 0xf0,
+  0xc6, 0xc9, 0x77, 0x88, 0x66, 0xe1, 0x89, 0x52, 0xb6, 0xf2, 0x6f, 0x1d, 0xf8, 0x92, 0x59, 0x30,
+  0x2a, 0x58, 0x04, 0x13, 0x07, 0x5b, 0xb9, 0xce, 0x03, 0x8b, 0x79, 0x43, 0xff, 0x36, 0xd9, 0x20,
+  0x62, 0xe4, 0x34, 0x76, 0x73, 0xdf, 0x96, 0x62, 0x7e, 0xd7, 0xf3, 0xc6, 0x01, 0x5b, 0x40, 0x55,
+  0xa9, 0x54, 0xbf, 0xdd, 0x9d, 0xc3, 0xf0, 0x0d, 0x8f, 0x27, 0xaf, 0x57, 0x81, 0xeb, 0x68, 0x4b,
+  0xc7, 0x6b, 0x11, 0x80, 0x11, 0x7e, 0x79, 0x7f, 0x73, 0xdd, 0x98, 0x54, 0x03, 0x8c, 0xff, 0x07,
+  0x94, 0xbf, 0x9a, 0x58, 0x4c, 0x15, 0x00, 0x00,
+};
+
+const char EM_ASSET_TZ_JS_ETAG[] PROGMEM = "\"8bec2335b3fb8626\"";
+
+////////////////////////////////////////////////////
+
+#endif    // EM_ASSETS_H
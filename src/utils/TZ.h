@@ -533,6 +533,9 @@
 
 #define TIMEZONE_MAX_LEN      50
 
+// TZ_NAME[] and ESP_TZ_NAME[] are the source of the packed database in TZ_Pool.h, used by getTZ().
+// Run utils/gen_tz_pool.py after changing them. ESP_TZ_NAME[] must be in the same order as TZ_NAME[]
+
 static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
 {
 #if USING_AFRICA
@@ -590,7 +593,6 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "Africa/Windhoek",            //PSTR("CAT-2")
 #endif
 
-
 #if USING_AMERICA
   "America/Adak",               //PSTR("HST10HDT",M3.2.0",M11.1.0")
   "America/Anchorage",          //PSTR("AKST9AKDT",M3.2.0",M11.1.0")
@@ -642,8 +644,8 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "America/Edmonton",           //PSTR("MST7MDT",M3.2.0",M11.1.0")
   "America/Eirunepe",           //PSTR("<-05>5")
   "America/El_Salvador",        //PSTR("CST6")
-  "America/Fortaleza",          //PSTR("<-03>3")
   "America/Fort_Nelson",        //PSTR("MST7")
+  "America/Fortaleza",          //PSTR("<-03>3")
   "America/Glace_Bay",          //PSTR("AST4ADT",M3.2.0",M11.1.0")
   "America/Godthab",            //PSTR("<-03>3<-02>",M3.5.0/-2",M10.5.0/-1")
   "America/Goose_Bay",          //PSTR("AST4ADT",M3.2.0",M11.1.0")
@@ -705,8 +707,8 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "America/Pangnirtung",        //PSTR("EST5EDT",M3.2.0",M11.1.0")
   "America/Paramaribo",         //PSTR("<-03>3")
   "America/Phoenix",            //PSTR("MST7")
-  "America/PortmaumPrince",     //PSTR("EST5EDT",M3.2.0",M11.1.0")
   "America/Port_of_Spain",      //PSTR("AST4")
+  "America/PortmaumPrince",     //PSTR("EST5EDT",M3.2.0",M11.1.0")
   "America/Porto_Velho",        //PSTR("<-04>4")
   "America/Puerto_Rico",        //PSTR("AST4")
   "America/Punta_Arenas",       //PSTR("<-03>3")
@@ -851,8 +853,8 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "Atlantic/Madeira",           //PSTR("WET0WEST",M3.5.0/1",M10.5.0")
   "Atlantic/Reykjavik",         //PSTR("GMT0")
   "Atlantic/South_Georgia",     //PSTR("<-02>2")
-  "Atlantic/Stanley",           //PSTR("<-03>3")
   "Atlantic/St_Helena",         //PSTR("GMT0")
+  "Atlantic/Stanley",           //PSTR("<-03>3")
 #endif
 
 #if USING_AUSTRALIA
@@ -870,6 +872,44 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "Australia/Sydney",           //PSTR("AEST-10AEDT",M10.1.0",M4.1.0/3")
 #endif
 
+#if USING_ETC_GMT
+  "Etc/GMT",                    //PSTR("GMT0")
+  "Etc/GMT0",                   //PSTR("GMT0")
+  "Etc/GMTm0",                  //PSTR("GMT0")
+  "Etc/GMTm1",                  //PSTR("<+01>-1")
+  "Etc/GMTm10",                 //PSTR("<+10>-10")
+  "Etc/GMTm11",                 //PSTR("<+11>-11")
+  "Etc/GMTm12",                 //PSTR("<+12>-12")
+  "Etc/GMTm13",                 //PSTR("<+13>-13")
+  "Etc/GMTm14",                 //PSTR("<+14>-14")
+  "Etc/GMTm2",                  //PSTR("<+02>-2")
+  "Etc/GMTm3",                  //PSTR("<+03>-3")
+  "Etc/GMTm4",                  //PSTR("<+04>-4")
+  "Etc/GMTm5",                  //PSTR("<+05>-5")
+  "Etc/GMTm6",                  //PSTR("<+06>-6")
+  "Etc/GMTm7",                  //PSTR("<+07>-7")
+  "Etc/GMTm8",                  //PSTR("<+08>-8")
+  "Etc/GMTm9",                  //PSTR("<+09>-9")
+  "Etc/GMTp0",                  //PSTR("GMT0")
+  "Etc/GMTp1",                  //PSTR("<-01>1")
+  "Etc/GMTp10",                 //PSTR("<-10>10")
+  "Etc/GMTp11",                 //PSTR("<-11>11")
+  "Etc/GMTp12",                 //PSTR("<-12>12")
+  "Etc/GMTp2",                  //PSTR("<-02>2")
+  "Etc/GMTp3",                  //PSTR("<-03>3")
+  "Etc/GMTp4",                  //PSTR("<-04>4")
+  "Etc/GMTp5",                  //PSTR("<-05>5")
+  "Etc/GMTp6",                  //PSTR("<-06>6")
+  "Etc/GMTp7",                  //PSTR("<-07>7")
+  "Etc/GMTp8",                  //PSTR("<-08>8")
+  "Etc/GMTp9",                  //PSTR("<-09>9")
+  "Etc/Greenwich",              //PSTR("GMT0")
+  "Etc/UCT",                    //PSTR("UTC0")
+  "Etc/UTC",                    //PSTR("UTC0")
+  "Etc/Universal",              //PSTR("UTC0")
+  "Etc/Zulu",                   //PSTR("UTC0")
+#endif
+
 #if USING_EUROPE
   "Europe/Amsterdam",           //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
   "Europe/Andorra",             //PSTR("CET-1CEST",M3.5.0",M10.5.0/3")
@@ -987,44 +1027,6 @@ static const char TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   "Pacific/Wake",               //PSTR("<+12>-12")
   "Pacific/Wallis",             //PSTR("<+12>-12")
 #endif
-
-#if USING_ETC_GMT
-  "Etc/GMT",                    //PSTR("GMT0")
-  "Etc/GMTm0",                  //PSTR("GMT0")
-  "Etc/GMTm1",                  //PSTR("<+01>-1")
-  "Etc/GMTm2",                  //PSTR("<+02>-2")
-  "Etc/GMTm3",                  //PSTR("<+03>-3")
-  "Etc/GMTm4",                  //PSTR("<+04>-4")
-  "Etc/GMTm5",                  //PSTR("<+05>-5")
-  "Etc/GMTm6",                  //PSTR("<+06>-6")
-  "Etc/GMTm7",                  //PSTR("<+07>-7")
-  "Etc/GMTm8",                  //PSTR("<+08>-8")
-  "Etc/GMTm9",                  //PSTR("<+09>-9")
-  "Etc/GMTm10",                 //PSTR("<+10>-10")
-  "Etc/GMTm11",                 //PSTR("<+11>-11")
-  "Etc/GMTm12",                 //PSTR("<+12>-12")
-  "Etc/GMTm13",                 //PSTR("<+13>-13")
-  "Etc/GMTm14",                 //PSTR("<+14>-14")
-  "Etc/GMT0",                   //PSTR("GMT0")
-  "Etc/GMTp0",                  //PSTR("GMT0")
-  "Etc/GMTp1",                  //PSTR("<-01>1")
-  "Etc/GMTp2",                  //PSTR("<-02>2")
-  "Etc/GMTp3",                  //PSTR("<-03>3")
-  "Etc/GMTp4",                  //PSTR("<-04>4")
-  "Etc/GMTp5",                  //PSTR("<-05>5")
-  "Etc/GMTp6",                  //PSTR("<-06>6")
-  "Etc/GMTp7",                  //PSTR("<-07>7")
-  "Etc/GMTp8",                  //PSTR("<-08>8")
-  "Etc/GMTp9",                  //PSTR("<-09>9")
-  "Etc/GMTp10",                 //PSTR("<-10>10")
-  "Etc/GMTp11",                 //PSTR("<-11>11")
-  "Etc/GMTp12",                 //PSTR("<-12>12")
-  "Etc/UCT",                    //PSTR("UTC0")
-  "Etc/UTC",                    //PSTR("UTC0")
-  "Etc/Greenwich",              //PSTR("GMT0")
-  "Etc/Universal",              //PSTR("UTC0")
-  "Etc/Zulu",                   //PSTR("UTC0")
-#endif
 };
 
 ////////////////////////////////////////////////////////////
@@ -1137,8 +1139,8 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_America_Edmonton,  //PSTR("MST7MDT,M3.2.0,M11.1.0")
   TZ_America_Eirunepe,  //PSTR("<-05>5")
   TZ_America_El_Salvador,  //PSTR("CST6")
-  TZ_America_Fortaleza,  //PSTR("<-03>3")
   TZ_America_Fort_Nelson,  //PSTR("MST7")
+  TZ_America_Fortaleza,  //PSTR("<-03>3")
   TZ_America_Glace_Bay,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
   TZ_America_Godthab,  //PSTR("<-03>3<-02>,M3.5.0/-2,M10.5.0/-1")
   TZ_America_Goose_Bay,  //PSTR("AST4ADT,M3.2.0,M11.1.0")
@@ -1200,8 +1202,8 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_America_Pangnirtung,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
   TZ_America_Paramaribo,  //PSTR("<-03>3")
   TZ_America_Phoenix,  //PSTR("MST7")
-  TZ_America_PortmaumPrince,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
   TZ_America_Port_of_Spain,  //PSTR("AST4")
+  TZ_America_PortmaumPrince,  //PSTR("EST5EDT,M3.2.0,M11.1.0")
   TZ_America_Porto_Velho,  //PSTR("<-04>4")
   TZ_America_Puerto_Rico,  //PSTR("AST4")
   TZ_America_Punta_Arenas,  //PSTR("<-03>3")
@@ -1252,7 +1254,6 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_Arctic_Longyearbyen,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
 #endif
 
-
 #if USING_ASIA
   TZ_Asia_Aden,  //PSTR("<+03>-3")
   TZ_Asia_Almaty,  //PSTR("<+06>-6")
@@ -1347,8 +1348,8 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_Atlantic_Madeira,  //PSTR("WET0WEST,M3.5.0/1,M10.5.0")
   TZ_Atlantic_Reykjavik,  //PSTR("GMT0")
   TZ_Atlantic_South_Georgia,  //PSTR("<-02>2")
-  TZ_Atlantic_Stanley,  //PSTR("<-03>3")
   TZ_Atlantic_St_Helena,  //PSTR("GMT0")
+  TZ_Atlantic_Stanley,  //PSTR("<-03>3")
 #endif
 
 #if USING_AUSTRALIA
@@ -1366,6 +1367,44 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_Australia_Sydney,  //PSTR("AEST-10AEDT,M10.1.0,M4.1.0/3")
 #endif
 
+#if USING_ETC_GMT
+  TZ_Etc_GMT,  //PSTR("GMT0")
+  TZ_Etc_GMT0,  //PSTR("GMT0")
+  TZ_Etc_GMTm0,  //PSTR("GMT0")
+  TZ_Etc_GMTm1,  //PSTR("<+01>-1")
+  TZ_Etc_GMTm10,  //PSTR("<+10>-10")
+  TZ_Etc_GMTm11,  //PSTR("<+11>-11")
+  TZ_Etc_GMTm12,  //PSTR("<+12>-12")
+  TZ_Etc_GMTm13,  //PSTR("<+13>-13")
+  TZ_Etc_GMTm14,  //PSTR("<+14>-14")
+  TZ_Etc_GMTm2,  //PSTR("<+02>-2")
+  TZ_Etc_GMTm3,  //PSTR("<+03>-3")
+  TZ_Etc_GMTm4,  //PSTR("<+04>-4")
+  TZ_Etc_GMTm5,  //PSTR("<+05>-5")
+  TZ_Etc_GMTm6,  //PSTR("<+06>-6")
+  TZ_Etc_GMTm7,  //PSTR("<+07>-7")
+  TZ_Etc_GMTm8,  //PSTR("<+08>-8")
+  TZ_Etc_GMTm9,  //PSTR("<+09>-9")
+  TZ_Etc_GMTp0,  //PSTR("GMT0")
+  TZ_Etc_GMTp1,  //PSTR("<-01>1")
+  TZ_Etc_GMTp10,  //PSTR("<-10>10")
+  TZ_Etc_GMTp11,  //PSTR("<-11>11")
+  TZ_Etc_GMTp12,  //PSTR("<-12>12")
+  TZ_Etc_GMTp2,  //PSTR("<-02>2")
+  TZ_Etc_GMTp3,  //PSTR("<-03>3")
+  TZ_Etc_GMTp4,  //PSTR("<-04>4")
+  TZ_Etc_GMTp5,  //PSTR("<-05>5")
+  TZ_Etc_GMTp6,  //PSTR("<-06>6")
+  TZ_Etc_GMTp7,  //PSTR("<-07>7")
+  TZ_Etc_GMTp8,  //PSTR("<-08>8")
+  TZ_Etc_GMTp9,  //PSTR("<-09>9")
+  TZ_Etc_Greenwich,  //PSTR("GMT0")
+  TZ_Etc_UCT,  //PSTR("UTC0")
+  TZ_Etc_UTC,  //PSTR("UTC0")
+  TZ_Etc_Universal,  //PSTR("UTC0")
+  TZ_Etc_Zulu,  //PSTR("UTC0")
+#endif
+
 #if USING_EUROPE
   TZ_Europe_Amsterdam,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
   TZ_Europe_Andorra,  //PSTR("CET-1CEST,M3.5.0,M10.5.0/3")
@@ -1483,44 +1522,6 @@ static const char ESP_TZ_NAME[][TIMEZONE_MAX_LEN] /*PROGMEM*/ =
   TZ_Pacific_Wake,  //PSTR("<+12>-12")
   TZ_Pacific_Wallis,  //PSTR("<+12>-12")
 #endif
-
-#if USING_ETC_GMT
-  TZ_Etc_GMT,  //PSTR("GMT0")
-  TZ_Etc_GMTm0,  //PSTR("GMT0")
-  TZ_Etc_GMTm1,  //PSTR("<+01>-1")
-  TZ_Etc_GMTm2,  //PSTR("<+02>-2")
-  TZ_Etc_GMTm3,  //PSTR("<+03>-3")
-  TZ_Etc_GMTm4,  //PSTR("<+04>-4")
-  TZ_Etc_GMTm5,  //PSTR("<+05>-5")
-  TZ_Etc_GMTm6,  //PSTR("<+06>-6")
-  TZ_Etc_GMTm7,  //PSTR("<+07>-7")
-  TZ_Etc_GMTm8,  //PSTR("<+08>-8")
-  TZ_Etc_GMTm9,  //PSTR("<+09>-9")
-  TZ_Etc_GMTm10,  //PSTR("<+10>-10")
-  TZ_Etc_GMTm11,  //PSTR("<+11>-11")
-  TZ_Etc_GMTm12,  //PSTR("<+12>-12")
-  TZ_Etc_GMTm13,  //PSTR("<+13>-13")
-  TZ_Etc_GMTm14,  //PSTR("<+14>-14")
-  TZ_Etc_GMT0,  //PSTR("GMT0")
-  TZ_Etc_GMTp0,  //PSTR("GMT0")
-  TZ_Etc_GMTp1,  //PSTR("<-01>1")
-  TZ_Etc_GMTp2,  //PSTR("<-02>2")
-  TZ_Etc_GMTp3,  //PSTR("<-03>3")
-  TZ_Etc_GMTp4,  //PSTR("<-04>4")
-  TZ_Etc_GMTp5,  //PSTR("<-05>5")
-  TZ_Etc_GMTp6,  //PSTR("<-06>6")
-  TZ_Etc_GMTp7,  //PSTR("<-07>7")
-  TZ_Etc_GMTp8,  //PSTR("<-08>8")
-  TZ_Etc_GMTp9,  //PSTR("<-09>9")
-  TZ_Etc_GMTp10,  //PSTR("<-10>10")
-  TZ_Etc_GMTp11,  //PSTR("<-11>11")
-  TZ_Etc_GMTp12,  //PSTR("<-12>12")
-  TZ_Etc_UCT,  //PSTR("UTC0")
-  TZ_Etc_UTC,  //PSTR("UTC0")
-  TZ_Etc_Greenwich,  //PSTR("GMT0")
-  TZ_Etc_Universal,  //PSTR("UTC0")
-  TZ_Etc_Zulu,  //PSTR("UTC0")
-#endif
 };
 
 #endif // TZDB_H
@@ -0,0 +1,1282 @@
+// autogenerated by utils/gen_tz_pool.py from src/utils/TZ.h. Do not edit.
+//
+// Packed timezone database used by ESP32_W5500_Manager::getTZ()
+
+#pragma once
+
+#ifndef TZ_POOL_H
+#define TZ_POOL_H
+
+typedef struct
+{
+  const char*     prefix;       // "Region/"
+  const char*     names;        // zone names without prefix
+  const char*     rules;        // POSIX TZ rules
+  const uint16_t  (*index)[2];  // name and rule offsets, sorted by name
+  uint16_t        count;
+} EM_TZ_Region;
+
+////////////////////////////////////////////////////
+
+#if USING_AFRICA
+
+static const char TZ_AFRICA_RULES[] PROGMEM =
+  "GMT0\0"
+  "EAT-3\0"
+  "CET-1\0"
+  "WAT-1\0"
+  "CAT-2\0"
+  "EET-2\0"
+  "<+01>-1\0"
+  "CET-1CEST,M3.5.0,M10.5.0/3\0"
+  "SAST-2\0";
+
+static const char TZ_AFRICA_NAMES[] PROGMEM =
+  "Abidjan\0"
+  "Accra\0"
+  "Addis_Ababa\0"
+  "Algiers\0"
+  "Asmara\0"
+  "Bamako\0"
+  "Bangui\0"
+  "Banjul\0"
+  "Bissau\0"
+  "Blantyre\0"
+  "Brazzaville\0"
+  "Bujumbura\0"
+  "Cairo\0"
+  "Casablanca\0"
+  "Ceuta\0"
+  "Conakry\0"
+  "Dakar\0"
+  "Dar_es_Salaam\0"
+  "Djibouti\0"
+  "Douala\0"
+  "El_Aaiun\0"
+  "Freetown\0"
+  "Gaborone\0"
+  "Harare\0"
+  "Johannesburg\0"
+  "Juba\0"
+  "Kampala\0"
+  "Khartoum\0"
+  "Kigali\0"
+  "Kinshasa\0"
+  "Lagos\0"
+  "Libreville\0"
+  "Lome\0"
+  "Luanda\0"
+  "Lubumbashi\0"
+  "Lusaka\0"
+  "Malabo\0"
+  "Maputo\0"
+  "Maseru\0"
+  "Mbabane\0"
+  "Mogadishu\0"
+  "Monrovia\0"
+  "Nairobi\0"
+  "Ndjamena\0"
+  "Niamey\0"
+  "Nouakchott\0"
+  "Ouagadougou\0"
+  "PortomNovo\0"
+  "Sao_Tome\0"
+  "Tripoli\0"
+  "Tunis\0"
+  "Windhoek\0";
+
+static const uint16_t TZ_AFRICA_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 8, 0 },
+  { 14, 5 },
+  { 26, 11 },
+  { 34, 5 },
+  { 41, 0 },
+  { 48, 17 },
+  { 55, 0 },
+  { 62, 0 },
+  { 69, 23 },
+  { 78, 17 },
+  { 90, 23 },
+  { 100, 29 },
+  { 106, 35 },
+  { 117, 43 },
+  { 123, 0 },
+  { 131, 0 },
+  { 137, 5 },
+  { 151, 5 },
+  { 160, 17 },
+  { 167, 35 },
+  { 176, 0 },
+  { 185, 23 },
+  { 194, 23 },
+  { 201, 70 },
+  { 214, 5 },
+  { 219, 5 },
+  { 227, 23 },
+  { 236, 23 },
+  { 243, 17 },
+  { 252, 17 },
+  { 258, 17 },
+  { 269, 0 },
+  { 274, 17 },
+  { 281, 23 },
+  { 292, 23 },
+  { 299, 17 },
+  { 306, 23 },
+  { 313, 70 },
+  { 320, 70 },
+  { 328, 5 },
+  { 338, 0 },
+  { 347, 5 },
+  { 355, 17 },
+  { 364, 17 },
+  { 371, 0 },
+  { 382, 0 },
+  { 394, 17 },
+  { 405, 0 },
+  { 414, 29 },
+  { 422, 11 },
+  { 428, 23 },
+};
+
+#endif    // USING_AFRICA
+
+////////////////////////////////////////////////////
+
+#if USING_AMERICA
+
+static const char TZ_AMERICA_RULES[] PROGMEM =
+  "HST10HDT,M3.2.0,M11.1.0\0"
+  "AKST9AKDT,M3.2.0,M11.1.0\0"
+  "AST4\0"
+  "<-03>3\0"
+  "<-04>4<-03>,M10.1.0/0,M3.4.0/0\0"
+  "EST5\0"
+  "CST6CDT,M4.1.0,M10.5.0\0"
+  "CST6\0"
+  "<-04>4\0"
+  "<-05>5\0"
+  "MST7MDT,M3.2.0,M11.1.0\0"
+  "CST6CDT,M3.2.0,M11.1.0\0"
+  "MST7MDT,M4.1.0,M10.5.0\0"
+  "MST7\0"
+  "GMT0\0"
+  "EST5EDT,M3.2.0,M11.1.0\0"
+  "AST4ADT,M3.2.0,M11.1.0\0"
+  "<-03>3<-02>,M3.5.0/-2,M10.5.0/-1\0"
+  "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+  "PST8PDT,M3.2.0,M11.1.0\0"
+  "<-03>3<-02>,M3.2.0,M11.1.0\0"
+  "<-02>2\0"
+  "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+  "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+  "NST3:30NDT,M3.2.0,M11.1.0\0";
+
+static const char TZ_AMERICA_NAMES[] PROGMEM =
+  "Adak\0"
+  "Anchorage\0"
+  "Anguilla\0"
+  "Antigua\0"
+  "Araguaina\0"
+  "Argentina/Buenos_Aires\0"
+  "Argentina/Catamarca\0"
+  "Argentina/Cordoba\0"
+  "Argentina/Jujuy\0"
+  "Argentina/La_Rioja\0"
+  "Argentina/Mendoza\0"
+  "Argentina/Rio_Gallegos\0"
+  "Argentina/Salta\0"
+  "Argentina/San_Juan\0"
+  "Argentina/San_Luis\0"
+  "Argentina/Tucuman\0"
+  "Argentina/Ushuaia\0"
+  "Aruba\0"
+  "Asuncion\0"
+  "Atikokan\0"
+  "Bahia\0"
+  "Bahia_Banderas\0"
+  "Barbados\0"
+  "Belem\0"
+  "Belize\0"
+  "BlancmSablon\0"
+  "Boa_Vista\0"
+  "Bogota\0"
+  "Boise\0"
+  "Cambridge_Bay\0"
+  "Campo_Grande\0"
+  "Cancun\0"
+  "Caracas\0"
+  "Cayenne\0"
+  "Cayman\0"
+  "Chicago\0"
+  "Chihuahua\0"
+  "Costa_Rica\0"
+  "Creston\0"
+  "Cuiaba\0"
+  "Curacao\0"
+  "Danmarkshavn\0"
+  "Dawson\0"
+  "Dawson_Creek\0"
+  "Denver\0"
+  "Detroit\0"
+  "Dominica\0"
+  "Edmonton\0"
+  "Eirunepe\0"
+  "El_Salvador\0"
+  "Fort_Nelson\0"
+  "Fortaleza\0"
+  "Glace_Bay\0"
+  "Godthab\0"
+  "Goose_Bay\0"
+  "Grand_Turk\0"
+  "Grenada\0"
+  "Guadeloupe\0"
+  "Guatemala\0"
+  "Guayaquil\0"
+  "Guyana\0"
+  "Halifax\0"
+  "Havana\0"
+  "Hermosillo\0"
+  "Indiana_Indianapolis\0"
+  "Indiana_Knox\0"
+  "Indiana_Marengo\0"
+  "Indiana_Petersburg\0"
+  "Indiana_Tell_City\0"
+  "Indiana_Vevay\0"
+  "Indiana_Vincennes\0"
+  "Indiana_Winamac\0"
+  "Inuvik\0"
+  "Iqaluit\0"
+  "Jamaica\0"
+  "Juneau\0"
+  "Kentucky_Louisville\0"
+  "Kentucky_Monticello\0"
+  "Kralendijk\0"
+  "La_Paz\0"
+  "Lima\0"
+  "Los_Angeles\0"
+  "Lower_Princes\0"
+  "Maceio\0"
+  "Managua\0"
+  "Manaus\0"
+  "Marigot\0"
+  "Martinique\0"
+  "Matamoros\0"
+  "Mazatlan\0"
+  "Menominee\0"
+  "Merida\0"
+  "Metlakatla\0"
+  "Mexico_City\0"
+  "Miquelon\0"
+  "Moncton\0"
+  "Monterrey\0"
+  "Montevideo\0"
+  "Montreal\0"
+  "Montserrat\0"
+  "Nassau\0"
+  "New_York\0"
+  "Nipigon\0"
+  "Nome\0"
+  "Noronha\0"
+  "North_Dakota_Beulah\0"
+  "North_Dakota_Center\0"
+  "North_Dakota_New_Salem\0"
+  "Ojinaga\0"
+  "Panama\0"
+  "Pangnirtung\0"
+  "Paramaribo\0"
+  "Phoenix\0"
+  "Port_of_Spain\0"
+  "PortmaumPrince\0"
+  "Porto_Velho\0"
+  "Puerto_Rico\0"
+  "Punta_Arenas\0"
+  "Rainy_River\0"
+  "Rankin_Inlet\0"
+  "Recife\0"
+  "Regina\0"
+  "Resolute\0"
+  "Rio_Branco\0"
+  "Santarem\0"
+  "Santiago\0"
+  "Santo_Domingo\0"
+  "Sao_Paulo\0"
+  "Scoresbysund\0"
+  "Sitka\0"
+  "St_Barthelemy\0"
+  "St_Johns\0"
+  "St_Kitts\0"
+  "St_Lucia\0"
+  "St_Thomas\0"
+  "St_Vincent\0"
+  "Swift_Current\0"
+  "Tegucigalpa\0"
+  "Thule\0"
+  "Thunder_Bay\0"
+  "Tijuana\0"
+  "Toronto\0"
+  "Tortola\0"
+  "Vancouver\0"
+  "Whitehorse\0"
+  "Winnipeg\0"
+  "Yakutat\0"
+  "Yellowknife\0";
+
+static const uint16_t TZ_AMERICA_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 5, 24 },
+  { 15, 49 },
+  { 24, 49 },
+  { 32, 54 },
+  { 42, 54 },
+  { 65, 54 },
+  { 85, 54 },
+  { 103, 54 },
+  { 119, 54 },
+  { 138, 54 },
+  { 156, 54 },
+  { 179, 54 },
+  { 195, 54 },
+  { 214, 54 },
+  { 233, 54 },
+  { 251, 54 },
+  { 269, 49 },
+  { 275, 61 },
+  { 284, 92 },
+  { 293, 54 },
+  { 299, 97 },
+  { 314, 49 },
+  { 323, 54 },
+  { 329, 120 },
+  { 336, 49 },
+  { 349, 125 },
+  { 359, 132 },
+  { 366, 139 },
+  { 372, 139 },
+  { 386, 125 },
+  { 399, 92 },
+  { 406, 125 },
+  { 414, 54 },
+  { 422, 92 },
+  { 429, 162 },
+  { 437, 185 },
+  { 447, 120 },
+  { 458, 208 },
+  { 466, 125 },
+  { 473, 49 },
+  { 481, 213 },
+  { 494, 208 },
+  { 501, 208 },
+  { 514, 139 },
+  { 521, 218 },
+  { 529, 49 },
+  { 538, 139 },
+  { 547, 132 },
+  { 556, 120 },
+  { 568, 208 },
+  { 580, 54 },
+  { 590, 241 },
+  { 600, 264 },
+  { 608, 241 },
+  { 618, 218 },
+  { 629, 49 },
+  { 637, 49 },
+  { 648, 120 },
+  { 658, 132 },
+  { 668, 125 },
+  { 675, 241 },
+  { 683, 297 },
+  { 690, 208 },
+  { 701, 218 },
+  { 722, 162 },
+  { 735, 218 },
+  { 751, 218 },
+  { 770, 162 },
+  { 788, 218 },
+  { 802, 218 },
+  { 820, 218 },
+  { 836, 139 },
+  { 843, 218 },
+  { 851, 92 },
+  { 859, 24 },
+  { 866, 218 },
+  { 886, 218 },
+  { 906, 49 },
+  { 917, 125 },
+  { 924, 132 },
+  { 929, 324 },
+  { 941, 49 },
+  { 955, 54 },
+  { 962, 120 },
+  { 970, 125 },
+  { 977, 49 },
+  { 985, 49 },
+  { 996, 162 },
+  { 1006, 185 },
+  { 1015, 162 },
+  { 1025, 97 },
+  { 1032, 24 },
+  { 1043, 97 },
+  { 1055, 347 },
+  { 1064, 241 },
+  { 1072, 97 },
+  { 1082, 54 },
+  { 1093, 218 },
+  { 1102, 49 },
+  { 1113, 218 },
+  { 1120, 218 },
+  { 1129, 218 },
+  { 1137, 24 },
+  { 1142, 374 },
+  { 1150, 162 },
+  { 1170, 162 },
+  { 1190, 162 },
+  { 1213, 139 },
+  { 1221, 92 },
+  { 1228, 218 },
+  { 1240, 54 },
+  { 1251, 208 },
+  { 1259, 49 },
+  { 1273, 218 },
+  { 1288, 125 },
+  { 1300, 49 },
+  { 1312, 54 },
+  { 1325, 162 },
+  { 1337, 162 },
+  { 1350, 54 },
+  { 1357, 120 },
+  { 1364, 162 },
+  { 1373, 132 },
+  { 1384, 54 },
+  { 1393, 381 },
+  { 1402, 49 },
+  { 1416, 54 },
+  { 1426, 413 },
+  { 1439, 24 },
+  { 1445, 49 },
+  { 1459, 444 },
+  { 1468, 49 },
+  { 1477, 49 },
+  { 1486, 49 },
+  { 1496, 49 },
+  { 1507, 120 },
+  { 1521, 120 },
+  { 1533, 241 },
+  { 1539, 218 },
+  { 1551, 324 },
+  { 1559, 218 },
+  { 1567, 49 },
+  { 1575, 324 },
+  { 1585, 208 },
+  { 1596, 162 },
+  { 1605, 24 },
+  { 1613, 139 },
+};
+
+#endif    // USING_AMERICA
+
+////////////////////////////////////////////////////
+
+#if USING_ANTARCTICA
+
+static const char TZ_ANTARCTICA_RULES[] PROGMEM =
+  "<+11>-11\0"
+  "<+07>-7\0"
+  "<+10>-10\0"
+  "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+  "<+05>-5\0"
+  "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+  "<-03>3\0"
+  "<+03>-3\0"
+  "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+  "<+06>-6\0"
+  "CET-1CEST,M3.5.0,M10.5.0/3\0";
+
+static const char TZ_ANTARCTICA_NAMES[] PROGMEM =
+  "Casey\0"
+  "Davis\0"
+  "DumontDUrville\0"
+  "Macquarie\0"
+  "Mawson\0"
+  "McMurdo\0"
+  "Palmer\0"
+  "Rothera\0"
+  "Syowa\0"
+  "Troll\0"
+  "Vostok\0";
+
+static const uint16_t TZ_ANTARCTICA_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 6, 9 },
+  { 12, 17 },
+  { 27, 26 },
+  { 37, 55 },
+  { 44, 63 },
+  { 52, 91 },
+  { 59, 91 },
+  { 67, 98 },
+  { 73, 106 },
+  { 79, 139 },
+};
+
+static const char TZ_ARCTIC_NAMES[] PROGMEM =
+  "Longyearbyen\0";
+
+static const uint16_t TZ_ARCTIC_INDEX[][2] PROGMEM =
+{
+  { 0, 147 },
+};
+
+#endif    // USING_ANTARCTICA
+
+////////////////////////////////////////////////////
+
+#if USING_ASIA
+
+static const char TZ_ASIA_RULES[] PROGMEM =
+  "<+03>-3\0"
+  "<+06>-6\0"
+  "EET-2EEST,M3.5.4/24,M10.5.5/1\0"
+  "<+12>-12\0"
+  "<+05>-5\0"
+  "<+04>-4\0"
+  "<+07>-7\0"
+  "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+  "<+08>-8\0"
+  "<+09>-9\0"
+  "<+0530>-5:30\0"
+  "EET-2EEST,M3.5.5/0,M10.5.5/0\0"
+  "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+  "EET-2EEST,M3.4.4/48,M10.4.4/49\0"
+  "HKT-8\0"
+  "WIB-7\0"
+  "WIT-9\0"
+  "IST-2IDT,M3.4.4/26,M10.5.0\0"
+  "<+0430>-4:30\0"
+  "PKT-5\0"
+  "<+0545>-5:45\0"
+  "IST-5:30\0"
+  "CST-8\0"
+  "<+11>-11\0"
+  "WITA-8\0"
+  "PST-8\0"
+  "KST-9\0"
+  "<+0330>-3:30<+0430>,J79/24,J263/24\0"
+  "JST-9\0"
+  "<+10>-10\0"
+  "<+0630>-6:30\0";
+
+static const char TZ_ASIA_NAMES[] PROGMEM =
+  "Aden\0"
+  "Almaty\0"
+  "Amman\0"
+  "Anadyr\0"
+  "Aqtau\0"
+  "Aqtobe\0"
+  "Ashgabat\0"
+  "Atyrau\0"
+  "Baghdad\0"
+  "Bahrain\0"
+  "Baku\0"
+  "Bangkok\0"
+  "Barnaul\0"
+  "Beirut\0"
+  "Bishkek\0"
+  "Brunei\0"
+  "Chita\0"
+  "Choibalsan\0"
+  "Colombo\0"
+  "Damascus\0"
+  "Dhaka\0"
+  "Dili\0"
+  "Dubai\0"
+  "Dushanbe\0"
+  "Famagusta\0"
+  "Gaza\0"
+  "Hebron\0"
+  "Ho_Chi_Minh\0"
+  "Hong_Kong\0"
+  "Hovd\0"
+  "Irkutsk\0"
+  "Jakarta\0"
+  "Jayapura\0"
+  "Jerusalem\0"
+  "Kabul\0"
+  "Kamchatka\0"
+  "Karachi\0"
+  "Kathmandu\0"
+  "Khandyga\0"
+  "Kolkata\0"
+  "Krasnoyarsk\0"
+  "Kuala_Lumpur\0"
+  "Kuching\0"
+  "Kuwait\0"
+  "Macau\0"
+  "Magadan\0"
+  "Makassar\0"
+  "Manila\0"
+  "Muscat\0"
+  "Nicosia\0"
+  "Novokuznetsk\0"
+  "Novosibirsk\0"
+  "Omsk\0"
+  "Oral\0"
+  "Phnom_Penh\0"
+  "Pontianak\0"
+  "Pyongyang\0"
+  "Qatar\0"
+  "Qyzylorda\0"
+  "Riyadh\0"
+  "Sakhalin\0"
+  "Samarkand\0"
+  "Seoul\0"
+  "Shanghai\0"
+  "Singapore\0"
+  "Srednekolymsk\0"
+  "Taipei\0"
+  "Tashkent\0"
+  "Tbilisi\0"
+  "Tehran\0"
+  "Thimphu\0"
+  "Tokyo\0"
+  "Tomsk\0"
+  "Ulaanbaatar\0"
+  "Urumqi\0"
+  "UstmNera\0"
+  "Vientiane\0"
+  "Vladivostok\0"
+  "Yakutsk\0"
+  "Yangon\0"
+  "Yekaterinburg\0"
+  "Yerevan\0";
+
+static const uint16_t TZ_ASIA_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 5, 8 },
+  { 12, 16 },
+  { 18, 46 },
+  { 25, 55 },
+  { 31, 55 },
+  { 38, 55 },
+  { 47, 55 },
+  { 54, 0 },
+  { 62, 0 },
+  { 70, 63 },
+  { 75, 71 },
+  { 83, 71 },
+  { 91, 79 },
+  { 98, 8 },
+  { 106, 108 },
+  { 113, 116 },
+  { 119, 108 },
+  { 130, 124 },
+  { 138, 137 },
+  { 147, 8 },
+  { 153, 116 },
+  { 158, 63 },
+  { 164, 55 },
+  { 173, 166 },
+  { 183, 195 },
+  { 188, 195 },
+  { 195, 71 },
+  { 207, 226 },
+  { 217, 71 },
+  { 222, 108 },
+  { 230, 232 },
+  { 238, 238 },
+  { 247, 244 },
+  { 257, 271 },
+  { 263, 46 },
+  { 273, 284 },
+  { 281, 290 },
+  { 291, 116 },
+  { 300, 303 },
+  { 308, 71 },
+  { 320, 108 },
+  { 333, 108 },
+  { 341, 0 },
+  { 348, 312 },
+  { 354, 318 },
+  { 362, 327 },
+  { 371, 334 },
+  { 378, 63 },
+  { 385, 166 },
+  { 393, 71 },
+  { 406, 71 },
+  { 418, 8 },
+  { 423, 55 },
+  { 428, 71 },
+  { 439, 232 },
+  { 449, 340 },
+  { 459, 0 },
+  { 465, 55 },
+  { 475, 0 },
+  { 482, 318 },
+  { 491, 55 },
+  { 501, 340 },
+  { 507, 312 },
+  { 516, 108 },
+  { 526, 318 },
+  { 540, 312 },
+  { 547, 55 },
+  { 556, 63 },
+  { 564, 346 },
+  { 571, 8 },
+  { 579, 381 },
+  { 585, 71 },
+  { 591, 108 },
+  { 603, 8 },
+  { 610, 387 },
+  { 619, 71 },
+  { 629, 387 },
+  { 641, 116 },
+  { 649, 396 },
+  { 656, 55 },
+  { 670, 63 },
+};
+
+#endif    // USING_ASIA
+
+////////////////////////////////////////////////////
+
+#if USING_ATLANTIC
+
+static const char TZ_ATLANTIC_RULES[] PROGMEM =
+  "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+  "AST4ADT,M3.2.0,M11.1.0\0"
+  "WET0WEST,M3.5.0/1,M10.5.0\0"
+  "<-01>1\0"
+  "GMT0\0"
+  "<-02>2\0"
+  "<-03>3\0";
+
+static const char TZ_ATLANTIC_NAMES[] PROGMEM =
+  "Azores\0"
+  "Bermuda\0"
+  "Canary\0"
+  "Cape_Verde\0"
+  "Faroe\0"
+  "Madeira\0"
+  "Reykjavik\0"
+  "South_Georgia\0"
+  "St_Helena\0"
+  "Stanley\0";
+
+static const uint16_t TZ_ATLANTIC_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 7, 31 },
+  { 15, 54 },
+  { 22, 80 },
+  { 33, 54 },
+  { 39, 54 },
+  { 47, 87 },
+  { 57, 92 },
+  { 71, 87 },
+  { 81, 99 },
+};
+
+#endif    // USING_ATLANTIC
+
+////////////////////////////////////////////////////
+
+#if USING_AUSTRALIA
+
+static const char TZ_AUSTRALIA_RULES[] PROGMEM =
+  "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+  "AEST-10\0"
+  "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+  "ACST-9:30\0"
+  "<+0845>-8:45\0"
+  "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+  "AWST-8\0";
+
+static const char TZ_AUSTRALIA_NAMES[] PROGMEM =
+  "Adelaide\0"
+  "Brisbane\0"
+  "Broken_Hill\0"
+  "Currie\0"
+  "Darwin\0"
+  "Eucla\0"
+  "Hobart\0"
+  "Lindeman\0"
+  "Lord_Howe\0"
+  "Melbourne\0"
+  "Perth\0"
+  "Sydney\0";
+
+static const uint16_t TZ_AUSTRALIA_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 9, 31 },
+  { 18, 0 },
+  { 30, 39 },
+  { 37, 68 },
+  { 44, 78 },
+  { 50, 39 },
+  { 57, 31 },
+  { 66, 91 },
+  { 76, 39 },
+  { 86, 128 },
+  { 92, 39 },
+};
+
+#endif    // USING_AUSTRALIA
+
+////////////////////////////////////////////////////
+
+#if USING_ETC_GMT
+
+static const char TZ_ETC_GMT_RULES[] PROGMEM =
+  "GMT0\0"
+  "<+01>-1\0"
+  "<+10>-10\0"
+  "<+11>-11\0"
+  "<+12>-12\0"
+  "<+13>-13\0"
+  "<+14>-14\0"
+  "<+02>-2\0"
+  "<+03>-3\0"
+  "<+04>-4\0"
+  "<+05>-5\0"
+  "<+06>-6\0"
+  "<+07>-7\0"
+  "<+08>-8\0"
+  "<+09>-9\0"
+  "<-01>1\0"
+  "<-10>10\0"
+  "<-11>11\0"
+  "<-12>12\0"
+  "<-02>2\0"
+  "<-03>3\0"
+  "<-04>4\0"
+  "<-05>5\0"
+  "<-06>6\0"
+  "<-07>7\0"
+  "<-08>8\0"
+  "<-09>9\0"
+  "UTC0\0";
+
+static const char TZ_ETC_NAMES[] PROGMEM =
+  "GMT\0"
+  "GMT0\0"
+  "GMTm0\0"
+  "GMTm1\0"
+  "GMTm10\0"
+  "GMTm11\0"
+  "GMTm12\0"
+  "GMTm13\0"
+  "GMTm14\0"
+  "GMTm2\0"
+  "GMTm3\0"
+  "GMTm4\0"
+  "GMTm5\0"
+  "GMTm6\0"
+  "GMTm7\0"
+  "GMTm8\0"
+  "GMTm9\0"
+  "GMTp0\0"
+  "GMTp1\0"
+  "GMTp10\0"
+  "GMTp11\0"
+  "GMTp12\0"
+  "GMTp2\0"
+  "GMTp3\0"
+  "GMTp4\0"
+  "GMTp5\0"
+  "GMTp6\0"
+  "GMTp7\0"
+  "GMTp8\0"
+  "GMTp9\0"
+  "Greenwich\0"
+  "UCT\0"
+  "UTC\0"
+  "Universal\0"
+  "Zulu\0";
+
+static const uint16_t TZ_ETC_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 4, 0 },
+  { 9, 0 },
+  { 15, 5 },
+  { 21, 13 },
+  { 28, 22 },
+  { 35, 31 },
+  { 42, 40 },
+  { 49, 49 },
+  { 56, 58 },
+  { 62, 66 },
+  { 68, 74 },
+  { 74, 82 },
+  { 80, 90 },
+  { 86, 98 },
+  { 92, 106 },
+  { 98, 114 },
+  { 104, 0 },
+  { 110, 122 },
+  { 116, 129 },
+  { 123, 137 },
+  { 130, 145 },
+  { 137, 153 },
+  { 143, 160 },
+  { 149, 167 },
+  { 155, 174 },
+  { 161, 181 },
+  { 167, 188 },
+  { 173, 195 },
+  { 179, 202 },
+  { 185, 0 },
+  { 195, 209 },
+  { 199, 209 },
+  { 203, 209 },
+  { 213, 209 },
+};
+
+#endif    // USING_ETC_GMT
+
+////////////////////////////////////////////////////
+
+#if USING_EUROPE
+
+static const char TZ_EUROPE_RULES[] PROGMEM =
+  "CET-1CEST,M3.5.0,M10.5.0/3\0"
+  "<+04>-4\0"
+  "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+  "EET-2EEST,M3.5.0,M10.5.0/3\0"
+  "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+  "GMT0BST,M3.5.0/1,M10.5.0\0"
+  "<+03>-3\0"
+  "EET-2\0"
+  "WET0WEST,M3.5.0/1,M10.5.0\0"
+  "MSK-3\0";
+
+static const char TZ_EUROPE_NAMES[] PROGMEM =
+  "Amsterdam\0"
+  "Andorra\0"
+  "Astrakhan\0"
+  "Athens\0"
+  "Belgrade\0"
+  "Berlin\0"
+  "Bratislava\0"
+  "Brussels\0"
+  "Bucharest\0"
+  "Budapest\0"
+  "Busingen\0"
+  "Chisinau\0"
+  "Copenhagen\0"
+  "Dublin\0"
+  "Gibraltar\0"
+  "Guernsey\0"
+  "Helsinki\0"
+  "Isle_of_Man\0"
+  "Istanbul\0"
+  "Jersey\0"
+  "Kaliningrad\0"
+  "Kiev\0"
+  "Kirov\0"
+  "Lisbon\0"
+  "Ljubljana\0"
+  "London\0"
+  "Luxembourg\0"
+  "Madrid\0"
+  "Malta\0"
+  "Mariehamn\0"
+  "Minsk\0"
+  "Monaco\0"
+  "Moscow\0"
+  "Oslo\0"
+  "Paris\0"
+  "Podgorica\0"
+  "Prague\0"
+  "Riga\0"
+  "Rome\0"
+  "Samara\0"
+  "San_Marino\0"
+  "Sarajevo\0"
+  "Saratov\0"
+  "Simferopol\0"
+  "Skopje\0"
+  "Sofia\0"
+  "Stockholm\0"
+  "Tallinn\0"
+  "Tirane\0"
+  "Ulyanovsk\0"
+  "Uzhgorod\0"
+  "Vaduz\0"
+  "Vatican\0"
+  "Vienna\0"
+  "Vilnius\0"
+  "Volgograd\0"
+  "Warsaw\0"
+  "Zagreb\0"
+  "Zaporozhye\0"
+  "Zurich\0";
+
+static const uint16_t TZ_EUROPE_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 10, 0 },
+  { 18, 27 },
+  { 28, 35 },
+  { 35, 0 },
+  { 44, 0 },
+  { 51, 0 },
+  { 62, 0 },
+  { 71, 35 },
+  { 81, 0 },
+  { 90, 0 },
+  { 99, 64 },
+  { 108, 0 },
+  { 119, 91 },
+  { 126, 0 },
+  { 136, 118 },
+  { 145, 35 },
+  { 154, 118 },
+  { 166, 143 },
+  { 175, 118 },
+  { 182, 151 },
+  { 194, 35 },
+  { 199, 143 },
+  { 205, 157 },
+  { 212, 0 },
+  { 222, 118 },
+  { 229, 0 },
+  { 240, 0 },
+  { 247, 0 },
+  { 253, 35 },
+  { 263, 143 },
+  { 269, 0 },
+  { 276, 183 },
+  { 283, 0 },
+  { 288, 0 },
+  { 294, 0 },
+  { 304, 0 },
+  { 311, 35 },
+  { 316, 0 },
+  { 321, 27 },
+  { 328, 0 },
+  { 339, 0 },
+  { 348, 27 },
+  { 356, 183 },
+  { 367, 0 },
+  { 374, 35 },
+  { 380, 0 },
+  { 390, 35 },
+  { 398, 0 },
+  { 405, 27 },
+  { 415, 35 },
+  { 424, 0 },
+  { 430, 0 },
+  { 438, 0 },
+  { 445, 35 },
+  { 453, 27 },
+  { 463, 0 },
+  { 470, 0 },
+  { 477, 35 },
+  { 488, 0 },
+};
+
+#endif    // USING_EUROPE
+
+////////////////////////////////////////////////////
+
+#if USING_INDIAN
+
+static const char TZ_INDIAN_RULES[] PROGMEM =
+  "EAT-3\0"
+  "<+06>-6\0"
+  "<+07>-7\0"
+  "<+0630>-6:30\0"
+  "<+05>-5\0"
+  "<+04>-4\0";
+
+static const char TZ_INDIAN_NAMES[] PROGMEM =
+  "Antananarivo\0"
+  "Chagos\0"
+  "Christmas\0"
+  "Cocos\0"
+  "Comoro\0"
+  "Kerguelen\0"
+  "Mahe\0"
+  "Maldives\0"
+  "Mauritius\0"
+  "Mayotte\0"
+  "Reunion\0";
+
+static const uint16_t TZ_INDIAN_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 13, 6 },
+  { 20, 14 },
+  { 30, 22 },
+  { 36, 0 },
+  { 43, 35 },
+  { 53, 43 },
+  { 58, 35 },
+  { 67, 43 },
+  { 77, 0 },
+  { 85, 43 },
+};
+
+#endif    // USING_INDIAN
+
+////////////////////////////////////////////////////
+
+#if USING_PACIFIC
+
+static const char TZ_PACIFIC_RULES[] PROGMEM =
+  "<+13>-13<+14>,M9.5.0/3,M4.1.0/4\0"
+  "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+  "<+11>-11\0"
+  "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+  "<+10>-10\0"
+  "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+  "<+13>-13\0"
+  "<+12>-12<+13>,M11.2.0,M1.2.3/99\0"
+  "<+12>-12\0"
+  "<-06>6\0"
+  "<-09>9\0"
+  "ChST-10\0"
+  "HST10\0"
+  "<+14>-14\0"
+  "<-0930>9:30\0"
+  "SST11\0"
+  "<-11>11\0"
+  "<+11>-11<+12>,M10.1.0,M4.1.0/3\0"
+  "<+09>-9\0"
+  "<-08>8\0"
+  "<-10>10\0";
+
+static const char TZ_PACIFIC_NAMES[] PROGMEM =
+  "Apia\0"
+  "Auckland\0"
+  "Bougainville\0"
+  "Chatham\0"
+  "Chuuk\0"
+  "Easter\0"
+  "Efate\0"
+  "Enderbury\0"
+  "Fakaofo\0"
+  "Fiji\0"
+  "Funafuti\0"
+  "Galapagos\0"
+  "Gambier\0"
+  "Guadalcanal\0"
+  "Guam\0"
+  "Honolulu\0"
+  "Kiritimati\0"
+  "Kosrae\0"
+  "Kwajalein\0"
+  "Majuro\0"
+  "Marquesas\0"
+  "Midway\0"
+  "Nauru\0"
+  "Niue\0"
+  "Norfolk\0"
+  "Noumea\0"
+  "Pago_Pago\0"
+  "Palau\0"
+  "Pitcairn\0"
+  "Pohnpei\0"
+  "Port_Moresby\0"
+  "Rarotonga\0"
+  "Saipan\0"
+  "Tahiti\0"
+  "Tarawa\0"
+  "Tongatapu\0"
+  "Wake\0"
+  "Wallis\0";
+
+static const uint16_t TZ_PACIFIC_INDEX[][2] PROGMEM =
+{
+  { 0, 0 },
+  { 5, 32 },
+  { 14, 60 },
+  { 27, 69 },
+  { 35, 114 },
+  { 41, 123 },
+  { 48, 60 },
+  { 54, 155 },
+  { 64, 155 },
+  { 72, 164 },
+  { 77, 196 },
+  { 86, 205 },
+  { 96, 212 },
+  { 104, 60 },
+  { 116, 219 },
+  { 121, 227 },
+  { 130, 233 },
+  { 141, 60 },
+  { 148, 196 },
+  { 158, 196 },
+  { 165, 242 },
+  { 175, 254 },
+  { 182, 196 },
+  { 188, 260 },
+  { 193, 268 },
+  { 201, 60 },
+  { 208, 254 },
+  { 218, 299 },
+  { 224, 307 },
+  { 233, 60 },
+  { 241, 114 },
+  { 254, 314 },
+  { 264, 219 },
+  { 271, 314 },
+  { 278, 196 },
+  { 285, 155 },
+  { 295, 196 },
+  { 300, 196 },
+};
+
+#endif    // USING_PACIFIC
+
+////////////////////////////////////////////////////
+
+// Sorted by prefix
+static const EM_TZ_Region EM_TZ_REGIONS[] =
+{
+#if USING_AFRICA
+  { "Africa/", TZ_AFRICA_NAMES, TZ_AFRICA_RULES, TZ_AFRICA_INDEX, 52 },
+#endif
+#if USING_AMERICA
+  { "America/", TZ_AMERICA_NAMES, TZ_AMERICA_RULES, TZ_AMERICA_INDEX, 148 },
+#endif
+#if USING_ANTARCTICA
+  { "Antarctica/", TZ_ANTARCTICA_NAMES, TZ_ANTARCTICA_RULES, TZ_ANTARCTICA_INDEX, 11 },
+#endif
+#if USING_ANTARCTICA
+  { "Arctic/", TZ_ARCTIC_NAMES, TZ_ANTARCTICA_RULES, TZ_ARCTIC_INDEX, 1 },
+#endif
+#if USING_ASIA
+  { "Asia/", TZ_ASIA_NAMES, TZ_ASIA_RULES, TZ_ASIA_INDEX, 82 },
+#endif
+#if USING_ATLANTIC
+  { "Atlantic/", TZ_ATLANTIC_NAMES, TZ_ATLANTIC_RULES, TZ_ATLANTIC_INDEX, 10 },
+#endif
+#if USING_AUSTRALIA
+  { "Australia/", TZ_AUSTRALIA_NAMES, TZ_AUSTRALIA_RULES, TZ_AUSTRALIA_INDEX, 12 },
+#endif
+#if USING_ETC_GMT
+  { "Etc/", TZ_ETC_NAMES, TZ_ETC_GMT_RULES, TZ_ETC_INDEX, 35 },
+#endif
+#if USING_EUROPE
+  { "Europe/", TZ_EUROPE_NAMES, TZ_EUROPE_RULES, TZ_EUROPE_INDEX, 60 },
+#endif
+#if USING_INDIAN
+  { "Indian/", TZ_INDIAN_NAMES, TZ_INDIAN_RULES, TZ_INDIAN_INDEX, 11 },
+#endif
+#if USING_PACIFIC
+  { "Pacific/", TZ_PACIFIC_NAMES, TZ_PACIFIC_RULES, TZ_PACIFIC_INDEX, 38 },
+#endif
+};
+
+////////////////////////////////////////////////////
+
+#endif    // TZ_POOL_H
@@ -0,0 +1,207 @@
+// ESP32_EM_ConfigStore: round trip, A/B fallback and CRC checks, then load / save latency with 30 params
+//
+//   bench_config_store [iterations]
+
+#include <ESP32_W5500_Manager.h>
+#include <ESP32_EM_ConfigStore.h>
+
+#include <vector>
+
+#include "em_test.h"
+
+#define EM_BENCH_PARAMS     30
+
+////////////////////////////////////////////////////
+
+static char paramIds[EM_BENCH_PARAMS][12];
+
+// The params, in order or reversed, with empty values
+static std::vector<ESP32_EMParameter*> makeParams(const bool& reversed)
+{
+  std::vector<ESP32_EMParameter*> params;
+
+  for (int i = 0; i < EM_BENCH_PARAMS; i++)
+  {
+    int n = reversed ? (EM_BENCH_PARAMS - 1 - i) : i;
+
+    snprintf(paramIds[n], sizeof(paramIds[n]), "param%d", n);
+    params.push_back(new ESP32_EMParameter(paramIds[n], "Placeholder", "", 24));
+  }
+
+  return params;
+}
+
+static void setValue(ESP32_EMParameter* param, const char* value)
+{
+  char* dest = (char*) param->getValue();
+
+  strncpy(dest, value, param->getValueLength());
+  dest[param->getValueLength()] = 0;
+}
+
+////////////////////////////////////////////////////
+
+static void testRoundTrip(ESP32_EM_ConfigBackend& backend)
+{
+  std::vector<ESP32_EMParameter*> saved  = makeParams(false);
+  std::vector<ESP32_EMParameter*> loaded = makeParams(true);
+
+  for (int i = 0; i < EM_BENCH_PARAMS; i++)
+  {
+    char value[24];
+
+    snprintf(value, sizeof(value), "value %d", i);
+    setValue(saved[i], value);
+  }
+
+  ETH_STA_IPConfig ipConfig = ETH_STA_IPConfig();
+
+  ipConfig._sta_static_ip = IPAddress(192, 168, 2, 50);
+  ipConfig._sta_static_gw = IPAddress(192, 168, 2, 1);
+
+  ESP32_EM_ConfigStore writer(backend);
+
+  EM_CHECK(writer.save(ipConfig, "America/Toronto", saved.data(), saved.size()));
+
+  ESP32_EM_ConfigStore reader(backend);
+  ETH_STA_IPConfig     readConfig = ETH_STA_IPConfig();
+  String               timezoneName;
+  uint32_t             generation = em_pageGeneration();
+
+  EM_CHECK(reader.load(readConfig, timezoneName, loaded.data(), loaded.size()));
+  EM_CHECK(readConfig._sta_static_ip == ipConfig._sta_static_ip);
+  EM_CHECK(readConfig._sta_static_gw == ipConfig._sta_static_gw);
+  EM_CHECK(timezoneName == "America/Toronto");
+  EM_CHECK(strcmp(loaded[0]->getValue(), "value 29") == 0);
+  EM_CHECK(strcmp(loaded[EM_BENCH_PARAMS - 1]->getValue(), "value 0") == 0);
+
+  // Values changed under the cached pages
+  EM_CHECK(em_pageGeneration() != generation);
+
+  for (auto param : saved)
+    delete param;
+
+  for (auto param : loaded)
+    delete param;
+}
+
+////////////////////////////////////////////////////
+
+static void testFallback()
+{
+  fs::FS                    fileSystem;
+  ESP32_EM_FSConfigBackend  backend(fileSystem);
+  ESP32_EM_ConfigStore      store(backend);
+
+  std::vector<ESP32_EMParameter*> params = makeParams(false);
+
+  ETH_STA_IPConfig ipConfig = ETH_STA_IPConfig();
+  String           timezoneName;
+
+  setValue(params[0], "first");
+  EM_CHECK(store.save(ipConfig, "", params.data(), params.size()));
+
+  setValue(params[0], "second");
+  EM_CHECK(store.save(ipConfig, "", params.data(), params.size()));
+  EM_CHECK(store.getSequence() == 2);
+
+  // Unchanged, not written
+  EM_CHECK(store.save(ipConfig, "", params.data(), params.size()));
+  EM_CHECK(store.getSequence() == 2);
+
+  std::string& newest = fileSystem.files[(store.getCurrentSlot() == 0) ? "/em_cfg_a.dat" : "/em_cfg_b.dat"];
+
+  // Corrupted newest slot: the older image is loaded
+  newest[newest.size() - 1] ^= 0x01;
+
+  ESP32_EM_ConfigStore corrupted(backend);
+
+  EM_CHECK(corrupted.load(ipConfig, timezoneName, params.data(), params.size()));
+  EM_CHECK(strcmp(params[0]->getValue(), "first") == 0);
+
+  // Truncated, same
+  newest[newest.size() - 1] ^= 0x01;
+  newest.resize(newest.size() - 4);
+
+  ESP32_EM_ConfigStore truncated(backend);
+
+  EM_CHECK(truncated.load(ipConfig, timezoneName, params.data(), params.size()));
+  EM_CHECK(strcmp(params[0]->getValue(), "first") == 0);
+
+  for (auto param : params)
+    delete param;
+}
+
+////////////////////////////////////////////////////
+
+static void bench(const int& iterations)
+{
+  fs::FS                    fileSystem;
+  ESP32_EM_FSConfigBackend  backend(fileSystem);
+  ESP32_EM_ConfigStore      store(backend);
+
+  std::vector<ESP32_EMParameter*> params = makeParams(false);
+
+  for (int i = 0; i < EM_BENCH_PARAMS; i++)
+    setValue(params[i], "some value");
+
+  ETH_STA_IPConfig ipConfig = ETH_STA_IPConfig();
+  String           timezoneName;
+
+  // A different image each time, so that each save writes
+  auto start = micros();
+
+  for (int i = 0; i < iterations; i++)
+  {
+    char value[12];
+
+    snprintf(value, sizeof(value), "%d", i);
+    setValue(params[0], value);
+    store.save(ipConfig, "Europe/Paris", params.data(), params.size());
+  }
+
+  double saveUs = (double) (micros() - start) / iterations;
+
+  start = micros();
+
+  for (int i = 0; i < iterations; i++)
+  {
+    store.load(ipConfig, timezoneName, params.data(), params.size());
+  }
+
+  double loadUs = (double) (micros() - start) / iterations;
+
+  printf("ConfigStore, %d params, %zu B image, in memory: save %.2f us, load %.2f us\n", EM_BENCH_PARAMS,
+         fileSystem.files["/em_cfg_a.dat"].size(), saveUs, loadUs);
+
+  for (auto param : params)
+    delete param;
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  int iterations = (argc > 1) ? atoi(argv[1]) : 10000;
+
+  EM_CHECK(em_crc32Update(0, (const uint8_t*) "123456789", 9) == 0xCBF43926);
+
+  fs::FS                    fileSystem;
+  ESP32_EM_FSConfigBackend  fsBackend(fileSystem);
+  ESP32_EM_NVSConfigBackend nvsBackend;
+
+  testRoundTrip(fsBackend);
+  testRoundTrip(nvsBackend);
+  testFallback();
+
+  bench(iterations);
+
+  // Through the manager, which also builds without NTP
+  ESP32_W5500_Manager   manager("Store");
+  ESP32_EM_ConfigStore  store(fsBackend);
+
+  EM_CHECK(store.save(manager));
+  EM_CHECK(store.load(manager));
+
+  return em_testResult();
+}
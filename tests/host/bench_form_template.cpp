@@ -0,0 +1,135 @@
+// One form parameter rendered from EM_HTTP_FORM_PARAM with the String::replace() chain of handleETH(), as
+// before, against printTemplate(EM_TPL_FORM_PARAM, ...), reporting the time and heap allocations per parameter
+//
+//   bench_form_template [iterations]
+
+#include <ESP32_W5500_Manager.h>
+
+#include <chrono>
+
+#include "em_test.h"
+
+typedef struct
+{
+  const char* name;
+  const char* id;
+  const char* placeholder;
+  int         length;
+  const char* value;
+  const char* custom;
+} EM_BenchParam;
+
+static const EM_BenchParam EM_BENCH_PARAMS[] =
+{
+  { "short",          "port",         "Port",             6,    "1883",                 ""                        },
+  { "typical",        "mqtt_server",  "MQTT server",      40,   "broker.example.com",   ""                        },
+  { "custom HTML",    "api_token",    "API token",        64,   "0123456789abcdef",     "type='password' required" },
+};
+
+////////////////////////////////////////////////////
+
+// handleETH() before the templates: only one parameter item held in memory at any time
+static void printBefore(ESP32_EMPageWriter& page, const EM_BenchParam& param)
+{
+  char   parLength[12];
+  String pitem = FPSTR(EM_HTTP_FORM_PARAM);
+
+  pitem.replace("{i}", param.id);
+  pitem.replace("{n}", param.id);
+  pitem.replace("{p}", param.placeholder);
+
+  snprintf(parLength, sizeof(parLength), "%d", param.length);
+
+  pitem.replace("{l}", parLength);
+  pitem.replace("{v}", param.value);
+  pitem.replace("{c}", param.custom);
+
+  page.print(pitem);
+}
+
+static void printAfter(ESP32_EMPageWriter& page, const EM_BenchParam& param)
+{
+  EM_TemplateArgs args = { param.id, param.placeholder, param.length, param.value, param.custom };
+
+  page.printTemplate(EM_TPL_FORM_PARAM, args);
+}
+
+////////////////////////////////////////////////////
+
+// Body of a page with one parameter
+template<typename Function>
+static std::string render(ESP32_EMWebServer& server, Function function)
+{
+  ESP32_EMPageWriter page(&server);
+
+  server.response.clear();
+
+  page.begin(200, "text/html");
+  function(page);
+  page.end();
+
+  return server.responseBody();
+}
+
+// Allocations per parameter
+template<typename Function>
+static double bench(const char* name, const int& iterations, ESP32_EMWebServer& server, Function function)
+{
+  ESP32_EMPageWriter page(&server);
+
+  server.response.clear();
+  server.response.reserve(1 << 20);
+
+  page.begin(200, "text/html");
+
+  uint64_t  allocs  = em_hostHeap.allocs;
+  auto      start   = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; i++)
+  {
+    function(page);
+
+    // The chunks sent so far, the capacity is kept
+    if (server.response.size() > (1 << 19))
+      server.response.clear();
+  }
+
+  double ns         = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+  double allocsPer  = (double) (em_hostHeap.allocs - allocs) / iterations;
+
+  page.end();
+
+  printf("%-32s %8.1f ns/param  allocs/param = %4.1f\n", name, ns, allocsPer);
+
+  return allocsPer;
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+
+  ESP32_EMWebServer server(80);
+
+  for (const EM_BenchParam& param : EM_BENCH_PARAMS)
+  {
+    auto before = [&](ESP32_EMPageWriter& page) { printBefore(page, param); };
+    auto after  = [&](ESP32_EMPageWriter& page) { printAfter(page, param); };
+
+    // The same HTML
+    EM_CHECK(render(server, before) == render(server, after));
+
+    std::string nameBefore  = std::string(param.name) + ", replace()";
+    std::string nameAfter   = std::string(param.name) + ", printTemplate()";
+
+    double allocsBefore = bench(nameBefore.c_str(), iterations, server, before);
+    double allocsAfter  = bench(nameAfter.c_str(),  iterations, server, after);
+
+    // The template is rendered without allocating
+    EM_CHECK(allocsAfter == 0);
+    EM_CHECK(allocsBefore >= 1);
+  }
+
+  return em_testResult();
+}
@@ -0,0 +1,180 @@
+// Response header profiles: the head of a portal page sent with one sendHeader() call per header, as before,
+// against one sendHeaderBlock(), with and without CORS. Then the profiles sent by the Config Portal, with
+// CORS composed in, checked against the headers of the sendHeader() calls they replaced
+//
+//   bench_header_profiles [iterations]
+
+#include <ESP32_W5500_Manager.h>
+
+#include <chrono>
+#include <set>
+
+#include "em_test.h"
+
+#define EM_BENCH_CORS       "https://example.com"
+
+////////////////////////////////////////////////////
+
+// The headers of a portal page before the profiles: 3 sendHeader() calls, 4 with CORS
+static void sendHeadersBefore(ESP32_EMWebServer& server, const char* cors)
+{
+  server.sendHeader(FPSTR(EM_HTTP_CACHE_CONTROL), FPSTR(EM_HTTP_NO_STORE));
+
+  if (cors)
+    server.sendHeader(FPSTR(EM_HTTP_CORS), cors);
+
+  server.sendHeader(FPSTR(EM_HTTP_PRAGMA), FPSTR(EM_HTTP_NO_CACHE));
+  server.sendHeader(FPSTR(EM_HTTP_EXPIRES), "-1");
+}
+
+// Status line and headers of a streamed page
+static void sendHead(ESP32_EMWebServer& server)
+{
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, EM_HTTP_HEAD_CT, "");
+}
+
+// Header lines of a response, in any order
+static std::set<std::string> headerLines(const std::string& response)
+{
+  std::set<std::string> lines;
+
+  size_t pos = response.find("\r\n") + 2;
+  size_t end = response.find("\r\n\r\n");
+
+  while (pos < end)
+  {
+    size_t lineEnd = response.find("\r\n", pos);
+
+    lines.insert(response.substr(pos, lineEnd - pos));
+    pos = lineEnd + 2;
+  }
+
+  return lines;
+}
+
+////////////////////////////////////////////////////
+
+template<typename Function>
+static double bench(const char* name, const int& iterations, ESP32_EMWebServer& server, Function function)
+{
+  server.response.clear();
+  server.response.reserve(4096);
+
+  uint64_t  allocs  = em_hostHeap.allocs;
+  auto      start   = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; i++)
+  {
+    function();
+    server.response.clear();
+  }
+
+  double ns         = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+  double allocsPer  = (double) (em_hostHeap.allocs - allocs) / iterations;
+
+  printf("%-36s %8.1f ns  allocs/req = %5.1f\n", name, ns, allocsPer);
+
+  return allocsPer;
+}
+
+static void benchProfiles(const int& iterations)
+{
+  ESP32_EMWebServer server(80);
+
+  // Composed once, as for the Config Portal
+  String corsBlock = FPSTR(EM_HTTP_HEADERS_NO_CACHE);
+
+  corsBlock += FPSTR(EM_HTTP_CORS);
+  corsBlock += F(": ");
+  corsBlock += EM_BENCH_CORS;
+  corsBlock += F("\r\n");
+
+  double head       = bench("send() alone, head",             iterations, server, [&]() { sendHead(server); });
+  double before     = bench("sendHeader() x3, head",          iterations, server,
+                            [&]() { sendHeadersBefore(server, NULL); sendHead(server); });
+  double after      = bench("sendHeaderBlock(), head",        iterations, server,
+                            [&]() { server.sendHeaderBlock(EM_HTTP_HEADERS_NO_CACHE); sendHead(server); });
+  double corsBefore = bench("sendHeader() x4, CORS, head",    iterations, server,
+                            [&]() { sendHeadersBefore(server, EM_BENCH_CORS); sendHead(server); });
+  double corsAfter  = bench("sendHeaderBlock(), CORS, head",  iterations, server,
+                            [&]() { server.sendHeaderBlock(corsBlock.c_str()); sendHead(server); });
+
+  // Each sendHeader() call allocates its temporary Strings, the block nothing beyond what send() does anyway
+  EM_CHECK(after == head);
+  EM_CHECK(corsAfter == head);
+  EM_CHECK(before - head >= 3);
+  EM_CHECK(corsBefore - head >= 4);
+
+  printf("Page headers: %.0f -> %.0f allocs, %.0f -> %.0f with CORS, plus %.0f in send()\n",
+         before - head, after - head, corsBefore - head, corsAfter - head, head);
+
+  // The same header lines
+  sendHeadersBefore(server, EM_BENCH_CORS);
+  sendHead(server);
+
+  std::string responseBefore = server.response;
+
+  server.response.clear();
+  server.sendHeaderBlock(corsBlock.c_str());
+  sendHead(server);
+
+  EM_CHECK(headerLines(server.response) == headerLines(responseBefore));
+}
+
+////////////////////////////////////////////////////
+
+#if USING_CORS_FEATURE
+
+// The profiles composed by the Config Portal, after setCORSHeader()
+static void testPortalProfiles()
+{
+  ESP32_W5500_Manager manager("Profiles");
+
+  manager.setCORSHeader(EM_BENCH_CORS);
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  WebServer&  server  = *WebServer::instance();
+  std::string cors    = std::string(EM_HTTP_CORS) + ": " + EM_BENCH_CORS;
+
+  // EM_HEADERS_PAGE, or EM_HEADERS_REVALIDATE for the pages with an ETag
+  for (const char* uri : { "/", "/eth", "/i" })
+  {
+    EM_CHECK(server.request(uri) == 200);
+
+    std::set<std::string> lines = headerLines(server.response);
+
+    EM_CHECK(lines.count(cors) == 1);
+    EM_CHECK(lines.count("Cache-Control: no-cache, no-store, must-revalidate") + lines.count("Cache-Control: no-cache") == 1);
+  }
+
+  // EM_HEADERS_JSON
+  EM_CHECK(server.request("/state") == 200);
+
+  std::set<std::string> lines = headerLines(server.response);
+
+  EM_CHECK(lines.count(cors) == 1);
+  EM_CHECK(lines.count("X-Content-Type-Options: nosniff") == 1);
+  EM_CHECK(lines.count("Pragma: no-cache") == 1);
+
+  server.request("/close");
+  manager.process();
+}
+
+#endif
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+
+  benchProfiles(iterations);
+
+#if USING_CORS_FEATURE
+  testPortalProfiles();
+#endif
+
+  return em_testResult();
+}
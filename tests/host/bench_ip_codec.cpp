@@ -0,0 +1,293 @@
+// ESP32_W5500_Manager_IP.h: parse / format checked against glibc inet_pton() / inet_ntop() on a corpus, its
+// mutations and random addresses, Host header cases, then the codec timed against the previous String helpers
+//
+//   bench_ip_codec <corpus> [fuzz iterations]
+
+#include <ESP32_W5500_Manager.h>
+
+#include <arpa/inet.h>
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "em_test.h"
+
+static std::mt19937 rng(12345);
+
+////////////////////////////////////////////////////
+
+// The helpers replaced by the codec, for the benchmark
+static bool isIpOld(const String& str)
+{
+  for (size_t i = 0; i < str.length(); i++)
+  {
+    int c = str.charAt(i);
+
+    if ( (c != '.') && (c != ':') && ( (c < '0') || (c > '9') ) )
+      return false;
+  }
+
+  return true;
+}
+
+static String toStringIpOld(const IPAddress& ip)
+{
+  String res = "";
+
+  for (int i = 0; i < 3; i++)
+  {
+    res += String((ip >> (8 * i)) & 0xFF) + ".";
+  }
+
+  res += String(((ip >> 8 * 3)) & 0xFF);
+
+  return res;
+}
+
+////////////////////////////////////////////////////
+
+// Parsed the same way as by glibc, as IPv4 and as IPv6
+static void checkParse(const std::string& text)
+{
+  uint8_t emIP[16];
+  uint8_t refIP[16];
+
+  bool em   = em_parseIPv4(text.data(), text.size(), emIP);
+  bool ref  = (inet_pton(AF_INET, text.c_str(), refIP) == 1);
+
+  if ( (em != ref) || (em && memcmp(emIP, refIP, 4)) )
+  {
+    printf("FAIL IPv4 '%s': em %d, inet_pton %d\n", text.c_str(), em, ref);
+    em_testFailures++;
+  }
+
+  em  = em_parseIPv6(text.data(), text.size(), emIP);
+  ref = (inet_pton(AF_INET6, text.c_str(), refIP) == 1);
+
+  if ( (em != ref) || (em && memcmp(emIP, refIP, 16)) )
+  {
+    printf("FAIL IPv6 '%s': em %d, inet_pton %d\n", text.c_str(), em, ref);
+    em_testFailures++;
+  }
+}
+
+// Formatted the same way as by glibc
+static void checkFormat(const uint8_t* ip)
+{
+  char emText[EM_IPV6_STRLEN];
+  char refText[INET6_ADDRSTRLEN];
+
+  em_formatIPv6(ip, emText);
+  inet_ntop(AF_INET6, ip, refText, sizeof(refText));
+
+  if (strcmp(emText, refText) != 0)
+  {
+    printf("FAIL IPv6 format '%s', inet_ntop '%s'\n", emText, refText);
+    em_testFailures++;
+  }
+
+  em_formatIPv4(ip, emText);
+  inet_ntop(AF_INET, ip, refText, sizeof(refText));
+
+  if (strcmp(emText, refText) != 0)
+  {
+    printf("FAIL IPv4 format '%s', inet_ntop '%s'\n", emText, refText);
+    em_testFailures++;
+  }
+}
+
+////////////////////////////////////////////////////
+
+// Mostly zero and short groups, so that "::" compression and embedded IPv4 forms come up
+static void randomIPv6(uint8_t* ip)
+{
+  for (int group = 0; group < 8; group++)
+  {
+    int      kind   = rng() % 4;
+    uint16_t value  = (kind < 2) ? 0 : ( (kind == 2) ? (rng() % 16) : rng() );
+
+    ip[2 * group]     = value >> 8;
+    ip[2 * group + 1] = value;
+  }
+
+  // ::a.b.c.d and ::ffff:a.b.c.d
+  if (rng() % 8 == 0)
+  {
+    memset(ip, 0, 10);
+    ip[10] = ip[11] = (rng() % 2) ? 0xFF : 0;
+  }
+}
+
+static std::string mutate(std::string text)
+{
+  static const char chars[] = "0123456789af:.%x";
+
+  int edits = rng() % 4;
+
+  for (int i = 0; (i < edits) && !text.empty(); i++)
+  {
+    size_t pos = rng() % text.size();
+    char   c   = chars[rng() % (sizeof(chars) - 1)];
+
+    switch (rng() % 3)
+    {
+      case 0:
+        text.erase(pos, 1);
+        break;
+
+      case 1:
+        text.insert(pos, 1, c);
+        break;
+
+      default:
+        text[pos] = c;
+        break;
+    }
+  }
+
+  return text;
+}
+
+static void fuzz(const std::vector<std::string>& corpus, const long& iterations)
+{
+  char text[INET6_ADDRSTRLEN];
+
+  for (long i = 0; i < iterations; i++)
+  {
+    uint8_t ip[16];
+
+    randomIPv6(ip);
+    checkFormat(ip);
+
+    switch (i % 3)
+    {
+      case 0:
+        checkParse(mutate(corpus[rng() % corpus.size()]));
+        break;
+
+      case 1:
+        inet_ntop(AF_INET6, ip, text, sizeof(text));
+        checkParse(mutate(text));
+        break;
+
+      default:
+        inet_ntop(AF_INET, ip + 12, text, sizeof(text));
+        checkParse(mutate(text));
+        break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  const char* host;
+  bool        isIP;
+} EM_HostCase;
+
+static const EM_HostCase EM_HOST_CASES[] =
+{
+  { "192.168.2.1",          true  },
+  { "192.168.2.1:80",       true  },
+  { "192.168.2.1:",         false },
+  { "192.168.2.1:123456",   false },
+  { "192.168.2",            false },
+  { "999.1.1.1",            false },
+  { "1.2.3.4.5",            false },
+  { "12345",                false },
+  { "[::1]",                true  },
+  { "[::1]:8080",           true  },
+  { "[fe80::1%25eth0]",     true  },
+  { "[fe80::1]x",           false },
+  { "[::1",                 false },
+  { "[1.2.3.4]",            false },
+  { "fe80::1",              true  },
+  { "::ffff:1.2.3.4",       true  },
+  { "..::",                 false },
+  { "example.com",          false },
+  { "example.com:80",       false },
+  { "captive.apple.com",    false },
+};
+
+////////////////////////////////////////////////////
+
+template<typename Function>
+static void bench(const char* name, const int& iterations, Function function)
+{
+  volatile size_t sink = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < iterations; i++)
+    sink += function(i);
+
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+
+  printf("%-32s %8.1f ns\n", name, ns);
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2)
+  {
+    printf("Usage: %s <corpus> [fuzz iterations]\n", argv[0]);
+    return 2;
+  }
+
+  long iterations = (argc > 2) ? atol(argv[2]) : 3000000;
+
+  std::ifstream             file(argv[1]);
+  std::vector<std::string>  corpus;
+  std::string               line;
+
+  while (std::getline(file, line))
+    corpus.push_back(line);
+
+  EM_CHECK(!corpus.empty());
+
+  if (corpus.empty())
+    return 1;
+
+  for (const std::string& text : corpus)
+    checkParse(text);
+
+  fuzz(corpus, iterations);
+
+  for (const EM_HostCase& hostCase : EM_HOST_CASES)
+  {
+    if (em_isIPHost(hostCase.host, strlen(hostCase.host)) != hostCase.isIP)
+    {
+      printf("FAIL Host '%s' should %sbe an IP\n", hostCase.host, hostCase.isIP ? "" : "not ");
+      em_testFailures++;
+    }
+  }
+
+  printf("%zu corpus entries, %ld fuzz cases checked against inet_pton / inet_ntop\n", corpus.size(), iterations);
+
+  // Timed with at least 10000 iterations, so that the smoke run under ctest stays short
+  int benchIterations = (iterations < 10000) ? 10000 : ( (iterations > 2000000) ? 2000000 : iterations );
+
+  String    ipHost    = "192.168.100.200:80";
+  String    nameHost  = "connectivitycheck.gstatic.com";
+  IPAddress ip;
+  char      text[EM_IPV6_STRLEN];
+  uint8_t   ipv6[16];
+
+  em_parseIPv6("fe80::1234:5678:9abc:def0", 25, ipv6);
+
+  bench("isIp(), IP host",                benchIterations, [&](int) { return (size_t) isIpOld(ipHost); });
+  bench("em_isIPHost(), IP host",         benchIterations, [&](int) { return (size_t) em_isIPHost(ipHost.c_str(), ipHost.length()); });
+  bench("isIp(), name host",              benchIterations, [&](int) { return (size_t) isIpOld(nameHost); });
+  bench("em_isIPHost(), name host",       benchIterations, [&](int) { return (size_t) em_isIPHost(nameHost.c_str(), nameHost.length()); });
+  bench("toStringIp()",                   benchIterations, [&](int i) { return (size_t) toStringIpOld(IPAddress(192, 168, i & 0xFF, 200)).length(); });
+  bench("em_formatIPv4()",                benchIterations, [&](int i) { return em_formatIPv4(IPAddress(192, 168, i & 0xFF, 200), text); });
+  bench("IPAddress::fromString()",        benchIterations, [&](int) { return (size_t) ip.fromString("192.168.100.200"); });
+  bench("em_parseIPv4()",                 benchIterations, [&](int) { return (size_t) em_parseIPv4("192.168.100.200", ip); });
+  bench("em_parseIPv6()",                 benchIterations, [&](int) { return (size_t) em_parseIPv6("fe80::1234:5678:9abc:def0", 25, ipv6); });
+  bench("em_formatIPv6()",                benchIterations, [&](int) { return em_formatIPv6(ipv6, text); });
+
+  return em_testResult();
+}
@@ -0,0 +1,114 @@
+// Config Portal route benchmark: each route with 0, 20 and 200 parameters, reporting the time,
+// heap allocations and peak heap per request. Fails if a route doesn't answer as expected.
+//
+//   bench_routes [iterations]
+
+#include <ESP32_W5500_Manager.h>
+
+#include <vector>
+
+#include "em_test.h"
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  const char* uri;
+  int         code;
+} EM_BenchRoute;
+
+static const EM_BenchRoute EM_BENCH_ROUTES[] =
+{
+  { "/",        200 },
+  { "/eth",     200 },
+  { "/ethsave", 200 },
+  { "/i",       200 },
+  { "/state",   200 },
+  { "/close",   200 },
+};
+
+////////////////////////////////////////////////////
+
+static void benchParams(const int& paramCount, const int& iterations)
+{
+  ESP32_W5500_Manager manager("Bench");
+
+  std::vector<std::string>        ids;
+  std::vector<ESP32_EMParameter*> params;
+
+  ids.reserve(paramCount);
+
+  for (int i = 0; i < paramCount; i++)
+  {
+    ids.push_back("param" + std::to_string(i));
+    params.push_back(new ESP32_EMParameter(ids.back().c_str(), "Placeholder text", "value", 32));
+    manager.addParameter(params.back());
+  }
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  WebServer& server = *WebServer::instance();
+
+  for (const EM_BenchRoute& route : EM_BENCH_ROUTES)
+  {
+    server.requestArgs.clear();
+
+    if (strcmp(route.uri, "/ethsave") == 0)
+    {
+      for (auto& id : ids)
+        server.requestArgs.push_back({ id.c_str(), "new value" });
+
+      server.requestArgs.push_back({ "ip", "192.168.2.50" });
+      server.requestArgs.push_back({ "gw", "192.168.2.1" });
+      server.requestArgs.push_back({ "sn", "255.255.255.0" });
+    }
+
+    int code = server.request(route.uri);
+
+    if ( (code != route.code) || server.responseBody().empty() )
+    {
+      printf("FAIL %s with %d params: status %d, %zu bytes\n", route.uri, paramCount, code, server.response.size());
+      em_testFailures++;
+    }
+
+    size_t    bytes   = server.response.size();
+    size_t    peak    = 0;
+    uint64_t  allocs  = em_hostHeap.allocs;
+    auto      start   = micros();
+
+    for (int i = 0; i < iterations; i++)
+    {
+      size_t base = em_hostHeap.current;
+
+      em_hostResetPeak();
+      server.request(route.uri);
+
+      if (em_hostHeap.peak - base > peak)
+        peak = em_hostHeap.peak - base;
+    }
+
+    double us = (double) (micros() - start) / iterations;
+
+    printf("%-9s params=%3d  %8.2f us/req  allocs/req=%7.1f  peakHeap=%6zu B  response=%6zu B\n", route.uri, paramCount,
+           us, (double) (em_hostHeap.allocs - allocs) / iterations, peak, bytes);
+  }
+
+  // Closes the portal, as requested by /close
+  manager.process();
+
+  for (auto param : params)
+    delete param;
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  int iterations = (argc > 1) ? atoi(argv[1]) : 200;
+
+  for (int paramCount : { 0, 20, 200 })
+    benchParams(paramCount, iterations);
+
+  return em_testResult();
+}
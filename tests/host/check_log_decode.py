@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#
+# Runs the text and the ESP32_ETH_MGR_BINARY_LOG builds of the same program, decodes the binary log with
+# utils/em_log_decode.py and checks that it gives the text log, line for line. This keeps em_logId() and
+# em_isLogLiteral() in sync with log_id() and is_literal() of the decoder
+#
+#   check_log_decode.py <text build> <binary build> [args...]
+
+import difflib
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+DECODER = Path(__file__).resolve().parent.parent.parent / "utils" / "em_log_decode.py"
+
+# Lines logging the time, which may differ between the 2 runs
+TIMING = re.compile(r"millis\(\)")
+DIGITS = re.compile(r"\d+")
+
+
+def run(command):
+  # The LOG* output, written to stderr by the host Serial
+  result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+
+  if result.returncode != 0:
+    sys.exit("FAIL %s exited with %d" % (command[0], result.returncode))
+
+  return result.stderr
+
+
+def same(text, decoded):
+  if TIMING.search(text):
+    return DIGITS.sub("0", text) == DIGITS.sub("0", decoded)
+
+  return text == decoded
+
+
+def main():
+  if len(sys.argv) < 3:
+    sys.exit("Usage: %s <text build> <binary build> [args...]" % sys.argv[0])
+
+  text = run([sys.argv[1]] + sys.argv[3:])
+  binary = run([sys.argv[2]] + sys.argv[3:])
+
+  decoded = subprocess.run([sys.executable, str(DECODER), "-"], input=binary, stdout=subprocess.PIPE, check=True).stdout
+
+  # Text mode ends its lines with println()'s "\r\n", the decoder with "\n"
+  expected = text.decode("utf-8", "replace").replace("\r\n", "\n").splitlines()
+  lines = decoded.decode("utf-8", "replace").splitlines()
+
+  print("%d lines: text %d bytes, binary %d bytes (%.1fx)" % (len(expected), len(text), len(binary),
+                                                             len(text) / max(1, len(binary))))
+
+  if not expected or len(lines) != len(expected) or not all(same(t, d) for t, d in zip(expected, lines)):
+    sys.stdout.writelines(l + "\n" for l in difflib.unified_diff(expected, lines, "text", "decoded", lineterm=""))
+    print("FAILED")
+    sys.exit(1)
+
+  print("OK")
+
+
+if __name__ == "__main__":
+  main()
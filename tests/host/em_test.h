@@ -0,0 +1,25 @@
+// Shared by the host tests: EM_CHECK() reports a failed condition and goes on, em_testResult() prints the
+// outcome and gives the exit code of the test
+
+#pragma once
+
+#include <stdio.h>
+
+static int em_testFailures = 0;
+
+#define EM_CHECK(cond)                                          \
+  do                                                            \
+  {                                                             \
+    if (!(cond))                                                \
+    {                                                           \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);    \
+      em_testFailures++;                                        \
+    }                                                           \
+  } while (0)
+
+inline int em_testResult()
+{
+  printf("%s\n", em_testFailures ? "FAILED" : "OK");
+
+  return em_testFailures ? 1 : 0;
+}
@@ -0,0 +1,60 @@
+// Config Portal flows with logging on, writing the LOG* output to stderr: built once in text mode and once
+// with ESP32_ETH_MGR_BINARY_LOG, for check_log_decode.py to compare the decoded binary log with the text
+//
+//   log_flows [params]
+
+#include <ESP32_W5500_Manager.h>
+
+#include <vector>
+
+#include "em_test.h"
+
+int main(int argc, char** argv)
+{
+  int paramCount = (argc > 1) ? atoi(argv[1]) : 20;
+
+  ESP32_W5500_Manager manager("Flows");
+
+  std::vector<std::string>        ids;
+  std::vector<ESP32_EMParameter*> params;
+
+  ids.reserve(paramCount);
+
+  for (int i = 0; i < paramCount; i++)
+  {
+    ids.push_back("param" + std::to_string(i));
+    params.push_back(new ESP32_EMParameter(ids.back().c_str(), "Placeholder text", "value", 32));
+    manager.addParameter(params.back());
+  }
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  WebServer& server = *WebServer::instance();
+
+  // Captive portal probe, then the pages
+  server.requestHost = "connectivitycheck.gstatic.com";
+
+  EM_CHECK(server.request("/generate_204") == 302);
+
+  server.requestHost = "192.168.4.1";
+
+  for (const char* uri : { "/", "/eth", "/i", "/state" })
+    EM_CHECK(server.request(uri) == 200);
+
+  // Saved, which closes the Config Portal
+  for (int i = 0; i < paramCount; i++)
+    server.requestArgs.push_back({ ids[i].c_str(), ("new value " + std::to_string(i)).c_str() });
+
+  server.requestArgs.push_back({ "ip", "192.168.2.50" });
+  server.requestArgs.push_back({ "gw", "192.168.2.1" });
+  server.requestArgs.push_back({ "sn", "255.255.255.0" });
+
+  EM_CHECK(server.request("/ethsave") == 200);
+  EM_CHECK(manager.process());
+
+  for (auto param : params)
+    delete param;
+
+  return em_testResult();
+}
@@ -0,0 +1,273 @@
+// Host stand-in for the parts of the Arduino ESP32 core used by the library
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <strings.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstdarg>
+#include <string>
+#include <algorithm>
+#include <functional>
+#include <chrono>
+
+#define PROGMEM
+#define PGM_P               const char*
+#define PSTR(s)             (s)
+#define strlen_P            strlen
+#define memcpy_P            memcpy
+#define strcmp_P            strcmp
+#define strncmp_P           strncmp
+#define snprintf_P          snprintf
+
+#define HEX                 16
+#define DEC                 10
+
+typedef uint8_t byte;
+
+class __FlashStringHelper;
+
+#define F(s)                (reinterpret_cast<const __FlashStringHelper*>(s))
+#define FPSTR(p)            (reinterpret_cast<const __FlashStringHelper*>(p))
+
+inline unsigned long millis()
+{
+  static auto start = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline unsigned long micros()
+{
+  static auto start = std::chrono::steady_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline void delay(unsigned long) {}
+inline void yield() {}
+
+inline long random(long max)
+{
+  return rand() % max;
+}
+
+inline uint32_t esp_random()
+{
+  return (uint32_t) rand();
+}
+
+////////////////////////////////////////////////////
+
+// Arduino String over std::string, allocating through the counted operator new like the real one
+class String
+{
+  public:
+
+    String() {}
+    String(const char* str)                 { if (str) s = str; }
+    String(const std::string& str) : s(str) {}
+    String(const __FlashStringHelper* str)  { if (str) s = (const char*) str; }
+    String(char c)                          { s = c; }
+    String(int v, int base = 10)            { format(base == 16 ? "%x" : "%d", v); }
+    String(unsigned v, int base = 10)       { format(base == 16 ? "%x" : "%u", v); }
+    String(long v, int base = 10)           { format(base == 16 ? "%lx" : "%ld", v); }
+    String(unsigned long v, int base = 10)  { format(base == 16 ? "%lx" : "%lu", v); }
+
+    const char* c_str() const               { return s.c_str(); }
+    unsigned length() const                 { return s.size(); }
+    bool isEmpty() const                    { return s.empty(); }
+    char charAt(unsigned i) const           { return s[i]; }
+    bool reserve(unsigned size)             { s.reserve(size); return true; }
+
+    void toUpperCase()                      { for (auto& c : s) c = toupper(c); }
+
+    void toCharArray(char* buf, unsigned size) const
+    {
+      if (size == 0)
+        return;
+
+      strncpy(buf, s.c_str(), size - 1);
+      buf[size - 1] = 0;
+    }
+
+    int indexOf(const char* str) const      { auto pos = s.find(str); return (pos == std::string::npos) ? -1 : (int) pos; }
+    int indexOf(char c) const               { auto pos = s.find(c);   return (pos == std::string::npos) ? -1 : (int) pos; }
+
+    void replace(const String& from, const String& to)
+    {
+      for (size_t pos = 0; (pos = s.find(from.s, pos)) != std::string::npos; pos += to.s.size())
+        s.replace(pos, from.s.size(), to.s);
+    }
+
+    String& operator+=(const String& str)               { s += str.s; return *this; }
+    String& operator+=(const char* str)                 { s += str; return *this; }
+    String& operator+=(const __FlashStringHelper* str)  { s += (const char*) str; return *this; }
+    String& operator+=(char c)                          { s += c; return *this; }
+    String& operator+=(int v)                           { s += std::to_string(v); return *this; }
+    String& operator+=(unsigned v)                      { s += std::to_string(v); return *this; }
+    String& operator+=(long v)                          { s += std::to_string(v); return *this; }
+    String& operator+=(unsigned long v)                 { s += std::to_string(v); return *this; }
+
+    bool operator==(const char* str) const              { return s == str; }
+    bool operator!=(const char* str) const              { return s != str; }
+    bool operator==(const String& str) const            { return s == str.s; }
+    bool operator!=(const String& str) const            { return s != str.s; }
+
+    bool equalsIgnoreCase(const String& str) const      { return strcasecmp(s.c_str(), str.s.c_str()) == 0; }
+
+    std::string s;
+
+  private:
+
+    void format(const char* fmt, long long v)
+    {
+      char buf[24];
+
+      snprintf(buf, sizeof(buf), fmt, v);
+      s = buf;
+    }
+};
+
+inline String operator+(const String& a, const String& b)   { return String(a.s + b.s); }
+inline String operator+(const String& a, const char* b)     { return String(a.s + b); }
+inline String operator+(const char* a, const String& b)     { return String(std::string(a) + b.s); }
+
+////////////////////////////////////////////////////
+
+class Print;
+
+class Printable
+{
+  public:
+
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Print
+{
+  public:
+
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buf, size_t size)
+    {
+      size_t n = 0;
+
+      while (size--)
+        n += write(*buf++);
+
+      return n;
+    }
+
+    virtual void flush() {}
+
+    size_t write(const char* str)                       { return str ? write((const uint8_t*) str, strlen(str)) : 0; }
+    size_t write(const char* buf, size_t size)          { return write((const uint8_t*) buf, size); }
+
+    size_t print(const char* str)                       { return write(str); }
+    size_t print(const __FlashStringHelper* str)        { return write((const char*) str); }
+    size_t print(const String& str)                     { return write(str.c_str(), str.length()); }
+    size_t print(char c)                                { return write((uint8_t) c); }
+    size_t print(const Printable& p)                    { return p.printTo(*this); }
+    size_t print(unsigned char v, int base = 10)        { return printNumber(v, base, false); }
+    size_t print(int v, int base = 10)                  { return print((long long) v, base); }
+    size_t print(long v, int base = 10)                 { return print((long long) v, base); }
+    size_t print(unsigned v, int base = 10)             { return printNumber(v, base, false); }
+    size_t print(unsigned long v, int base = 10)        { return printNumber(v, base, false); }
+    size_t print(unsigned long long v, int base = 10)   { return printNumber(v, base, false); }
+
+    size_t print(long long v, int base = 10)
+    {
+      if ( (v < 0) && (base == 10) )
+        return printNumber(-v, 10, true);
+
+      return printNumber((unsigned long long) v, base, false);
+    }
+
+    size_t print(double v, int digits = 2)
+    {
+      char buf[40];
+
+      snprintf(buf, sizeof(buf), "%.*f", digits, v);
+
+      return write(buf);
+    }
+
+    size_t println()                                    { return write("\r\n"); }
+
+    template<class T> size_t println(const T& v)        { return print(v) + println(); }
+    template<class T> size_t println(const T& v, int b) { return print(v, b) + println(); }
+
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+      char    buf[256];
+      va_list args;
+
+      va_start(args, fmt);
+      int len = vsnprintf(buf, sizeof(buf), fmt, args);
+      va_end(args);
+
+      return write(buf, (len < (int) sizeof(buf)) ? len : sizeof(buf) - 1);
+    }
+
+  private:
+
+    size_t printNumber(unsigned long long v, int base, bool negative)
+    {
+      char  buf[70];
+      char* pos = buf + sizeof(buf) - 1;
+
+      *pos = 0;
+
+      do
+      {
+        int digit = v % base;
+
+        *--pos  = (digit < 10) ? ('0' + digit) : ('A' + digit - 10);
+        v      /= base;
+      } while (v);
+
+      if (negative)
+        *--pos = '-';
+
+      return write(pos);
+    }
+};
+
+class Stream : public Print
+{
+  public:
+
+    virtual int available() { return 0; }
+    virtual int read()      { return -1; }
+};
+
+// Serial goes to stderr, so that it doesn't mix with the reports
+class HardwareSerial : public Stream
+{
+  public:
+
+    void begin(unsigned long) {}
+
+    size_t write(uint8_t c) override
+    {
+      fputc(c, stderr);
+
+      return 1;
+    }
+
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#include "IPAddress.h"
+#include "freertos/FreeRTOS.h"
+#include "Esp.h"
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "WiFi.h"
+
+enum class DNSReplyCode
+{
+  NoError = 0
+};
+
+class DNSServer
+{
+  public:
+
+    void setErrorReplyCode(const DNSReplyCode&) {}
+    bool start(const uint16_t&, const String&, const IPAddress&)  { return true; }
+    void stop() {}
+    void processNextRequest() {}
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "esp_heap_caps.h"
+
+class EspClass
+{
+  public:
+
+    uint64_t getEfuseMac()          { return 0x123456789ABCULL; }
+    const char* getChipModel()      { return "ESP32-D0WDQ6"; }
+    uint8_t getChipRevision()       { return 1; }
+    uint32_t getFlashChipSize()     { return 4194304; }
+    uint32_t getFreeHeap()          { return 200000; }
+    uint32_t getMinFreeHeap()       { return 150000; }
+    uint32_t getMaxAllocHeap()      { return 110000; }
+    uint32_t getPsramSize()         { return 0; }
+
+    // Counted, so that a test can see it without the process going away
+    void restart()                  { restarts++; }
+
+    int restarts = 0;
+};
+
+extern EspClass ESP;
@@ -0,0 +1,77 @@
+// In-memory file system. Tests reach the file contents through files
+
+#pragma once
+
+#include <map>
+
+#include "Arduino.h"
+
+#define FILE_READ       "r"
+#define FILE_WRITE      "w"
+
+namespace fs
+{
+
+class File : public Stream
+{
+  public:
+
+    size_t write(uint8_t c) override                          { return write(&c, 1); }
+
+    size_t write(const uint8_t* buf, size_t size) override
+    {
+      data->append((const char*) buf, size);
+
+      return size;
+    }
+
+    using Print::write;
+
+    size_t read(uint8_t* buf, size_t size)
+    {
+      size_t len = std::min(size, data->size() - pos);
+
+      memcpy(buf, data->data() + pos, len);
+      pos += len;
+
+      return len;
+    }
+
+    int read() override                                       { return (pos < data->size()) ? (uint8_t) (*data)[pos++] : -1; }
+    int available() override                                 { return data ? data->size() - pos : 0; }
+    size_t size()                                             { return data ? data->size() : 0; }
+    void close() {}
+    operator bool()                                           { return data != NULL; }
+
+    std::string*  data  = NULL;
+    size_t        pos   = 0;
+};
+
+class FS
+{
+  public:
+
+    File open(const char* path, const char* mode = FILE_READ)
+    {
+      File file;
+
+      if (mode[0] == 'w')
+      {
+        files[path].clear();
+        file.data = &files[path];
+      }
+      else if (files.count(path))
+      {
+        file.data = &files[path];
+      }
+
+      return file;
+    }
+
+    bool exists(const char* path)                             { return files.count(path) > 0; }
+    bool remove(const char* path)                             { return files.erase(path) > 0; }
+
+    std::map<std::string, std::string> files;
+};
+
+}   // namespace fs
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Arduino.h"
+
+class IPAddress : public Printable
+{
+  public:
+
+    IPAddress()                                           { _address.dword = 0; }
+    IPAddress(uint32_t address)                           { _address.dword = address; }
+
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    {
+      _address.bytes[0] = a;
+      _address.bytes[1] = b;
+      _address.bytes[2] = c;
+      _address.bytes[3] = d;
+    }
+
+    operator uint32_t() const                             { return _address.dword; }
+    uint8_t operator[](int i) const                       { return _address.bytes[i]; }
+    uint8_t& operator[](int i)                            { return _address.bytes[i]; }
+    bool operator==(const IPAddress& other) const         { return _address.dword == other._address.dword; }
+    bool operator!=(const IPAddress& other) const         { return _address.dword != other._address.dword; }
+
+    bool fromString(const char* str)
+    {
+      unsigned a, b, c, d;
+      char     extra;
+
+      if ( (sscanf(str, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4) || (a > 255) || (b > 255) || (c > 255) || (d > 255) )
+        return false;
+
+      *this = IPAddress(a, b, c, d);
+
+      return true;
+    }
+
+    bool fromString(const String& str)                    { return fromString(str.c_str()); }
+
+    String toString() const
+    {
+      char buf[16];
+
+      snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+
+      return String(buf);
+    }
+
+    size_t printTo(Print& p) const override               { return p.print(toString()); }
+
+  private:
+
+    union
+    {
+      uint8_t   bytes[4];
+      uint32_t  dword;
+    } _address;
+};
@@ -0,0 +1,67 @@
+// In-memory NVS, shared by all Preferences instances like the real partition
+
+#pragma once
+
+#include <map>
+
+#include "Arduino.h"
+
+class Preferences
+{
+  public:
+
+    bool begin(const char* name, bool readOnly = false)
+    {
+      (void) readOnly;
+
+      _name = name;
+
+      return true;
+    }
+
+    void end() {}
+
+    size_t putBytes(const char* key, const void* value, size_t len)
+    {
+      storage()[_name + "/" + key] = std::string((const char*) value, len);
+
+      return len;
+    }
+
+    size_t getBytesLength(const char* key)
+    {
+      auto it = storage().find(_name + "/" + key);
+
+      return (it == storage().end()) ? 0 : it->second.size();
+    }
+
+    size_t getBytes(const char* key, void* buf, size_t maxLen)
+    {
+      auto it = storage().find(_name + "/" + key);
+
+      if (it == storage().end())
+        return 0;
+
+      size_t len = std::min(maxLen, it->second.size());
+
+      memcpy(buf, it->second.data(), len);
+
+      return len;
+    }
+
+    bool remove(const char* key)
+    {
+      return storage().erase(_name + "/" + key) > 0;
+    }
+
+    static std::map<std::string, std::string>& storage()
+    {
+      static std::map<std::string, std::string> values;
+
+      return values;
+    }
+
+  private:
+
+    std::string _name;
+};
@@ -0,0 +1,386 @@
+// Host stand-in for the ESP32 core WebServer, with the same overloads, protected members and response
+// formatting, including the String temporaries of sendHeader(). Requests are injected with request()
+
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "WiFi.h"
+
+typedef enum
+{
+  HTTP_DELETE   = 0,
+  HTTP_GET      = 1,
+  HTTP_HEAD     = 2,
+  HTTP_POST     = 3,
+  HTTP_PUT      = 4,
+  HTTP_OPTIONS  = 6,
+  HTTP_PATCH    = 28
+} HTTPMethod;
+
+#define HTTP_ANY                  (HTTPMethod)(255)
+
+#define CONTENT_LENGTH_UNKNOWN    ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET    ((size_t) -2)
+
+class WebServer
+{
+  public:
+
+    typedef std::function<void(void)> THandlerFunction;
+
+    WebServer(int port = 80)
+    {
+      (void) port;
+
+      instance() = this;
+    }
+
+    ~WebServer()
+    {
+      if (instance() == this)
+        instance() = NULL;
+    }
+
+    // The last WebServer created, i.e. the Config Portal's
+    static WebServer*& instance()
+    {
+      static WebServer* server = NULL;
+
+      return server;
+    }
+
+    void begin() {}
+    void stop() {}
+    void close() {}
+    void handleClient() {}
+
+    void on(const String& uri, THandlerFunction handler)                     { _routes.push_back({ uri, handler }); }
+    void on(const String& uri, HTTPMethod, THandlerFunction handler)         { on(uri, handler); }
+    void onNotFound(THandlerFunction handler)                                 { _notFoundHandler = handler; }
+
+    void collectHeaders(const char* headerKeys[], const size_t headerKeysCount)
+    {
+      _headerKeys.assign(headerKeys, headerKeys + headerKeysCount);
+    }
+
+    String uri()                                  { return _currentUri; }
+    HTTPMethod method()                           { return _currentMethod; }
+    String hostHeader()                           { return _hostHeader; }
+    int args()                                    { return _currentArgCount; }
+    String arg(int i)                             { return (i < _currentArgCount) ? _currentArgs[i].value : String(); }
+    String argName(int i)                         { return (i < _currentArgCount) ? _currentArgs[i].key : String(); }
+
+    String arg(const String& name)
+    {
+      for (int i = 0; i < _currentArgCount; i++)
+      {
+        if (_currentArgs[i].key == name)
+          return _currentArgs[i].value;
+      }
+
+      return String();
+    }
+
+    bool hasArg(const String& name)
+    {
+      for (int i = 0; i < _currentArgCount; i++)
+      {
+        if (_currentArgs[i].key == name)
+          return true;
+      }
+
+      return false;
+    }
+
+    String header(const String& name)
+    {
+      for (auto& header : _currentHeaders)
+      {
+        if (header.first.equalsIgnoreCase(name))
+          return header.second;
+      }
+
+      return String();
+    }
+
+    bool hasHeader(const String& name)
+    {
+      return header(name).length() > 0;
+    }
+
+    WiFiClient& client()
+    {
+      _currentClient.output = &response;
+
+      return _currentClient;
+    }
+
+    ///////////////////////////
+
+    void setContentLength(const size_t contentLength)
+    {
+      _contentLength = contentLength;
+    }
+
+    void sendHeader(const String& name, const String& value, bool first = false)
+    {
+      String headerLine = name;
+
+      headerLine += F(": ");
+      headerLine += value;
+      headerLine += "\r\n";
+
+      if (first)
+        _responseHeaders = headerLine + _responseHeaders;
+      else
+        _responseHeaders += headerLine;
+    }
+
+    void send(int code, const char* content_type = NULL, const String& content = String(""))
+    {
+      String header;
+
+      _prepareHeader(header, code, content_type, content.length());
+      _write(header.c_str(), header.length());
+
+      if (content.length())
+        sendContent(content);
+    }
+
+    void send(int code, char* content_type, const String& content)
+    {
+      send(code, (const char*) content_type, content);
+    }
+
+    void send(int code, const String& content_type, const String& content)
+    {
+      send(code, (const char*) content_type.c_str(), content);
+    }
+
+    void send(int code, const char* content_type, const char* content)
+    {
+      send(code, content_type, String(content));
+    }
+
+    void send_P(int code, PGM_P content_type, PGM_P content)
+    {
+      send_P(code, content_type, content, strlen_P(content));
+    }
+
+    void send_P(int code, PGM_P content_type, PGM_P content, size_t contentLength)
+    {
+      String header;
+
+      _prepareHeader(header, code, content_type, contentLength);
+      _write(header.c_str(), header.length());
+      sendContent_P(content, contentLength);
+    }
+
+    void sendContent(const String& content)
+    {
+      sendContent(content.c_str(), content.length());
+    }
+
+    void sendContent(const char* content, size_t contentLength)
+    {
+      if (_chunked)
+      {
+        char chunkSize[20];
+
+        snprintf(chunkSize, sizeof(chunkSize), "%zx\r\n", contentLength);
+        _write(chunkSize, strlen(chunkSize));
+      }
+
+      _write(content, contentLength);
+
+      if (_chunked)
+      {
+        _write("\r\n", 2);
+
+        if (contentLength == 0)
+          _chunked = false;
+      }
+    }
+
+    void sendContent_P(PGM_P content)
+    {
+      sendContent(content, strlen_P(content));
+    }
+
+    void sendContent_P(PGM_P content, size_t size)
+    {
+      sendContent(content, size);
+    }
+
+    ///////////////////////////
+    // Host side
+
+    // Run the handler of uri, as handleClient() would for a complete request with requestArgs,
+    // requestHeaders and requestHost. Returns the status code of the response, which is in response
+    int request(const String& uri, HTTPMethod method = HTTP_GET)
+    {
+      response.clear();
+
+      _currentUri       = uri;
+      _currentMethod    = method;
+      _hostHeader       = requestHost;
+      _contentLength    = CONTENT_LENGTH_NOT_SET;
+      _chunked          = false;
+      _responseHeaders  = "";
+
+      _argStorage.clear();
+
+      for (auto& arg : requestArgs)
+        _argStorage.push_back({ arg.first, arg.second });
+
+      _currentArgs      = _argStorage.data();
+      _currentArgCount  = _argStorage.size();
+
+      _currentHeaders.clear();
+
+      for (auto& header : requestHeaders)
+      {
+        for (auto& key : _headerKeys)
+        {
+          if (header.first.equalsIgnoreCase(key))
+            _currentHeaders.push_back(header);
+        }
+      }
+
+      _currentClient.connected_ = true;
+
+      THandlerFunction* handler = &_notFoundHandler;
+
+      for (auto& route : _routes)
+      {
+        if (route.first == uri)
+        {
+          handler = &route.second;
+          break;
+        }
+      }
+
+      if (*handler)
+        (*handler)();
+      else
+        send(404, "text/plain", "Not found");
+
+      return (response.compare(0, 9, "HTTP/1.1 ") == 0) ? atoi(response.c_str() + 9) : 0;
+    }
+
+    // Body of the response, with the chunks joined
+    std::string responseBody() const
+    {
+      size_t pos = response.find("\r\n\r\n");
+
+      if (pos == std::string::npos)
+        return "";
+
+      pos += 4;
+
+      if (response.find("Transfer-Encoding: chunked") == std::string::npos)
+        return response.substr(pos);
+
+      std::string body;
+
+      while (pos < response.size())
+      {
+        size_t lineEnd  = response.find("\r\n", pos);
+        size_t size     = strtoul(response.c_str() + pos, NULL, 16);
+
+        if ( (lineEnd == std::string::npos) || (size == 0) )
+          break;
+
+        body += response.substr(lineEnd + 2, size);
+        pos   = lineEnd + 2 + size + 2;
+      }
+
+      return body;
+    }
+
+    std::vector<std::pair<String, String>>  requestArgs;
+    std::vector<std::pair<String, String>>  requestHeaders;
+    String                                  requestHost = "192.168.2.232";
+
+    std::string                             response;
+
+  protected:
+
+    struct RequestArgument
+    {
+      String key;
+      String value;
+    };
+
+    void _prepareHeader(String& response, int code, const char* content_type, size_t contentLength)
+    {
+      response = String(F("HTTP/1.1 ")) + String(code) + " " + _responseCodeToString(code) + "\r\n";
+
+      if (!content_type)
+        content_type = "text/html";
+
+      sendHeader(String(F("Content-Type")), String(FPSTR(content_type)), true);
+
+      if (_contentLength == CONTENT_LENGTH_NOT_SET)
+      {
+        sendHeader(String(F("Content-Length")), String((unsigned long) contentLength));
+      }
+      else if (_contentLength != CONTENT_LENGTH_UNKNOWN)
+      {
+        sendHeader(String(F("Content-Length")), String((unsigned long) _contentLength));
+      }
+      else
+      {
+        _chunked = true;
+
+        sendHeader(String(F("Accept-Ranges")), String(F("none")));
+        sendHeader(String(F("Transfer-Encoding")), String(F("chunked")));
+      }
+
+      sendHeader(String(F("Connection")), String(F("close")));
+
+      response += _responseHeaders;
+      response += "\r\n";
+
+      _responseHeaders = "";
+    }
+
+    static const char* _responseCodeToString(int code)
+    {
+      switch (code)
+      {
+        case 200: return "OK";
+        case 302: return "Found";
+        case 304: return "Not Modified";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 500: return "Internal Server Error";
+        default:  return "";
+      }
+    }
+
+    void _write(const char* data, size_t len)
+    {
+      response.append(data, len);
+    }
+
+    String              _currentUri;
+    HTTPMethod          _currentMethod    = HTTP_GET;
+    String              _hostHeader;
+    String              _responseHeaders;
+    size_t              _contentLength    = CONTENT_LENGTH_NOT_SET;
+    bool                _chunked          = false;
+    RequestArgument*    _currentArgs      = NULL;
+    int                 _currentArgCount  = 0;
+    WiFiClient          _currentClient;
+
+  private:
+
+    std::vector<std::pair<String, THandlerFunction>>  _routes;
+    THandlerFunction                                  _notFoundHandler;
+    std::vector<String>                               _headerKeys;
+    std::vector<std::pair<String, String>>            _currentHeaders;
+    std::vector<RequestArgument>                      _argStorage;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "WiFi.h"
+
+class ETHClass
+{
+  public:
+
+    IPAddress localIP()                   { return ip; }
+    IPAddress gatewayIP()                 { return IPAddress(192, 168, 2, 1); }
+    IPAddress subnetMask()                { return IPAddress(255, 255, 255, 0); }
+    String macAddress()                   { return "DE:AD:BE:EF:FE:ED"; }
+    bool setHostname(const char*)         { return true; }
+    bool linkUp()                         { return link; }
+    uint8_t linkSpeed()                   { return 100; }
+    bool fullDuplex()                     { return true; }
+
+    IPAddress ip    = IPAddress(192, 168, 2, 232);
+    bool      link  = true;
+};
+
+extern ETHClass ETH;
+
+inline bool ESP32_W5500_isConnected()
+{
+  return true;
+}
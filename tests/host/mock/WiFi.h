@@ -0,0 +1,99 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include "Arduino.h"
+
+typedef enum
+{
+  WL_IDLE_STATUS  = 0,
+  WL_CONNECTED    = 3,
+  WL_DISCONNECTED = 6,
+  WL_NO_SHIELD    = 255
+} wl_status_t;
+
+// Writes go to the response of the mock WebServer
+class WiFiClient : public Stream
+{
+  public:
+
+    size_t write(uint8_t c) override                          { return write(&c, 1); }
+
+    size_t write(const uint8_t* buf, size_t size) override
+    {
+      if (output)
+        output->append((const char*) buf, size);
+
+      return size;
+    }
+
+    using Print::write;
+
+    void stop()                                               { connected_ = false; }
+    uint8_t connected()                                       { return connected_; }
+    operator bool()                                           { return connected_; }
+    void setNoDelay(bool) {}
+
+    IPAddress localIP()                                       { return IPAddress(192, 168, 2, 232); }
+    IPAddress remoteIP()                                      { return IPAddress(192, 168, 2, 100); }
+
+    std::string*  output      = NULL;
+    bool          connected_  = true;
+};
+
+// Datagrams queued by the test in received, replies collected in sent
+class WiFiUDP : public Stream
+{
+  public:
+
+    uint8_t begin(uint16_t)                                   { return 1; }
+    void stop() {}
+
+    int parsePacket()
+    {
+      if (received.empty())
+        return 0;
+
+      packet = received.front();
+      received.pop_front();
+      pos = 0;
+
+      return packet.size();
+    }
+
+    int read(uint8_t* buf, size_t size)
+    {
+      size_t len = std::min(size, packet.size() - pos);
+
+      memcpy(buf, packet.data() + pos, len);
+      pos += len;
+
+      return len;
+    }
+
+    int read() override                                       { return (pos < packet.size()) ? (uint8_t) packet[pos++] : -1; }
+    int available() override                                  { return packet.size() - pos; }
+    void flush() override                                     { pos = packet.size(); }
+
+    IPAddress remoteIP()                                      { return IPAddress(192, 168, 2, 100); }
+    uint16_t remotePort()                                     { return 5353; }
+
+    int beginPacket(IPAddress, uint16_t)                      { reply.clear(); return 1; }
+    int beginPacket(const char*, uint16_t)                    { reply.clear(); return 1; }
+    int endPacket()                                           { sent.push_back(reply); return 1; }
+
+    size_t write(uint8_t c) override                          { reply.push_back(c); return 1; }
+    size_t write(const uint8_t* buf, size_t size) override    { reply.append((const char*) buf, size); return size; }
+
+    using Print::write;
+
+    std::deque<std::string>   received;
+    std::vector<std::string>  sent;
+
+  private:
+
+    std::string   packet;
+    std::string   reply;
+    size_t        pos = 0;
+};
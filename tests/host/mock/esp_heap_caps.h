@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdlib>
+
+#include "host_heap.h"
+
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_DEFAULT      (1 << 12)
+
+// PSRAM is reported when the PSRAM environment variable is set. Both regions are the host heap
+inline bool psramFound()
+{
+  return getenv("PSRAM") != NULL;
+}
+
+inline void* heap_caps_malloc(size_t size, uint32_t)              { return em_hostMalloc(size); }
+inline void* heap_caps_realloc(void* ptr, size_t size, uint32_t)  { return em_hostRealloc(ptr, size); }
+inline void  heap_caps_free(void* ptr)                            { em_hostFree(ptr); }
+
+inline size_t heap_caps_get_free_size(uint32_t)                   { return 200000; }
+inline size_t heap_caps_get_minimum_free_size(uint32_t)           { return 150000; }
+inline size_t heap_caps_get_largest_free_block(uint32_t)          { return 110000; }
@@ -0,0 +1,42 @@
+// No tasks on the host: task creation succeeds, and the task body is never run
+
+#pragma once
+
+#include <cstdint>
+
+typedef void*     TaskHandle_t;
+typedef unsigned  UBaseType_t;
+typedef int       BaseType_t;
+typedef uint32_t  TickType_t;
+
+#define portTICK_PERIOD_MS      1
+#define pdPASS                  1
+#define pdMS_TO_TICKS(ms)       (ms)
+#define tskNO_AFFINITY          0x7FFFFFFF
+
+inline void vTaskDelay(TickType_t) {}
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline BaseType_t xTaskCreate(void (*)(void*), const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle)
+{
+  if (handle)
+    *handle = (TaskHandle_t) 1;
+
+  return pdPASS;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*task)(void*), const char* name, uint32_t stack, void* param,
+                                          UBaseType_t priority, TaskHandle_t* handle, int)
+{
+  return xTaskCreate(task, name, stack, param, priority, handle);
+}
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+  return (TaskHandle_t) 1;
+}
+
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+  return 1234;
+}
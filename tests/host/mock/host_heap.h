@@ -0,0 +1,24 @@
+// Heap accounting of the host build: every operator new and heap_caps_* block goes through here
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct EM_HostHeap
+{
+  uint64_t  allocs;       // Blocks allocated since start
+  size_t    current;      // Live bytes
+  size_t    peak;         // Highest live bytes since the last resetPeak()
+};
+
+extern EM_HostHeap em_hostHeap;
+
+void* em_hostMalloc(size_t size);
+void* em_hostRealloc(void* ptr, size_t size);
+void  em_hostFree(void* ptr);
+
+inline void em_hostResetPeak()
+{
+  em_hostHeap.peak = em_hostHeap.current;
+}
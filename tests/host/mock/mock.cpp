@@ -0,0 +1,108 @@
+// Globals of the host stand-ins, and the counted heap behind operator new and heap_caps_*
+
+#include <new>
+
+#include <Arduino.h>
+#include <WebServer_ESP32_W5500.h>
+
+HardwareSerial  Serial;
+EspClass        ESP;
+ETHClass        ETH;
+
+EM_HostHeap     em_hostHeap;
+
+////////////////////////////////////////////////////
+
+// Size kept in front of each block, 16 bytes to preserve the alignment
+static const size_t EM_HOST_HEADER = 16;
+
+void* em_hostMalloc(size_t size)
+{
+  char* block = (char*) malloc(size + EM_HOST_HEADER);
+
+  if (block == NULL)
+    return NULL;
+
+  *(size_t*) block = size;
+
+  em_hostHeap.allocs++;
+  em_hostHeap.current += size;
+
+  if (em_hostHeap.current > em_hostHeap.peak)
+    em_hostHeap.peak = em_hostHeap.current;
+
+  return block + EM_HOST_HEADER;
+}
+
+void em_hostFree(void* ptr)
+{
+  if (ptr == NULL)
+    return;
+
+  char* block = (char*) ptr - EM_HOST_HEADER;
+
+  em_hostHeap.current -= *(size_t*) block;
+
+  free(block);
+}
+
+void* em_hostRealloc(void* ptr, size_t size)
+{
+  if (ptr == NULL)
+    return em_hostMalloc(size);
+
+  if (size == 0)
+  {
+    em_hostFree(ptr);
+
+    return NULL;
+  }
+
+  void*   block   = em_hostMalloc(size);
+  size_t  oldSize = *(size_t*) ((char*) ptr - EM_HOST_HEADER);
+
+  if (block)
+  {
+    memcpy(block, ptr, (oldSize < size) ? oldSize : size);
+    em_hostFree(ptr);
+  }
+
+  return block;
+}
+
+////////////////////////////////////////////////////
+
+void* operator new(size_t size)
+{
+  void* ptr = em_hostMalloc(size);
+
+  if (ptr == NULL)
+    throw std::bad_alloc();
+
+  return ptr;
+}
+
+void* operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  em_hostFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  em_hostFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  em_hostFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  em_hostFree(ptr);
+}
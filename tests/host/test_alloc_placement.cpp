@@ -0,0 +1,36 @@
+// Allocation classes with PSRAM: the objects used on each portal loop iteration stay in internal RAM
+
+#include <ESP32_W5500_Manager.h>
+
+#include "em_test.h"
+
+int main()
+{
+  // Read by the psramFound() stand-in
+  setenv("PSRAM", "1", 1);
+
+  ESP32_W5500_Manager manager("Placement");
+  ESP32_EMParameter   param("param", "Placeholder", "value", 64);
+
+  manager.addParameter(&param);
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  ESP32_EMAlloc& alloc = ESP32_EMAlloc::instance();
+
+  // WebServer and DNS server objects, parameter index
+  EM_CHECK(alloc.getUsage(EM_ALLOC_HOT).internalBlocks >= 3);
+  EM_CHECK(alloc.getUsage(EM_ALLOC_HOT).psramBlocks == 0);
+  EM_CHECK(alloc.getUsage(EM_ALLOC_COLD).internalBlocks + alloc.getUsage(EM_ALLOC_COLD).psramBlocks == 0);
+
+  // Parameter table
+  EM_CHECK(alloc.getUsage(EM_ALLOC_BULK).psramBlocks > 0);
+
+  WebServer::instance()->request("/close");
+  manager.process();
+
+  alloc.printReport(Serial);
+
+  return em_testResult();
+}
@@ -0,0 +1,361 @@
+// ESP32_EMCaptiveDNS_Generic over a loopback UDP socket: the answers to A, ANY and AAAA queries, the queries
+// dropped, the burst cap, then the Config Portal polling it
+
+#include <ESP32_W5500_Manager.h>
+
+#include <lwip/sockets.h>
+
+#include <vector>
+
+#include "em_test.h"
+
+#define EM_TEST_DNS_PORT      15353
+
+////////////////////////////////////////////////////
+
+// WiFiUDP API over a POSIX socket bound to the loopback address
+class EM_LocalUDP
+{
+  public:
+
+    ~EM_LocalUDP()
+    {
+      stop();
+    }
+
+    uint8_t begin(const uint16_t& port)
+    {
+      _fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+      struct sockaddr_in addr = loopback(port);
+
+      if ( (_fd < 0) || (::bind(_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0) )
+      {
+        stop();
+
+        return 0;
+      }
+
+      return 1;
+    }
+
+    void stop()
+    {
+      if (_fd >= 0)
+        ::close(_fd);
+
+      _fd = -1;
+    }
+
+    // Size of the next datagram, even if larger than the buffer, as lwIP gives it
+    int parsePacket()
+    {
+      socklen_t addrLen = sizeof(_remote);
+
+      int len = ::recvfrom(_fd, _packet, sizeof(_packet), MSG_DONTWAIT | MSG_TRUNC, (struct sockaddr *) &_remote, &addrLen);
+
+      _size = (len > 0) ? std::min((size_t) len, sizeof(_packet)) : 0;
+      _pos  = 0;
+
+      return (len > 0) ? len : 0;
+    }
+
+    int read(uint8_t* buf, const size_t& size)
+    {
+      size_t len = std::min(size, _size - _pos);
+
+      memcpy(buf, _packet + _pos, len);
+      _pos += len;
+
+      return len;
+    }
+
+    void flush()
+    {
+      _pos = _size;
+    }
+
+    IPAddress remoteIP()
+    {
+      return IPAddress(_remote.sin_addr.s_addr);
+    }
+
+    uint16_t remotePort()
+    {
+      return ntohs(_remote.sin_port);
+    }
+
+    int beginPacket(const IPAddress& ip, const uint16_t& port)
+    {
+      (void) ip;
+
+      _replyPort = port;
+      _reply.clear();
+
+      return 1;
+    }
+
+    size_t write(const uint8_t* buf, const size_t& size)
+    {
+      _reply.append((const char*) buf, size);
+
+      return size;
+    }
+
+    int endPacket()
+    {
+      struct sockaddr_in addr = loopback(_replyPort);
+
+      return (::sendto(_fd, _reply.data(), _reply.size(), 0, (struct sockaddr *) &addr, sizeof(addr)) > 0);
+    }
+
+    static struct sockaddr_in loopback(const uint16_t& port)
+    {
+      struct sockaddr_in addr;
+
+      memset(&addr, 0, sizeof(addr));
+
+      addr.sin_family       = AF_INET;
+      addr.sin_port         = htons(port);
+      addr.sin_addr.s_addr  = htonl(INADDR_LOOPBACK);
+
+      return addr;
+    }
+
+  private:
+
+    int                 _fd = -1;
+    struct sockaddr_in  _remote;
+
+    uint8_t             _packet[2048];
+    size_t              _size = 0;
+    size_t              _pos  = 0;
+
+    std::string         _reply;
+    uint16_t            _replyPort = 0;
+};
+
+typedef ESP32_EMCaptiveDNS_Generic<EM_LocalUDP>   EM_TestDNS;
+
+////////////////////////////////////////////////////
+// Client side
+
+static int _client = -1;
+
+static std::string query(const uint16_t& id, const uint16_t& qtype, const char* name = "connectivitycheck.gstatic.com")
+{
+  // RD, one question
+  std::string packet = { (char) (id >> 8), (char) id, 0x01, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+
+  for (const char* label = name; *label; )
+  {
+    const char* dot = strchr(label, '.');
+    size_t      len = dot ? (size_t) (dot - label) : strlen(label);
+
+    packet += (char) len;
+    packet.append(label, len);
+
+    label += len + (dot ? 1 : 0);
+  }
+
+  packet += std::string { 0, (char) (qtype >> 8), (char) qtype, 0, 1 };
+
+  return packet;
+}
+
+static void sendQuery(const std::string& packet)
+{
+  struct sockaddr_in addr = EM_LocalUDP::loopback(EM_TEST_DNS_PORT);
+
+  ::sendto(_client, packet.data(), packet.size(), 0, (struct sockaddr *) &addr, sizeof(addr));
+}
+
+// Every reply received, in order
+static std::vector<std::string> replies()
+{
+  std::vector<std::string> result;
+  char                     buffer[2048];
+  int                      len;
+
+  while ( (len = ::recv(_client, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0 )
+    result.push_back(std::string(buffer, len));
+
+  return result;
+}
+
+static uint16_t get16(const std::string& packet, const size_t& pos)
+{
+  return ((uint8_t) packet[pos] << 8) | (uint8_t) packet[pos + 1];
+}
+
+////////////////////////////////////////////////////
+
+static void testAnswers(EM_TestDNS& dns)
+{
+  static const uint8_t answer[EM_DNS_ANSWER_SIZE] =
+  { 0xC0, 0x0C, 0, EM_DNS_TYPE_A, 0, 1, 0, 0, 0, EM_DNS_TTL, 0, 4, 192, 168, 4, 1 };
+
+  std::string a     = query(0x1234, EM_DNS_TYPE_A);
+  std::string any   = query(0x1235, EM_DNS_TYPE_ANY);
+  std::string aaaa  = query(0x1236, 28);
+
+  // With an EDNS OPT record, left out of the reply
+  std::string edns  = query(0x1237, EM_DNS_TYPE_A);
+
+  edns[11] = 1;
+  edns += std::string { 0, 0, 41, 0x10, 0, 0, 0, 0, 0, 0, 0 };
+
+  const std::string queries[] = { a, any, aaaa, edns };
+
+  for (const std::string& packet : queries)
+    sendQuery(packet);
+
+  dns.processNextRequest();
+
+  std::vector<std::string> sent = replies();
+
+  EM_CHECK(sent.size() == 4);
+
+  if (sent.size() != 4)
+    return;
+
+  // A and ANY: the question, then the answer pointing back to its name
+  for (int i : { 0, 1, 3 })
+  {
+    const std::string& reply = sent[i];
+
+    EM_CHECK(reply.size() == a.size() + EM_DNS_ANSWER_SIZE);
+    EM_CHECK(get16(reply, 0) == 0x1234 + i);
+    EM_CHECK(get16(reply, 2) == 0x8580);
+    EM_CHECK( (get16(reply, 4) == 1) && (get16(reply, 6) == 1) && (get16(reply, 8) == 0) && (get16(reply, 10) == 0) );
+    EM_CHECK(reply.compare(EM_DNS_HEADER_SIZE, a.size() - EM_DNS_HEADER_SIZE, queries[i], EM_DNS_HEADER_SIZE, a.size() - EM_DNS_HEADER_SIZE) == 0);
+    EM_CHECK(memcmp(reply.data() + a.size(), answer, EM_DNS_ANSWER_SIZE) == 0);
+  }
+
+  // AAAA: NOERROR with no answer, so that the client asks for A
+  EM_CHECK(sent[2].size() == aaaa.size());
+  EM_CHECK(get16(sent[2], 0) == 0x1236);
+  EM_CHECK( (get16(sent[2], 2) == 0x8580) && (get16(sent[2], 6) == 0) );
+}
+
+static void testDropped(EM_TestDNS& dns)
+{
+  EM_DNSStats before;
+  EM_DNSStats after;
+
+  dns.getStats(before);
+
+  std::string response    = query(1, EM_DNS_TYPE_A);
+  std::string opcode      = query(2, EM_DNS_TYPE_A);
+  std::string questions   = query(3, EM_DNS_TYPE_A);
+  std::string compressed  = query(4, EM_DNS_TYPE_A);
+  std::string truncated   = query(5, EM_DNS_TYPE_A);
+
+  response[2]   |= 0x80;
+  opcode[2]     |= 0x10;
+  questions[5]   = 2;
+  compressed[EM_DNS_HEADER_SIZE] = (char) 0xC0;
+  truncated.resize(truncated.size() - 3);
+
+  for (const std::string& packet : { response, opcode, questions, compressed, truncated, std::string(EM_DNS_HEADER_SIZE, 0),
+                                     query(6, EM_DNS_TYPE_A) + std::string(EM_DNS_MAX_PACKET_SIZE, 0) })
+  {
+    sendQuery(packet);
+  }
+
+  dns.processNextRequest();
+  dns.getStats(after);
+
+  EM_CHECK(replies().empty());
+  EM_CHECK(after.answered == before.answered);
+  EM_CHECK(after.dropped == before.dropped + 7);
+  EM_CHECK(after.lastBurst == 7);
+}
+
+static void testBurst(EM_TestDNS& dns)
+{
+  EM_DNSStats stats;
+
+  // Counted from start()
+  EM_CHECK(dns.start(EM_TEST_DNS_PORT, "*", IPAddress(192, 168, 4, 1)));
+
+  // A phone joining: A and AAAA queries, and a malformed one, answered in one call
+  for (int i = 0; i < 25; i++)
+    sendQuery(query(i, (i % 2) ? 28 : EM_DNS_TYPE_A));
+
+  sendQuery("x");
+
+  dns.processNextRequest();
+  dns.getStats(stats);
+
+  EM_CHECK(replies().size() == 25);
+  EM_CHECK( (stats.answered == 25) && (stats.dropped == 1) );
+  EM_CHECK( (stats.lastBurst == 26) && (stats.maxBurst == 26) && (stats.capped == 0) );
+
+  // More than EM_DNS_MAX_BURST: the rest is left for the next call
+  for (int i = 0; i < EM_DNS_MAX_BURST + 8; i++)
+    sendQuery(query(i, EM_DNS_TYPE_A));
+
+  dns.processNextRequest();
+  dns.getStats(stats);
+
+  EM_CHECK(replies().size() == EM_DNS_MAX_BURST);
+  EM_CHECK( (stats.lastBurst == EM_DNS_MAX_BURST) && (stats.maxBurst == EM_DNS_MAX_BURST) && (stats.capped == 1) );
+
+  dns.processNextRequest();
+  dns.getStats(stats);
+
+  EM_CHECK(replies().size() == 8);
+  EM_CHECK( (stats.answered == 25 + EM_DNS_MAX_BURST + 8) && (stats.lastBurst == 8) && (stats.capped == 1) );
+
+  // Nothing pending
+  dns.processNextRequest();
+  dns.getStats(stats);
+
+  EM_CHECK( (stats.lastBurst == 0) && (stats.maxBurst == EM_DNS_MAX_BURST) );
+}
+
+////////////////////////////////////////////////////
+
+// Polled by each Config Portal iteration, its counters reported by getDNSStats()
+static void testConfigPortal()
+{
+  ESP32_W5500_Manager manager("DNS");
+  EM_DNSStats         stats;
+
+  EM_CHECK(!manager.getDNSStats(stats));
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  EM_CHECK(manager.getDNSStats(stats));
+  EM_CHECK( (stats.answered == 0) && (stats.dropped == 0) );
+
+  WebServer::instance()->request("/close");
+  manager.process();
+}
+
+////////////////////////////////////////////////////
+
+int main()
+{
+  EM_TestDNS dns;
+
+  EM_CHECK(dns.start(EM_TEST_DNS_PORT, "*", IPAddress(192, 168, 4, 1)));
+
+  _client = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+  testAnswers(dns);
+  testDropped(dns);
+
+  dns.stop();
+
+  testBurst(dns);
+
+  dns.stop();
+  ::close(_client);
+
+  testConfigPortal();
+
+  return em_testResult();
+}
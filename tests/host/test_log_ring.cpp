@@ -0,0 +1,277 @@
+// ESP32_EMLog ring of ESP32_ETH_MGR_ASYNC_LOG: records drained in order, from one and from several tasks,
+// overflow counted and reported when full, timestamp prefixes of ESP32_EMPrintLogSink, truncated records
+
+#include <ESP32_W5500_Manager.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "em_test.h"
+
+////////////////////////////////////////////////////
+
+// Keeps each record as written
+class EM_CaptureSink : public ESP32_EMLogSink
+{
+  public:
+
+    void write(const uint32_t& timestamp, const char* text, const size_t& len) override
+    {
+      (void) timestamp;
+
+      records.push_back(std::string(text, len));
+    }
+
+    std::vector<std::string> records;
+};
+
+class EM_StringPrint : public Print
+{
+  public:
+
+    size_t write(uint8_t c) override
+    {
+      text += (char) c;
+
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override
+    {
+      text.append((const char*) buffer, size);
+
+      return size;
+    }
+
+    using Print::write;
+
+    std::string text;
+};
+
+// As by the LOG* macros
+static void logLine(const char* text, const int& value)
+{
+  ESP32_EMLogLine line;
+
+  line.print(ESP_EM_MARK);
+  line.print(text);
+  line.print(ESP_EM_SP);
+  line.println(value);
+}
+
+// Lines of text, each checked to start with a millis() timestamp, which is removed
+static std::vector<std::string> stripTimestamps(const std::string& text)
+{
+  std::vector<std::string> lines;
+
+  for (size_t pos = 0; pos < text.size(); )
+  {
+    size_t end    = text.find('\n', pos);
+    size_t digits = pos;
+
+    while ( (digits < end) && isdigit(text[digits]) )
+      digits++;
+
+    EM_CHECK( (digits > pos) && (text[digits] == ' ') );
+
+    lines.push_back(text.substr(digits + 1, end - digits - 1));
+    pos = end + 1;
+  }
+
+  return lines;
+}
+
+////////////////////////////////////////////////////
+
+static void testOrder(ESP32_EMLog& log, EM_CaptureSink& sink)
+{
+  for (int i = 0; i < EM_LOG_SLOTS / 2; i++)
+    logLine("record", i);
+
+  log.drain();
+
+  EM_CHECK(sink.records.size() == EM_LOG_SLOTS / 2);
+
+  for (size_t i = 0; i < sink.records.size(); i++)
+    EM_CHECK(sink.records[i] == "[EM] record " + std::to_string(i) + "\r\n");
+
+  // Nothing left, the ring wraps around
+  sink.records.clear();
+  log.drain();
+
+  EM_CHECK(sink.records.empty());
+}
+
+// 4 tasks logging at once, drained as they go: each task's records in its order, all of them either
+// written or counted as dropped
+static void testProducers(ESP32_EMLog& log, EM_CaptureSink& sink)
+{
+  const int tasks     = 4;
+  const int perTask   = 2000;
+
+  std::atomic<int>          running(tasks);
+  std::vector<std::thread>  threads;
+
+  sink.records.clear();
+
+  uint32_t overflows = log.getOverflowCount();
+
+  for (int task = 0; task < tasks; task++)
+  {
+    threads.emplace_back([&, task]()
+    {
+      for (int i = 0; i < perTask; i++)
+      {
+        logLine(("task" + std::to_string(task)).c_str(), i);
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+      }
+
+      running--;
+    });
+  }
+
+  while (running > 0)
+    log.drain();
+
+  for (auto& thread : threads)
+    thread.join();
+
+  log.drain();
+
+  uint32_t  dropped = log.getOverflowCount() - overflows;
+  int       last[tasks];
+  size_t    written = 0;
+
+  for (int task = 0; task < tasks; task++)
+    last[task] = -1;
+
+  for (const std::string& record : sink.records)
+  {
+    int task;
+    int i;
+
+    if (sscanf(record.c_str(), "[EM] task%d %d", &task, &i) != 2)
+      continue;
+
+    EM_CHECK(i > last[task]);
+
+    last[task] = i;
+    written++;
+  }
+
+  printf("%d records from %d tasks: %zu written, %u dropped\n", tasks * perTask, tasks, written, dropped);
+
+  EM_CHECK(written + dropped == tasks * perTask);
+  EM_CHECK(written > EM_LOG_SLOTS);
+}
+
+static void testOverflow(ESP32_EMLog& log, EM_CaptureSink& sink)
+{
+  sink.records.clear();
+
+  uint32_t overflows = log.getOverflowCount();
+
+  for (int i = 0; i < EM_LOG_SLOTS + 5; i++)
+    EM_CHECK(log.push("x\n", 2) == (i < EM_LOG_SLOTS));
+
+  EM_CHECK(log.getOverflowCount() == overflows + 5);
+
+  // The ring, then the count of records dropped since the last report
+  log.drain();
+
+  EM_CHECK(sink.records.size() == EM_LOG_SLOTS + 1);
+  EM_CHECK(sink.records.back() == "[EM] Log ring full, 5 records dropped\n");
+
+  // Reported once, and the ring takes records again
+  sink.records.clear();
+
+  EM_CHECK(log.push("y\n", 2));
+
+  log.drain();
+
+  EM_CHECK( (sink.records.size() == 1) && (sink.records[0] == "y\n") );
+}
+
+static void testTimestamps(ESP32_EMLog& log)
+{
+  EM_StringPrint        out;
+  ESP32_EMPrintLogSink  sink(out);
+
+  log.setSink(&sink);
+
+  logLine("one", 1);
+
+  // LOGxxx0 then LOGxxx: one line in 2 records, prefixed once
+  {
+    ESP32_EMLogLine line;
+
+    line.print(ESP_EM_MARK);
+    line.print("two");
+  }
+
+  logLine(",", 2);
+
+  log.drain();
+
+  std::vector<std::string> lines = stripTimestamps(out.text);
+
+  EM_CHECK(lines.size() == 2);
+  EM_CHECK( (lines.size() == 2) && (lines[0] == "[EM] one 1\r") && (lines[1] == "[EM] two[EM] , 2\r") );
+}
+
+// A record over EM_LOG_SLOT_SIZE is cut, still ending its line: the next one is on its own, with its timestamp
+static void testTruncated(ESP32_EMLog& log, EM_CaptureSink& capture)
+{
+  std::string longValue(3 * EM_LOG_SLOT_SIZE, 'v');
+
+  capture.records.clear();
+  log.setSink(&capture);
+
+  {
+    ESP32_EMLogLine line;
+
+    line.print(ESP_EM_MARK);
+    line.print("uri = ");
+    line.println(longValue.c_str());
+  }
+
+  logLine("next", 3);
+
+  log.drain();
+
+  EM_CHECK(capture.records.size() == 2);
+  EM_CHECK(capture.records[0].size() == EM_LOG_SLOT_SIZE);
+  EM_CHECK(capture.records[0].compare(0, 11, "[EM] uri = ") == 0);
+  EM_CHECK(capture.records[0].compare(EM_LOG_SLOT_SIZE - 3, 3, "v\r\n") == 0);
+
+  // The same through ESP32_EMPrintLogSink
+  EM_StringPrint        out;
+  ESP32_EMPrintLogSink  sink(out);
+
+  for (const std::string& record : capture.records)
+    sink.write(millis(), record.data(), record.size());
+
+  std::vector<std::string> lines = stripTimestamps(out.text);
+
+  EM_CHECK( (lines.size() == 2) && (lines[1] == "[EM] next 3\r") );
+}
+
+////////////////////////////////////////////////////
+
+int main()
+{
+  ESP32_EMLog&    log = ESP32_EMLog::instance();
+  EM_CaptureSink  sink;
+
+  // The drain task doesn't run on the host, the ring is drained here
+  EM_CHECK(log.begin(&sink));
+
+  testOrder(log, sink);
+  testProducers(log, sink);
+  testOverflow(log, sink);
+  testTimestamps(log);
+  testTruncated(log, sink);
+
+  return em_testResult();
+}
@@ -0,0 +1,432 @@
+// ESP32_EMMultiServer over loopback: 1, 4 and 8 concurrent keep-alive clients next to a stalled one,
+// pipelining, oversized requests, the timeout, then the Config Portal served by it
+//
+//   test_multi_server [requests per client]
+//
+// The server under test listens on HTTP_PORT + 1, the Config Portal on HTTP_PORT
+
+#include <ESP32_W5500_Manager.h>
+
+#include <signal.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "em_test.h"
+
+#define EM_TEST_PORT      (HTTP_PORT + 1)
+
+////////////////////////////////////////////////////
+// Client side
+
+static int connectTo(const int& port)
+{
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+  struct sockaddr_in addr;
+
+  memset(&addr, 0, sizeof(addr));
+
+  addr.sin_family       = AF_INET;
+  addr.sin_port         = htons(port);
+  addr.sin_addr.s_addr  = htonl(INADDR_LOOPBACK);
+
+  // A response never sent fails the test rather than hanging it
+  struct timeval timeout = { 10, 0 };
+
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  if (::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+  {
+    ::close(fd);
+
+    return -1;
+  }
+
+  return fd;
+}
+
+static void sendAll(const int& fd, const std::string& data)
+{
+  ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+}
+
+static bool fill(const int& fd, std::string& pending)
+{
+  char buffer[4096];
+  int  len = ::recv(fd, buffer, sizeof(buffer), 0);
+
+  if (len <= 0)
+    return false;
+
+  pending.append(buffer, len);
+
+  return true;
+}
+
+// Status code of the next response, or -1 if the connection is closed first. Its headers go to head, its
+// body, with the chunks joined, to body
+static int readResponse(const int& fd, std::string& pending, std::string* head = NULL, std::string* body = NULL)
+{
+  size_t headEnd;
+
+  while ( (headEnd = pending.find("\r\n\r\n")) == std::string::npos )
+  {
+    if (!fill(fd, pending))
+      return -1;
+  }
+
+  std::string headers = pending.substr(0, headEnd + 4);
+  std::string content;
+
+  pending.erase(0, headEnd + 4);
+
+  size_t lengthPos = headers.find("Content-Length: ");
+
+  if (lengthPos != std::string::npos)
+  {
+    size_t len = strtoul(headers.c_str() + lengthPos + 16, NULL, 10);
+
+    while (pending.size() < len)
+    {
+      if (!fill(fd, pending))
+        return -1;
+    }
+
+    content = pending.substr(0, len);
+    pending.erase(0, len);
+  }
+  else if (headers.find("Transfer-Encoding: chunked") != std::string::npos)
+  {
+    while (true)
+    {
+      size_t lineEnd;
+
+      while ( (lineEnd = pending.find("\r\n")) == std::string::npos )
+      {
+        if (!fill(fd, pending))
+          return -1;
+      }
+
+      size_t size = strtoul(pending.c_str(), NULL, 16);
+
+      while (pending.size() < lineEnd + 2 + size + 2)
+      {
+        if (!fill(fd, pending))
+          return -1;
+      }
+
+      content.append(pending, lineEnd + 2, size);
+      pending.erase(0, lineEnd + 2 + size + 2);
+
+      if (size == 0)
+        break;
+    }
+  }
+  else
+  {
+    // Ends with the connection
+    while (fill(fd, pending));
+
+    content.swap(pending);
+  }
+
+  if (head)
+    *head = headers;
+
+  if (body)
+    *body = content;
+
+  return atoi(headers.c_str() + 9);
+}
+
+// Closed by the server, with nothing more sent
+static bool isClosed(const int& fd)
+{
+  char c;
+
+  return (::recv(fd, &c, 1, 0) == 0);
+}
+
+////////////////////////////////////////////////////
+// Server side
+
+static std::atomic<bool> serving(false);
+
+// A page streamed in chunks, as by ESP32_EMPageWriter
+static void handlePage(ESP32_EMMultiServer& server)
+{
+  static const std::string line(100, 'x');
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/html", "");
+
+  for (int i = 0; i < 40; i++)
+    server.sendContent(line.c_str(), line.size());
+}
+
+static void serve(ESP32_EMMultiServer& server)
+{
+  while (serving)
+  {
+    server.handleClient();
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+////////////////////////////////////////////////////
+
+typedef struct
+{
+  int     ok;
+  int     reconnects;       // Idle keep-alive connection closed for another client, request sent again
+  int     closedUnserved;   // Connection closed before its first response
+  double  worstMs;
+} EM_ClientResult;
+
+// requests keep-alive GET /page, reconnecting when the server closes the connection between requests, as
+// HTTP clients do
+static void keepAliveClient(const int& requests, EM_ClientResult& result)
+{
+  static const std::string request = "GET /page HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+
+  int         fd      = -1;
+  int         served  = 0;
+  std::string pending;
+
+  for (int i = 0; (i < requests) && (result.closedUnserved < 10); )
+  {
+    if (fd < 0)
+    {
+      fd      = connectTo(EM_TEST_PORT);
+      served  = 0;
+
+      pending.clear();
+    }
+
+    auto        start = std::chrono::steady_clock::now();
+    std::string body;
+
+    sendAll(fd, request);
+
+    int code = readResponse(fd, pending, NULL, &body);
+
+    if (code < 0)
+    {
+      if (served == 0)
+        result.closedUnserved++;
+      else
+        result.reconnects++;
+
+      ::close(fd);
+      fd = -1;
+
+      continue;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if ( (code == 200) && (body.size() == 4000) )
+      result.ok++;
+
+    if (ms > result.worstMs)
+      result.worstMs = ms;
+
+    served++;
+    i++;
+  }
+
+  if (fd >= 0)
+    ::close(fd);
+}
+
+static void testConcurrentClients(const int& clients, const int& requests)
+{
+  std::vector<EM_ClientResult>  results(clients, EM_ClientResult { 0, 0, 0, 0 });
+  std::vector<std::thread>      threads;
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < clients; i++)
+    threads.emplace_back(keepAliveClient, requests, std::ref(results[i]));
+
+  for (auto& thread : threads)
+    thread.join();
+
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  EM_ClientResult total = { 0, 0, 0, 0 };
+
+  for (const EM_ClientResult& result : results)
+  {
+    total.ok              += result.ok;
+    total.reconnects      += result.reconnects;
+    total.closedUnserved  += result.closedUnserved;
+    total.worstMs          = std::max(total.worstMs, result.worstMs);
+  }
+
+  printf("%d clients (+1 stalled): %d/%d served, %.0f req/s, worst %.2f ms, %d reconnects, %d closed unserved\n",
+         clients, total.ok, clients * requests, total.ok * 1000 / ms, total.worstMs, total.reconnects, total.closedUnserved);
+
+  EM_CHECK(total.ok == clients * requests);
+  EM_CHECK(total.closedUnserved == 0);
+}
+
+////////////////////////////////////////////////////
+
+static void testServer(const int& requests)
+{
+  ESP32_EMMultiServer server(EM_TEST_PORT);
+
+  server.on("/page", [&server]() { handlePage(server); });
+  server.on("/echo", [&server]() { server.send(200, "text/plain", server.arg("a")); });
+
+  server.begin();
+
+  serving = true;
+
+  std::thread serverThread(serve, std::ref(server));
+
+  // Half a request, holding a connection until the timeout
+  int stalled = connectTo(EM_TEST_PORT);
+
+  sendAll(stalled, "GET /page HTTP/1.1\r\nHost: 127.0.0.1\r\n");
+
+  for (int clients : { 1, 4, 8 })
+    testConcurrentClients(clients, requests);
+
+  std::string pending;
+  std::string head;
+  std::string body;
+
+  // Pipelined, answered in order on the same connection
+  int fd = connectTo(EM_TEST_PORT);
+
+  sendAll(fd, "GET /echo?a=1 HTTP/1.1\r\n\r\nPOST /echo HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+          "Content-Length: 3\r\n\r\na=2GET /nope HTTP/1.1\r\n\r\n");
+
+  EM_CHECK( (readResponse(fd, pending, NULL, &body) == 200) && (body == "1") );
+  EM_CHECK( (readResponse(fd, pending, NULL, &body) == 200) && (body == "2") );
+  EM_CHECK(readResponse(fd, pending) == 404);
+
+  ::close(fd);
+
+  // A body which can't fit is refused as soon as the headers are in, including lengths which would wrap around
+  for (const char* length : { "4096", "18446744073709551615", "-1" })
+  {
+    fd = connectTo(EM_TEST_PORT);
+    pending.clear();
+
+    sendAll(fd, std::string("POST /echo HTTP/1.1\r\nContent-Length: ") + length + "\r\n\r\na=3");
+
+    EM_CHECK(readResponse(fd, pending, &head) == 413);
+    EM_CHECK(head.find("Connection: close") != std::string::npos);
+    EM_CHECK(isClosed(fd));
+
+    ::close(fd);
+  }
+
+  // Headers filling the request buffer
+  fd = connectTo(EM_TEST_PORT);
+  pending.clear();
+
+  sendAll(fd, "GET /echo?a=" + std::string(EM_MULTI_SERVER_REQUEST_SIZE, 'a') + " HTTP/1.1\r\n\r\n");
+
+  EM_CHECK(readResponse(fd, pending) == 413);
+
+  ::close(fd);
+
+  // Long closed by the timeout
+  EM_CHECK(isClosed(stalled));
+
+  ::close(stalled);
+
+  serving = false;
+  serverThread.join();
+
+  EM_CHECK(server.getConnectionCount() == 0);
+}
+
+////////////////////////////////////////////////////
+
+static void testConfigPortal()
+{
+  ESP32_W5500_Manager manager("Multi");
+  ESP32_EMParameter   param("param0", "Placeholder", "", 32);
+
+  manager.addParameter(&param);
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  std::atomic<bool> closed(false);
+
+  std::thread portalThread([&]()
+  {
+    while (!manager.process())
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+    closed = true;
+  });
+
+  std::string pending;
+  std::string head;
+  std::string body;
+
+  // Captive portal probe
+  int fd = connectTo(HTTP_PORT);
+
+  sendAll(fd, "GET /generate_204 HTTP/1.1\r\nHost: connectivitycheck.gstatic.com\r\n\r\n");
+
+  EM_CHECK(readResponse(fd, pending, &head) == 302);
+  EM_CHECK(head.find("Location: http://127.0.0.1") != std::string::npos);
+
+  ::close(fd);
+
+  // Streamed page, then an HTTP/1.0 form post with the body in a second segment, on new connections
+  fd = connectTo(HTTP_PORT);
+  pending.clear();
+
+  sendAll(fd, "GET /eth HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+
+  EM_CHECK(readResponse(fd, pending, NULL, &body) == 200);
+  EM_CHECK(body.find("param0") != std::string::npos);
+
+  ::close(fd);
+
+  std::string form = "param0=hello+world%21&ip=192.168.2.50";
+
+  fd = connectTo(HTTP_PORT);
+  pending.clear();
+
+  sendAll(fd, "POST /ethsave HTTP/1.0\r\nHost: 127.0.0.1\r\nContent-Type: application/x-www-form-urlencoded\r\n"
+          "Content-Length: " + std::to_string(form.size()) + "\r\n\r\n");
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  sendAll(fd, form);
+
+  EM_CHECK(readResponse(fd, pending) == 200);
+
+  ::close(fd);
+
+  // The save closes the Config Portal
+  portalThread.join();
+
+  EM_CHECK(closed);
+  EM_CHECK(strcmp(param.getValue(), "hello world!") == 0);
+}
+
+////////////////////////////////////////////////////
+
+int main(int argc, char** argv)
+{
+  int requests = (argc > 1) ? atoi(argv[1]) : 200;
+
+  // Sends to a client which went away fail with EPIPE, as on lwIP
+  signal(SIGPIPE, SIG_IGN);
+
+  testServer(requests);
+  testConfigPortal();
+
+  return em_testResult();
+}
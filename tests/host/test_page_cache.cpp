@@ -0,0 +1,85 @@
+// ESP32_EMPageCache: capture, lookup by generation, empty and oversized bodies, then the cached pages served
+// by the Config Portal
+
+#include <ESP32_W5500_Manager.h>
+
+#include "em_test.h"
+
+////////////////////////////////////////////////////
+
+static void testCache()
+{
+  ESP32_EMPageCache cache;
+  const char*       body  = NULL;
+  size_t            len   = 0;
+
+  cache.beginCapture(EM_ROUTE_ROOT, 1);
+  cache.capture("Hello, ", 7);
+  cache.capture("world", 5);
+  cache.endCapture();
+
+  EM_CHECK(cache.lookup(EM_ROUTE_ROOT, 1, body, len));
+  EM_CHECK( (len == 12) && (memcmp(body, "Hello, world", len) == 0) );
+  EM_CHECK(cache.getStats().bytes == 12);
+
+  // Out of date
+  EM_CHECK(!cache.lookup(EM_ROUTE_ROOT, 2, body, len));
+
+  // Rendered again with an empty body: not cached, and the buffer kept from the previous render is freed
+  cache.beginCapture(EM_ROUTE_ROOT, 2);
+  cache.endCapture();
+
+  EM_CHECK(!cache.lookup(EM_ROUTE_ROOT, 2, body, len));
+  EM_CHECK(cache.getStats().bytes == 0);
+
+  // Over the budget
+  std::string large(cache.getStats().budget + 1, 'x');
+
+  cache.beginCapture(EM_ROUTE_ETH, 2);
+  cache.capture(large.data(), large.size());
+  cache.endCapture();
+
+  EM_CHECK(!cache.lookup(EM_ROUTE_ETH, 2, body, len));
+  EM_CHECK(cache.getStats().overflows == 1);
+  EM_CHECK(cache.getStats().bytes == 0);
+
+  cache.clear();
+}
+
+////////////////////////////////////////////////////
+
+static void testPortal()
+{
+  ESP32_W5500_Manager manager("Cache");
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  WebServer& server = *WebServer::instance();
+
+  EM_CHECK(server.request("/eth") == 200);
+
+  std::string rendered = server.responseBody();
+
+  EM_CHECK(server.request("/eth") == 200);
+  EM_CHECK(server.responseBody() == rendered);
+  EM_CHECK(manager.getPageCacheStats().hits == 1);
+
+  server.request("/close");
+  manager.process();
+}
+
+////////////////////////////////////////////////////
+
+int main()
+{
+  size_t heap = em_hostHeap.current;
+
+  testCache();
+
+  EM_CHECK(em_hostHeap.current == heap);
+
+  testPortal();
+
+  return em_testResult();
+}
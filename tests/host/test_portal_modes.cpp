@@ -0,0 +1,47 @@
+// Non-blocking Config Portal: start, second start, close through process(), scheduled restart
+
+#include <ESP32_W5500_Manager.h>
+
+#include "em_test.h"
+
+int main()
+{
+  ESP32_W5500_Manager manager("Modes");
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  WebServer* server = WebServer::instance();
+
+  EM_CHECK(server != NULL);
+  EM_CHECK(manager.isConfigPortalActive());
+
+  // A second start leaves the running servers alone
+  EM_CHECK(!manager.startConfigPortal());
+  EM_CHECK(WebServer::instance() == server);
+
+  EM_CHECK(!manager.process());
+  EM_CHECK(server->request("/") == 200);
+
+  // Checked once per process(), by the Config Portal iteration
+  manager.scheduleRestart(0);
+  manager.process();
+
+  EM_CHECK(ESP.restarts == 1);
+
+  // ESP.restart() returns on the host
+  manager.cancelRestart();
+
+  // Closed by /close, then checked by process() alone
+  server->request("/close");
+
+  EM_CHECK(manager.process());
+  EM_CHECK(!manager.isConfigPortalActive());
+
+  manager.scheduleRestart(0);
+  manager.process();
+
+  EM_CHECK(ESP.restarts == 2);
+
+  return em_testResult();
+}
@@ -0,0 +1,36 @@
+// Route metrics: status and body bytes recorded for streamed pages, flash pages and errors
+
+#include <ESP32_W5500_Manager.h>
+
+#include "em_test.h"
+
+int main()
+{
+  ESP32_W5500_Manager manager("Metrics");
+
+  manager.setConfigPortalBlocking(false);
+  manager.startConfigPortal();
+
+  ESP32_EMWebServer* server = static_cast<ESP32_EMWebServer*>(WebServer::instance());
+
+  // Streamed through ESP32_EMPageWriter, sent chunked
+  const char* pages[] = { "/", "/eth", "/i", "/state" };
+
+  for (const char* uri : pages)
+  {
+    EM_CHECK(server->request(uri) == 200);
+    EM_CHECK(server->getResponseCode() == 200);
+    EM_CHECK(server->getResponseLength() == server->responseBody().size());
+  }
+
+  EM_CHECK(manager.getRouteMetrics(EM_ROUTE_ROOT).count == 1);
+  EM_CHECK(manager.getRouteMetrics(EM_ROUTE_ROOT).errors == 0);
+  EM_CHECK(manager.getRouteMetrics(EM_ROUTE_ETH).bytes > 0);
+
+  // Served from flash with send_P()
+  EM_CHECK(server->request("/em.css") == 200);
+  EM_CHECK(server->getResponseCode() == 200);
+  EM_CHECK(server->getResponseLength() == server->responseBody().size());
+
+  return em_testResult();
+}
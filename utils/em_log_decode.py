@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+#
+# Decode the binary LOG* output of ESP32_ETH_MGR_BINARY_LOG (see src/ESP32_W5500_Manager_BinLog.h) back into text
+#
+# The string table is built from the sources: every LOGxxx() call site in the library src/ and in the extra
+# paths (sketch folders or files) gets the same ID as computed by the compiler, from its file name and line.
+# Bytes which are not a valid frame, e.g. the sketch's own Serial.print(), are passed through unchanged.
+#
+#   python3 utils/em_log_decode.py capture.bin path/to/sketch
+#   python3 utils/em_log_decode.py --port /dev/ttyUSB0 --baud 115200 path/to/sketch     (needs pyserial)
+#   python3 utils/em_log_decode.py --table path/to/sketch
+#
+# Decode with the same sources the firmware was built from, as any edit moves the line numbers.
+
+import argparse
+import re
+import struct
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+
+SYNC = 0xA5
+HEADER_SIZE = 5
+MARK = "[EM] "
+EXTENSIONS = (".h", ".hpp", ".c", ".cpp", ".ino")
+
+CALL = re.compile(r"\bLOG(ERROR|WARN|INFO|DEBUG)([0-3]?)\s*\(")
+STRING = re.compile(r'"((?:\\.|[^"\\])*)"')
+
+
+def log_id(path, line):
+  # Same as em_logId() in ESP32_W5500_Manager_BinLog.h
+  h = 2166136261
+
+  for c in path.name.encode():
+    h = ((h ^ c) * 16777619) & 0xFFFFFFFF
+
+  return ((h ^ line) * 16777619) & 0xFFFFFFFF
+
+
+def is_literal(arg):
+  # Same as em_isLogLiteral(), on the argument as stringized by the preprocessor
+  arg = " ".join(arg.split())
+
+  return arg.startswith('"') or arg.startswith('F("')
+
+
+def literal_text(arg):
+  text = "".join(STRING.findall(arg))
+
+  return text.encode("latin-1", "backslashreplace").decode("unicode_escape")
+
+
+def split_args(text, start):
+  # Top level arguments of the call whose '(' is at start, and the position after its ')'
+  args, depth, quote, current, i = [], 0, None, "", start + 1
+
+  while i < len(text):
+    c = text[i]
+
+    if quote:
+      current += c
+
+      if c == "\\":
+        current += text[i + 1]
+        i += 1
+      elif c == quote:
+        quote = None
+    elif c in "\"'":
+      quote = c
+      current += c
+    elif c in "([{":
+      depth += 1
+      current += c
+    elif c in ")]}" and depth > 0:
+      depth -= 1
+      current += c
+    elif c == ")":
+      args.append(current.strip())
+      return args, i + 1
+    elif c == "," and depth == 0:
+      args.append(current.strip())
+      current = ""
+    else:
+      current += c
+
+    i += 1
+
+  return None, len(text)
+
+
+def scan(paths):
+  table = {}
+
+  for path in paths:
+    files = [path] if path.is_file() else sorted(p for p in path.rglob("*") if p.suffix in EXTENSIONS)
+
+    for file in files:
+      text = file.read_text(errors="replace")
+
+      for match in CALL.finditer(text):
+        line_start = text.rfind("\n", 0, match.start()) + 1
+
+        if text[line_start:match.start()].lstrip().startswith("#define"):
+          continue
+
+        args, end = split_args(text, match.end() - 1)
+
+        if args is None:
+          continue
+
+        site = (match.group(2), [(literal_text(a) if is_literal(a) else None) for a in args], "%s:%d" %
+                (file.name, text.count("\n", 0, match.start()) + 1))
+
+        # __LINE__ of a call written over several lines depends on the compiler, so map them all
+        for line in range(text.count("\n", 0, match.start()) + 1, text.count("\n", 0, end) + 2):
+          id = log_id(file, line)
+
+          if id in table and table[id][2] != site[2]:
+            print("Warning: ID 0x%08X of %s also used by %s" % (id, site[2], table[id][2]), file=sys.stderr)
+
+          table.setdefault(id, site)
+
+  return table
+
+
+def read_varint(data, pos):
+  value, shift = 0, 0
+
+  while True:
+    if pos >= len(data):
+      return None, pos
+
+    b = data[pos]
+    pos += 1
+    value |= (b & 0x7F) << shift
+    shift += 7
+
+    if not b & 0x80:
+      return value, pos
+
+
+def read_value(data, pos):
+  # Text of one value and the position after it. None if data is incomplete, ValueError if not a value
+  if pos >= len(data):
+    return None, pos
+
+  tag, pos = chr(data[pos]), pos + 1
+
+  if tag in "ui":
+    value, pos = read_varint(data, pos)
+
+    if value is None:
+      return None, pos
+
+    if tag == "i":
+      value = (value >> 1) ^ -(value & 1)
+
+    return str(value), pos
+
+  if tag == "c":
+    return (chr(data[pos]), pos + 1) if pos < len(data) else (None, pos)
+
+  if tag == "f":
+    return ("%.2f" % struct.unpack_from("<f", data, pos)[0], pos + 4) if pos + 4 <= len(data) else (None, pos)
+
+  if tag == "a":
+    return (".".join(str(b) for b in data[pos:pos + 4]), pos + 4) if pos + 4 <= len(data) else (None, pos)
+
+  if tag == "s":
+    if pos >= len(data) or pos + 1 + data[pos] > len(data):
+      return None, pos
+
+    return data[pos + 1:pos + 1 + data[pos]].decode("utf-8", "replace"), pos + 1 + data[pos]
+
+  raise ValueError(tag)
+
+
+def format_site(shape, values):
+  if shape == "0":
+    return values[0]
+
+  return MARK + " ".join(values) + "\n"
+
+
+def decode(data, table, final):
+  # Decoded text and the number of bytes used. A frame cut at the end of data is kept for the next call
+  out, pos, raw = [], 0, 0
+
+  while pos < len(data):
+    if data[pos] != SYNC:
+      pos += 1
+      continue
+
+    if pos + HEADER_SIZE > len(data):
+      break
+
+    site = table.get(struct.unpack_from("<I", data, pos + 1)[0])
+
+    if site is None:
+      pos += 1
+      continue
+
+    shape, literals, _ = site
+    values, next_pos = [], pos + HEADER_SIZE
+
+    try:
+      for literal in literals:
+        if literal is not None:
+          values.append(literal)
+          continue
+
+        value, next_pos = read_value(data, next_pos)
+
+        if value is None:
+          break
+
+        values.append(value)
+    except ValueError:
+      pos += 1
+      continue
+
+    if len(values) < len(literals):
+      if final:
+        pos += 1
+        continue
+
+      break
+
+    out.append(data[raw:pos].decode("utf-8", "replace"))
+    out.append(format_site(shape, values))
+    pos = raw = next_pos
+
+  # Keep an unfinished frame, pass everything before it through
+  keep = pos if (not final and pos < len(data)) else len(data)
+  out.append(data[raw:keep].decode("utf-8", "replace"))
+
+  return "".join(out), keep
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Decode ESP32_ETH_MGR_BINARY_LOG output")
+  parser.add_argument("input", nargs="?", help="captured binary log file, '-' for stdin")
+  parser.add_argument("sources", nargs="*", type=Path, help="sketch folders or files, in addition to the library src/")
+  parser.add_argument("--port", help="read from a serial port instead of a file (pyserial)")
+  parser.add_argument("--baud", type=int, default=115200)
+  parser.add_argument("--table", action="store_true", help="print the string table and exit")
+  args = parser.parse_args()
+
+  sources = [ROOT / "src"] + args.sources
+
+  if args.table or args.port:
+    sources += [Path(args.input)] if args.input else []
+
+  table = scan(sources)
+
+  if args.table:
+    for id, (shape, literals, where) in sorted(table.items(), key=lambda t: t[1][2]):
+      print("0x%08X  %-40s %s" % (id, where, literals))
+
+    return
+
+  if args.port:
+    import serial
+
+    stream = serial.Serial(args.port, args.baud)
+    read = lambda: stream.read(max(1, stream.in_waiting))
+  else:
+    stream = sys.stdin.buffer if args.input in (None, "-") else open(args.input, "rb")
+    read = lambda: stream.read(4096)
+
+  pending = b""
+
+  while True:
+    chunk = read()
+    pending += chunk
+    text, used = decode(pending, table, final=not chunk)
+    pending = pending[used:]
+
+    sys.stdout.write(text)
+    sys.stdout.flush()
+
+    if not chunk:
+      break
+
+
+if __name__ == "__main__":
+  main()
@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+#
+# Generate src/utils/EM_Assets.h from the inline EM_HTTP_STYLE and EM_HTTP_SCRIPT_NTP
+# strings in src/ESP32_W5500_Manager.hpp.
+#
+# The Config Portal serves these as /em.css and /tz.js, gzip-compressed at build time
+# and cacheable by the browser. Run again from the library root whenever either string is changed:
+#
+#   python3 utils/gen_portal_assets.py
+
+import gzip
+import hashlib
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SRC = ROOT / "src" / "ESP32_W5500_Manager.hpp"
+OUT = ROOT / "src" / "utils" / "EM_Assets.h"
+
+
+def c_string(name, text):
+  m = re.search(r'const char ' + name + r'\[\] PROGMEM = "(.*?)";\n', text)
+  if not m:
+    sys.exit("Can't find " + name + " in " + str(SRC))
+  return m.group(1).encode().decode("unicode_escape")
+
+
+def inner(html, tag):
+  return ";".join(re.findall("<" + tag + r">(.*?)</" + tag + ">", html, re.S))
+
+
+def c_array(name, data):
+  lines = []
+  for i in range(0, len(data), 16):
+    lines.append("  " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+  return "const uint8_t " + name + "[] PROGMEM =\n{\n" + "\n".join(lines) + "\n};\n"
+
+
+def main():
+  text = SRC.read_text()
+
+  # The local jstz copy is the one in the #else branch of USE_CLOUDFLARE_NTP
+  ntp = text[text.index("#if USE_CLOUDFLARE_NTP"):]
+  ntp = ntp[ntp.index("#else"):]
+
+  assets = [
+    ("EM_ASSET_CSS", inner(c_string("EM_HTTP_STYLE", text), "style")),
+    ("EM_ASSET_TZ_JS", inner(c_string("EM_HTTP_SCRIPT_NTP", ntp), "script")),
+  ]
+
+  out = []
+  out.append("// autogenerated by utils/gen_portal_assets.py from src/ESP32_W5500_Manager.hpp. Do not edit.\n")
+  out.append("//\n// gzip-compressed Config Portal assets, served as /em.css and /tz.js\n\n")
+  out.append("#pragma once\n\n#ifndef EM_ASSETS_H\n#define EM_ASSETS_H\n\n")
+
+  for name, content in assets:
+    raw = content.encode()
+    gz = gzip.compress(raw, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(raw).hexdigest()[:16]
+
+    out.append("////////////////////////////////////////////////////\n\n")
+    out.append("// %d bytes, %d bytes uncompressed\n" % (len(gz), len(raw)))
+    out.append(c_array(name, gz))
+    out.append("\nconst char " + name + "_ETAG[] PROGMEM = \"\\\"" + etag + "\\\"\";\n\n")
+
+  out.append("////////////////////////////////////////////////////\n\n#endif    // EM_ASSETS_H\n")
+
+  OUT.write_text("".join(out))
+
+
+if __name__ == "__main__":
+  main()
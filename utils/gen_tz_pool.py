@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+# Generate src/utils/TZ_Pool.h, the packed timezone database used by getTZ(), from src/utils/TZ.h
+#
+# TZ_NAME[] and ESP_TZ_NAME[] in TZ.h stay the readable source. For each USING_xxx region, TZ_Pool.h holds
+#   - one pool of '\0' separated zone names, without the "Region/" prefix
+#   - one pool of '\0' separated POSIX rules, each rule stored only once
+#   - a table of (name offset, rule offset) pairs, sorted in strcmp() order for a binary search
+#
+# Run again from the library root whenever TZ.h is updated:
+#
+#   python3 utils/gen_tz_pool.py
+
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+SRC = ROOT / "src" / "utils" / "TZ.h"
+OUT = ROOT / "src" / "utils" / "TZ_Pool.h"
+
+
+def blocks(text, array):
+  start = text.index("static const char " + array + "[]")
+  body = text[start:text.index("};", start)]
+  return re.findall(r"#if (USING_\w+)\n(.*?)#endif", body, re.S)
+
+
+def c_pool(strings):
+  return "\n".join("  \"" + s + "\\0\"" for s in strings)
+
+
+def main():
+  text = SRC.read_text()
+  rules = dict(re.findall(r'#define (TZ_\w+)\s+\("([^"]*)"\)', text))
+
+  out = []
+  regions = []
+
+  out.append("// autogenerated by utils/gen_tz_pool.py from src/utils/TZ.h. Do not edit.\n")
+  out.append("//\n// Packed timezone database used by ESP32_W5500_Manager::getTZ()\n\n")
+  out.append("#pragma once\n\n#ifndef TZ_POOL_H\n#define TZ_POOL_H\n\n")
+  out.append("typedef struct\n{\n")
+  out.append("  const char*     prefix;       // \"Region/\"\n")
+  out.append("  const char*     names;        // zone names without prefix\n")
+  out.append("  const char*     rules;        // POSIX TZ rules\n")
+  out.append("  const uint16_t  (*index)[2];  // name and rule offsets, sorted by name\n")
+  out.append("  uint16_t        count;\n")
+  out.append("} EM_TZ_Region;\n\n")
+
+  for (using, names_block), (using2, rules_block) in zip(blocks(text, "TZ_NAME"), blocks(text, "ESP_TZ_NAME")):
+    if using != using2:
+      sys.exit("TZ_NAME and ESP_TZ_NAME regions differ: " + using + " / " + using2)
+
+    names = re.findall(r'^\s*"([^"]+)"', names_block, re.M)
+    zone_rules = [rules[m] for m in re.findall(r"^\s*(TZ_\w+)", rules_block, re.M)]
+
+    if len(names) != len(zone_rules):
+      sys.exit("TZ_NAME and ESP_TZ_NAME sizes differ in " + using)
+
+    base = using[len("USING_"):]
+
+    # Deduplicated rules, shared by all prefixes of the region
+    rule_pool = []
+    rule_offset = {}
+    offset = 0
+
+    for rule in zone_rules:
+      if rule not in rule_offset:
+        rule_offset[rule] = offset
+        rule_pool.append(rule)
+        offset += len(rule) + 1
+
+    out.append("////////////////////////////////////////////////////\n\n")
+    out.append("#if " + using + "\n\n")
+    out.append("static const char TZ_" + base + "_RULES[] PROGMEM =\n" + c_pool(rule_pool) + ";\n\n")
+
+    # Antarctica also holds Arctic/Longyearbyen => one table per prefix
+    zones = sorted(zip(names, zone_rules), key=lambda z: z[0].encode())
+    prefixes = sorted(set(name.split("/", 1)[0] for name in names))
+
+    for prefix in prefixes:
+      entries = [(name.split("/", 1)[1], rule) for name, rule in zones if name.split("/", 1)[0] == prefix]
+      ident = "TZ_" + prefix.upper()
+
+      name_pool = []
+      index = []
+      offset = 0
+
+      for name, rule in entries:
+        index.append((offset, rule_offset[rule]))
+        name_pool.append(name)
+        offset += len(name) + 1
+
+      out.append("static const char " + ident + "_NAMES[] PROGMEM =\n" + c_pool(name_pool) + ";\n\n")
+      out.append("static const uint16_t " + ident + "_INDEX[][2] PROGMEM =\n{\n")
+      out.append("\n".join("  { %d, %d }," % pair for pair in index) + "\n};\n\n")
+
+      regions.append((using, prefix, ident, "TZ_" + base + "_RULES", len(entries)))
+
+    out.append("#endif    // " + using + "\n\n")
+
+  out.append("////////////////////////////////////////////////////\n\n")
+  out.append("// Sorted by prefix\n")
+  out.append("static const EM_TZ_Region EM_TZ_REGIONS[] =\n{\n")
+
+  for using, prefix, ident, rules_ident, count in sorted(regions, key=lambda r: r[1].encode()):
+    out.append("#if " + using + "\n")
+    out.append("  { \"%s/\", %s_NAMES, %s, %s_INDEX, %d },\n" % (prefix, ident, rules_ident, ident, count))
+    out.append("#endif\n")
+
+  out.append("};\n\n")
+  out.append("////////////////////////////////////////////////////\n\n#endif    // TZ_POOL_H\n")
+
+  OUT.write_text("".join(out))
+
+
+if __name__ == "__main__":
+  main()